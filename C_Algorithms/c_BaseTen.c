@@ -12,6 +12,7 @@
 #define C_BASE_TEN_C
 
 #include "c_BaseTen.h"
+#include <atomic>
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,9 +37,11 @@ extern "C" {
         _baseTen.rightShift = &standardRightShift;
         _baseTen.leftShift = &standardLeftShift;
 
-        _baseTen.multiplication = &base10Multiplication;
+        _baseTen.multiplication = &base10KaratsubaMultiplication;
+        _baseTen.square = &base10Square;
         _baseTen.division = &base10Division;
 		_baseTen.modulo = &base10Modulo;
+		_baseTen.divmod = &base10DivMod;
 
 		_baseTen.exponentiation = &base10Exponentiation;
 		_baseTen.moduloExponentiation = &base10ModuloExponentiation;
@@ -46,6 +49,14 @@ extern "C" {
 		_baseTen.gcd = &base10GCD;
 		_baseTen.modInverse = &base10ModInverse;
 
+        _baseTen.sizedCompare = &standardSizedCompare;
+        _baseTen.sizedAddition = &base10SizedAddition;
+        _baseTen.sizedSubtraction = &base10SizedSubtraction;
+        _baseTen.sizedRightShift = &standardSizedRightShift;
+        _baseTen.sizedLeftShift = &standardSizedLeftShift;
+        _baseTen.sizedMultiplication = &base10SizedMultiplication;
+        _baseTen.sizedSquare = &base10SizedSquare;
+
         baseTenInit = true;
         return &_baseTen;
     }
@@ -92,234 +103,1095 @@ extern "C" {
         if(borrow>0) return 0;
         return 1;
     }
+    //Multiply-accumulate a single limb
+    uint32_t base10MultiplyAccumulate(const uint32_t* src1, uint32_t src2, uint32_t* dest, uint16_t length)
+    {
+        uint64_t carry = 0;
+        for(int cnt=0;cnt<length;cnt++)
+        {
+            uint64_t tm = (uint64_t) src1[cnt] * (uint64_t) src2 + (uint64_t) dest[cnt] + carry;
+            dest[cnt] = (uint32_t) tm;
+            carry = tm>>32;
+        }
+        return (uint32_t) carry;
+    }
+    //Significant length (limbs below the highest non-zero limb)
+    static uint16_t base10SignificantLength(const uint32_t* src, uint16_t length)
+    {
+        while(length>0 && src[length-1]==0)
+            length--;
+        return length;
+    }
+    //Number of significant bits
+    static int base10BitLength(const uint32_t* src, uint16_t length)
+    {
+        length = base10SignificantLength(src,length);
+        if(length==0) return 0;
+        int ret = 32*(length-1);
+        for(uint32_t top=src[length-1];top;top>>=1)
+            ret++;
+        return ret;
+    }
+    //Sized addition
+    int base10SizedAddition(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* dest, uint16_t destLen)
+    {
+        if(destLen<=0) return 0;
+
+        //Walk the significant limbs only, src1 is made the longer
+        len1 = base10SignificantLength(src1,len1);
+        len2 = base10SignificantLength(src2,len2);
+        if(len1<len2)
+        {
+            const uint32_t* ts = src1; src1 = src2; src2 = ts;
+            uint16_t tl = len1; len1 = len2; len2 = tl;
+        }
+        if(len1>destLen) return 0;
+
+        uint64_t carry = 0;
+        int cnt = 0;
+        for(;cnt<len2;cnt++)
+        {
+            uint64_t tm = (uint64_t) src1[cnt] + (uint64_t) src2[cnt] + carry;
+            dest[cnt] = (uint32_t) tm;
+            carry = tm>>32;
+        }
+        for(;cnt<len1;cnt++)
+        {
+            uint64_t tm = (uint64_t) src1[cnt] + carry;
+            dest[cnt] = (uint32_t) tm;
+            carry = tm>>32;
+        }
+        if(carry>0)
+        {
+            if(cnt>=destLen) return 0;
+            dest[cnt++] = (uint32_t) carry;
+        }
+        if(cnt<destLen)
+            memset(dest+cnt,0,sizeof(uint32_t)*(destLen-cnt));
+        return 1;
+    }
+    //Sized subtraction
+    int base10SizedSubtraction(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* dest, uint16_t destLen)
+    {
+        if(destLen<=0) return 0;
+
+        //A longer subtrahend always underflows
+        len1 = base10SignificantLength(src1,len1);
+        len2 = base10SignificantLength(src2,len2);
+        if(len2>len1 || len1>destLen) return 0;
+
+        uint64_t borrow = 0;
+        int cnt = 0;
+        for(;cnt<len2;cnt++)
+        {
+            uint64_t tm = (uint64_t) src1[cnt] - (uint64_t) src2[cnt] - borrow;
+            dest[cnt] = (uint32_t) tm;
+            borrow = (tm>>32)&1;
+        }
+        for(;cnt<len1;cnt++)
+        {
+            uint64_t tm = (uint64_t) src1[cnt] - borrow;
+            dest[cnt] = (uint32_t) tm;
+            borrow = (tm>>32)&1;
+        }
+        if(borrow>0) return 0;
+        if(cnt<destLen)
+            memset(dest+cnt,0,sizeof(uint32_t)*(destLen-cnt));
+        return 1;
+    }
+    //Schoolbook product, dest must hold len1+len2 and may not overlap
+    static void base10SchoolbookMultiplication(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* dest)
+    {
+        memset(dest,0,sizeof(uint32_t)*(len1+len2));
+        for(int cnt=0;cnt<len1;cnt++)
+        {
+            if(src1[cnt]==0) continue;
+            dest[cnt+len2] = base10MultiplyAccumulate(src2,src1[cnt],dest+cnt,len2);
+        }
+    }
+    //Schoolbook square, each cross product is computed once and doubled, dest must hold 2*len and may not overlap
+    static void base10SchoolbookSquare(const uint32_t* src, uint16_t len, uint32_t* dest)
+    {
+        memset(dest,0,sizeof(uint32_t)*2*len);
+        for(int cnt=0;cnt<len;cnt++)
+        {
+            if(src[cnt]==0) continue;
+            dest[cnt+len] = base10MultiplyAccumulate(src+cnt+1,src[cnt],dest+2*cnt+1,len-cnt-1);
+        }
+
+        //Double the cross products and add the diagonal
+        uint32_t top = 0;
+        uint64_t carry = 0;
+        for(int cnt=0;cnt<len;cnt++)
+        {
+            uint32_t low = dest[2*cnt];
+            uint32_t high = dest[2*cnt+1];
+            uint64_t sq = (uint64_t) src[cnt] * (uint64_t) src[cnt];
+            uint64_t tm = (uint64_t) ((low<<1)|top) + (uint32_t) sq + carry;
+            dest[2*cnt] = (uint32_t) tm;
+            tm = (uint64_t) ((high<<1)|(low>>31)) + (sq>>32) + (tm>>32);
+            dest[2*cnt+1] = (uint32_t) tm;
+            top = high>>31;
+            carry = tm>>32;
+        }
+    }
+    //Add src into dest in place, returns the carry
+    static uint32_t base10AddInPlace(uint32_t* dest, uint16_t destLen, const uint32_t* src, uint16_t srcLen)
+    {
+        uint64_t carry = 0;
+        int cnt=0;
+        for(cnt=0;cnt<srcLen;cnt++)
+        {
+            uint64_t tm = (uint64_t) dest[cnt] + (uint64_t) src[cnt] + carry;
+            dest[cnt] = (uint32_t) tm;
+            carry = tm>>32;
+        }
+        for(;cnt<destLen && carry;cnt++)
+        {
+            dest[cnt]++;
+            carry = (dest[cnt]==0);
+        }
+        return (uint32_t) carry;
+    }
+    //Subtract src from dest in place, returns the borrow
+    static uint32_t base10SubtractInPlace(uint32_t* dest, uint16_t destLen, const uint32_t* src, uint16_t srcLen)
+    {
+        uint64_t borrow = 0;
+        int cnt=0;
+        for(cnt=0;cnt<srcLen;cnt++)
+        {
+            uint64_t tm = (uint64_t) dest[cnt] - (uint64_t) src[cnt] - borrow;
+            dest[cnt] = (uint32_t) tm;
+            borrow = (tm>>32)&1;
+        }
+        for(;cnt<destLen && borrow;cnt++)
+        {
+            borrow = (dest[cnt]==0);
+            dest[cnt]--;
+        }
+        return (uint32_t) borrow;
+    }
+
+    //Read once by each product, so a concurrent change never splits one product
+    static std::atomic<uint16_t> _karatsubaThreshold(24);
+
+    //Karatsuba threshold
+    uint16_t base10KaratsubaThreshold()
+    {
+        return _karatsubaThreshold.load(std::memory_order_relaxed);
+    }
+    //Set Karatsuba threshold
+    void setBase10KaratsubaThreshold(uint16_t threshold)
+    {
+        //Below 4 limbs the split does not shrink the operands
+        if(threshold<4) threshold=4;
+        _karatsubaThreshold.store(threshold,std::memory_order_relaxed);
+    }
+    //Scratch space required for a Karatsuba product of the given length
+    static int base10KaratsubaScratch(uint16_t length, uint16_t threshold)
+    {
+        if(length<threshold) return 0;
+        uint16_t high = (length+1)/2;
+        return 4*(high+1)+base10KaratsubaScratch(high+1,threshold);
+    }
+    //Workspace required by any base-10 kernel
+    uint32_t base10WorkspaceSize(uint16_t length)
+    {
+        //Bounded by a windowed Montgomery exponentiation, its table and its products,
+        //Karatsuba scratch is sized for the lowest threshold so any setting fits
+        return 32*(uint32_t)length+2*base10KaratsubaScratch(length,4)+64;
+    }
+    //Karatsuba product, dest must hold 2*length and may not overlap
+    static void base10KaratsubaProduct(const uint32_t* src1, const uint32_t* src2, uint16_t length, uint32_t* dest, uint32_t* scratch, uint16_t threshold)
+    {
+        if(length<threshold)
+        {
+            base10SchoolbookMultiplication(src1,length,src2,length,dest);
+            return;
+        }
+
+        //src = high*B^low + low
+        uint16_t low = length/2;
+        uint16_t high = length-low;
+        uint32_t* sum1 = scratch;
+        uint32_t* sum2 = sum1+high+1;
+        uint32_t* mid = sum2+high+1;
+        uint32_t* next = mid+2*(high+1);
+
+        //Low and high products
+        base10KaratsubaProduct(src1,src2,low,dest,next,threshold);
+        base10KaratsubaProduct(src1+low,src2+low,high,dest+2*low,next,threshold);
+
+        //Middle product (low1+high1)*(low2+high2)
+        memcpy(sum1,src1+low,sizeof(uint32_t)*high);
+        sum1[high] = base10AddInPlace(sum1,high,src1,low);
+        memcpy(sum2,src2+low,sizeof(uint32_t)*high);
+        sum2[high] = base10AddInPlace(sum2,high,src2,low);
+        base10KaratsubaProduct(sum1,sum2,high+1,mid,next,threshold);
+
+        //Remove the outer products and fold in
+        base10SubtractInPlace(mid,2*(high+1),dest,2*low);
+        base10SubtractInPlace(mid,2*(high+1),dest+2*low,2*high);
+        base10AddInPlace(dest+low,2*length-low,mid,base10SignificantLength(mid,2*(high+1)));
+    }
+    //Karatsuba square, dest must hold 2*length and may not overlap
+    static void base10KaratsubaSquare(const uint32_t* src, uint16_t length, uint32_t* dest, uint32_t* scratch, uint16_t threshold)
+    {
+        //Schoolbook squares are half the work of a product, so they split later
+        if(length<2*threshold)
+        {
+            base10SchoolbookSquare(src,length,dest);
+            return;
+        }
+
+        //Same split as the product, with one sum instead of two
+        uint16_t low = length/2;
+        uint16_t high = length-low;
+        uint32_t* sum = scratch;
+        uint32_t* mid = sum+high+1;
+        uint32_t* next = mid+2*(high+1);
+
+        base10KaratsubaSquare(src,low,dest,next,threshold);
+        base10KaratsubaSquare(src+low,high,dest+2*low,next,threshold);
+
+        memcpy(sum,src+low,sizeof(uint32_t)*high);
+        sum[high] = base10AddInPlace(sum,high,src,low);
+        base10KaratsubaSquare(sum,high+1,mid,next,threshold);
+
+        base10SubtractInPlace(mid,2*(high+1),dest,2*low);
+        base10SubtractInPlace(mid,2*(high+1),dest+2*low,2*high);
+        base10AddInPlace(dest+low,2*length-low,mid,base10SignificantLength(mid,2*(high+1)));
+    }
+    //Square of a significant length, dest must hold 2*len and may not overlap
+    static void base10SquareProduct(const uint32_t* src, uint16_t len, uint32_t* dest)
+    {
+        uint16_t threshold = base10KaratsubaThreshold();
+        if(len<2*threshold)
+        {
+            base10SchoolbookSquare(src,len,dest);
+            return;
+        }
+
+        //Product scratch covers the smaller squaring layout, without scratch the square is schoolbook
+        uint32_t* scratch = numberWorkspacePush(base10KaratsubaScratch(len,threshold));
+        if(scratch) base10KaratsubaSquare(src,len,dest,scratch,threshold);
+        else base10SchoolbookSquare(src,len,dest);
+        numberWorkspacePop(scratch);
+    }
+    //Product of significant lengths at one threshold, dest must hold len1+len2 and may not overlap
+    static void base10ThresholdProduct(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* dest, uint16_t threshold)
+    {
+        //src1 is the longer argument
+        if(len1<len2)
+        {
+            base10ThresholdProduct(src2,len2,src1,len1,dest,threshold);
+            return;
+        }
+        if(len2<threshold)
+        {
+            base10SchoolbookMultiplication(src1,len1,src2,len2,dest);
+            return;
+        }
+        if(len1==len2)
+        {
+            //Without scratch the product is schoolbook
+            uint32_t* scratch = numberWorkspacePush(base10KaratsubaScratch(len2,threshold));
+            if(scratch) base10KaratsubaProduct(src1,src2,len2,dest,scratch,threshold);
+            else base10SchoolbookMultiplication(src1,len1,src2,len2,dest);
+            numberWorkspacePop(scratch);
+            return;
+        }
+
+        //Balanced products of len2 uint32_t chunks of src1, rather than padding src2 to len1
+        uint32_t* part = numberWorkspacePush(2*len2+base10KaratsubaScratch(len2,threshold));
+        if(!part)
+        {
+            base10SchoolbookMultiplication(src1,len1,src2,len2,dest);
+            return;
+        }
+        memset(dest,0,sizeof(uint32_t)*(len1+len2));
+        uint16_t pos = 0;
+        for(;len1-pos>=len2;pos+=len2)
+        {
+            base10KaratsubaProduct(src1+pos,src2,len2,part,part+2*len2,threshold);
+            base10AddInPlace(dest+pos,len1+len2-pos,part,2*len2);
+        }
+        if(pos<len1)
+        {
+            base10ThresholdProduct(src1+pos,len1-pos,src2,len2,part,threshold);
+            base10AddInPlace(dest+pos,len1+len2-pos,part,len1-pos+len2);
+        }
+        numberWorkspacePop(part);
+    }
+    //Product of significant lengths, dest must hold len1+len2 and may not overlap
+    static void base10Product(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* dest)
+    {
+        base10ThresholdProduct(src1,len1,src2,len2,dest,base10KaratsubaThreshold());
+    }
+    //Truncate a product into dest
+    static int base10TruncateProduct(const uint32_t* targ, int prodLen, uint32_t* dest, uint16_t length)
+    {
+        int ret = 1;
+        for(int cnt=length;cnt<prodLen;cnt++)
+        {
+            if(targ[cnt]!=0)
+                ret = 0;
+        }
+
+        if(prodLen>=length)
+            memcpy(dest,targ,sizeof(uint32_t)*length);
+        else
+        {
+            memcpy(dest,targ,sizeof(uint32_t)*prodLen);
+            memset(dest+prodLen,0,sizeof(uint32_t)*(length-prodLen));
+        }
+        return ret;
+    }
     //Multiplication
     int base10Multiplication(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
     {
         if(length<=0) return 0;
 
-		int ret = 1;
-		uint32_t* temp = (uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* targ = (uint32_t*) malloc(length*sizeof(uint32_t));
+        uint16_t len1 = base10SignificantLength(src1,length);
+        uint16_t len2 = base10SignificantLength(src2,length);
+        if(len1==0 || len2==0)
+        {
+            memset(dest,0,sizeof(uint32_t)*length);
+            return 1;
+        }
+
+        //Build the full product, then truncate
+        int prodLen = len1+len2;
+        uint32_t* targ = numberWorkspacePush(prodLen);
+        if(!targ) return 0;
+        base10SchoolbookMultiplication(src1,len1,src2,len2,targ);
+        int ret = base10TruncateProduct(targ,prodLen,dest,length);
+        numberWorkspacePop(targ);
+        return ret;
+    }
+    //Karatsuba multiplication
+    int base10KaratsubaMultiplication(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+    {
+        return base10SizedMultiplication(src1,length,src2,length,dest,length);
+    }
+    //Sized multiplication
+    int base10SizedMultiplication(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* dest, uint16_t destLen)
+    {
+        if(destLen<=0) return 0;
 
-		//Zero the target
-		memset(targ,0,sizeof(uint32_t)*length);
+        len1 = base10SignificantLength(src1,len1);
+        len2 = base10SignificantLength(src2,len2);
+        if(len1==0 || len2==0)
+        {
+            memset(dest,0,sizeof(uint32_t)*destLen);
+            return 1;
+        }
 
-		//Preform multiplication
-		for(int cnt=0;cnt<length*32;cnt++)
-		{
-			int bigPos=cnt/32;
-			int smallPos=cnt%32;
-			if(src1[bigPos]&(1<<smallPos))
-			{
-				if(!standardLeftShift(src2,cnt,temp,length))
-					ret = 0;
-				if(!base10Addition(targ,temp,targ,length))
-					ret = 0;
-			}
-		}
+        //Build the full product, then truncate
+        int prodLen = len1+len2;
+        uint32_t* targ = numberWorkspacePush(prodLen);
+        if(!targ) return 0;
+        base10Product(src1,len1,src2,len2,targ);
+        int ret = base10TruncateProduct(targ,prodLen,dest,destLen);
+        numberWorkspacePop(targ);
+        return ret;
+    }
+    //Square
+    int base10Square(const uint32_t* src1, uint32_t* dest, uint16_t length)
+    {
+        return base10SizedSquare(src1,length,dest,length);
+    }
+    //Sized square
+    int base10SizedSquare(const uint32_t* src1, uint16_t len1, uint32_t* dest, uint16_t destLen)
+    {
+        if(destLen<=0) return 0;
+
+        uint16_t len = base10SignificantLength(src1,len1);
+        if(len==0)
+        {
+            memset(dest,0,sizeof(uint32_t)*destLen);
+            return 1;
+        }
 
-		memcpy(dest,targ,sizeof(uint32_t)*length);
-		free(targ);
-		free(temp);
+        //Build the full square, then truncate
+        uint32_t* targ = numberWorkspacePush(2*len);
+        if(!targ) return 0;
+        base10SquareProduct(src1,len,targ);
+        int ret = base10TruncateProduct(targ,2*len,dest,destLen);
+        numberWorkspacePop(targ);
         return ret;
     }
+    //Double-width multiplication
+    int base10FullMultiplication(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+    {
+        if(length<=0) return 0;
+
+        base10Product(src1,length,src2,length,dest);
+        return 1;
+    }
+    //Multiply-subtract a single limb, returns the borrow
+    static uint32_t base10MultiplySubtract(const uint32_t* src1, uint32_t src2, uint32_t* dest, uint16_t length)
+    {
+        uint64_t borrow = 0;
+        for(int cnt=0;cnt<length;cnt++)
+        {
+            uint64_t tm = (uint64_t) src1[cnt] * (uint64_t) src2 + borrow;
+            uint32_t low = (uint32_t) tm;
+            borrow = tm>>32;
+            if(dest[cnt]<low) borrow++;
+            dest[cnt] -= low;
+        }
+        return (uint32_t) borrow;
+    }
+    //Division and modulo (Knuth, algorithm D)
+    int base10DivMod(const uint32_t* src1, const uint32_t* src2, uint32_t* quot, uint32_t* rem, uint16_t length)
+    {
+        if(length<=0) return 0;
+
+        //Exit if divide by zero
+        uint16_t divLen = base10SignificantLength(src2,length);
+        if(divLen==0)
+        {
+            if(quot) memset((void*) quot,0,sizeof(uint32_t)*length);
+            if(rem) memset((void*) rem,0,sizeof(uint32_t)*length);
+            return 0;
+        }
+        uint16_t numLen = base10SignificantLength(src1,length);
+        if(numLen<divLen) numLen=divLen;
+
+        //Normalized numerator (one extra uint32_t), divisor and quotient
+        uint32_t* num = numberWorkspacePush(2*numLen+2);
+        if(!num) return 0;
+        uint32_t* div = num+numLen+1;
+        uint32_t* q = div+divLen;
+        memset(q,0,sizeof(uint32_t)*(numLen-divLen+1));
+
+        //Shift so the top bit of the divisor is set
+        int shift = 0;
+        for(uint32_t top=src2[divLen-1];!(top&0x80000000);top<<=1)
+            shift++;
+        if(shift)
+        {
+            for(int cnt=divLen-1;cnt>0;cnt--)
+                div[cnt] = (src2[cnt]<<shift)|(src2[cnt-1]>>(32-shift));
+            div[0] = src2[0]<<shift;
+            num[numLen] = src1[numLen-1]>>(32-shift);
+            for(int cnt=numLen-1;cnt>0;cnt--)
+                num[cnt] = (src1[cnt]<<shift)|(src1[cnt-1]>>(32-shift));
+            num[0] = src1[0]<<shift;
+        }
+        else
+        {
+            memcpy(div,src2,sizeof(uint32_t)*divLen);
+            memcpy(num,src1,sizeof(uint32_t)*numLen);
+            num[numLen] = 0;
+        }
+
+        for(int cnt=numLen-divLen;cnt>=0;cnt--)
+        {
+            //Estimate the quotient digit from the top two uint32_t
+            uint64_t top = ((uint64_t) num[cnt+divLen]<<32)|num[cnt+divLen-1];
+            uint64_t qhat = top/div[divLen-1];
+            uint64_t rhat = top%div[divLen-1];
+            while(qhat>0xFFFFFFFF || (divLen>1 && qhat*div[divLen-2]>((rhat<<32)|num[cnt+divLen-2])))
+            {
+                qhat--;
+                rhat += div[divLen-1];
+                if(rhat>0xFFFFFFFF) break;
+            }
+
+            //Subtract qhat*div, the estimate is at most one too large
+            uint32_t borrow = base10MultiplySubtract(div,(uint32_t) qhat,num+cnt,divLen);
+            if(num[cnt+divLen]<borrow)
+            {
+                qhat--;
+                num[cnt+divLen] += base10AddInPlace(num+cnt,divLen,div,divLen)-borrow;
+            }
+            else
+                num[cnt+divLen] -= borrow;
+            q[cnt] = (uint32_t) qhat;
+        }
+
+        //Bind outputs, un-normalizing the remainder
+        if(quot)
+        {
+            memset((void*) quot,0,sizeof(uint32_t)*length);
+            memcpy(quot,q,sizeof(uint32_t)*(numLen-divLen+1));
+        }
+        if(rem)
+        {
+            memset((void*) rem,0,sizeof(uint32_t)*length);
+            for(int cnt=0;cnt<divLen;cnt++)
+            {
+                rem[cnt] = num[cnt]>>shift;
+                if(shift) rem[cnt] |= num[cnt+1]<<(32-shift);
+            }
+        }
+        numberWorkspacePop(num);
+        return 1;
+    }
     //Division
     int base10Division(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
     {
+        return base10DivMod(src1,src2,dest,NULL,length);
+    }
+	//Modulo
+	int base10Modulo(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		return base10DivMod(src1,src2,NULL,dest,length);
+	}
+	//Exponentiation
+	int base10Exponentiation(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		//Zero return is error
         if(length<=0) return 0;
 
-		//Exit if divide by zero
-		int found = 0;
-		for(int cnt=0;cnt<length && !found;cnt++)
+		//Check if src1 is zero
+		int cnt=0;
+		for(cnt=0;cnt<length && src1[cnt]==0;cnt++)
+		{}
+		if(cnt==length && src1[cnt-1]==0)
 		{
-			if(src2[cnt]!=0)
-				found = 1;
+			memset((void*) dest,0,sizeof(uint32_t)*length);
+			return 1;
 		}
 
-		//Zero the target
-		uint32_t* targ = (uint32_t*) malloc(length*sizeof(uint32_t));
-		memset(targ,0,sizeof(uint32_t)*length);
+		uint32_t* temp1 = numberWorkspacePush(2*length);
+		if(!temp1) return 0;
+		uint32_t* temp2 = temp1+length;
 
-		if(!found)
+		//Zero
+		memset((void*) temp1,0,sizeof(uint32_t)*length);
+		memcpy((void*) temp2,src1,sizeof(uint32_t)*length);
+		temp1[0]=1;
+
+		//Squares past the highest set bit of the exponent are never used
+		int expBits=base10BitLength(src2,length);
+		int cur_state=1;
+		int ret_state=1;
+		for(cnt=0;cnt<expBits && ret_state;cnt++)
+		{
+			int bigPos=cnt/32;
+			int smallPos=cnt%32;
+			if(src2[bigPos]&(1<<smallPos))
+			{
+				if(!cur_state || !base10Multiplication(temp1,temp2,temp1,length))
+					ret_state=0;
+			}
+			if(cnt+1<expBits)
+				cur_state=base10Square(temp2,temp2,length);
+		}
+
+		memcpy((void*) dest,temp1,sizeof(uint32_t)*length);
+		numberWorkspacePop(temp1);
+
+		return ret_state;
+	}
+	//Fill a Montgomery context for an odd modulus of sigLen uint32_t, storage holds 2*sigLen
+	static int base10MontgomeryBuild(struct montgomeryContext* ctx, const uint32_t* src, uint16_t sigLen, uint32_t* storage)
+	{
+		//n^-1 mod 2^32 by Newton iteration, each step doubles the correct bits
+		uint32_t inv = src[0];
+		for(int cnt=0;cnt<4;cnt++)
+			inv *= 2-src[0]*inv;
+
+		//R^2 mod n where R=2^(32*sigLen)
+		uint16_t wideLen = 2*sigLen+1;
+		uint32_t* wide = numberWorkspacePush(2*wideLen);
+		if(!wide) return 0;
+		uint32_t* wideMod = wide+wideLen;
+		memset(wide,0,sizeof(uint32_t)*2*wideLen);
+		wide[2*sigLen] = 1;
+		memcpy(wideMod,src,sizeof(uint32_t)*sigLen);
+		if(!base10Modulo(wide,wideMod,wide,wideLen))
 		{
-			for(int cnt=0;cnt<length;cnt++)
-				dest[cnt]=targ[cnt];
-			free(targ);
+			numberWorkspacePop(wide);
 			return 0;
 		}
 
-		uint32_t* temp1 = (uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* temp2 = (uint32_t*) malloc(length*sizeof(uint32_t));
+		ctx->length = sigLen;
+		ctx->nPrime = (uint32_t) 0-inv;
+		ctx->modulus = storage;
+		ctx->rSquared = storage+sigLen;
+		memcpy(ctx->modulus,src,sizeof(uint32_t)*sigLen);
+		memcpy(ctx->rSquared,wide,sizeof(uint32_t)*sigLen);
+		numberWorkspacePop(wide);
+		return 1;
+	}
+	//Montgomery context
+	int base10MontgomeryInit(struct montgomeryContext* ctx, const uint32_t* src, uint16_t length)
+	{
+		ctx->length = 0;
+		ctx->nPrime = 0;
+		ctx->modulus = NULL;
+		ctx->rSquared = NULL;
+
+		//Only defined for odd moduli
+		uint16_t sigLen = base10SignificantLength(src,length);
+		if(sigLen==0 || !(src[0]&1)) return 0;
+
+		uint32_t* storage = (uint32_t*) malloc(2*sigLen*sizeof(uint32_t));
+		if(!storage) return 0;
+		if(!base10MontgomeryBuild(ctx,src,sigLen,storage))
+		{
+			free(storage);
+			return 0;
+		}
+		return 1;
+	}
+	//Free Montgomery context
+	void base10MontgomeryFree(struct montgomeryContext* ctx)
+	{
+		if(ctx->modulus) free(ctx->modulus);
+		ctx->length = 0;
+		ctx->nPrime = 0;
+		ctx->modulus = NULL;
+		ctx->rSquared = NULL;
+	}
+	//Montgomery reduction of a 2*length+1 product, scratch is overwritten
+	static void base10MontgomeryReduce(const struct montgomeryContext* ctx, uint32_t* scratch, uint32_t* dest)
+	{
+		uint16_t length = ctx->length;
+		for(int cnt=0;cnt<length;cnt++)
+		{
+			uint32_t m = scratch[cnt]*ctx->nPrime;
+			uint32_t carry = base10MultiplyAccumulate(ctx->modulus,m,scratch+cnt,length);
+			base10AddInPlace(scratch+cnt+length,2*length+1-cnt-length,&carry,1);
+		}
 
-		//Set temp1 to current src1
-		for(int cnt =0;cnt<length;cnt++)
-			temp1[cnt]=src1[cnt];
+		//Result is below 2n, one subtraction at most
+		uint32_t* result = scratch+length;
+		if(result[length] || standardCompare(result,ctx->modulus,length)>=0)
+			base10SubtractInPlace(result,length+1,ctx->modulus,length);
+		memcpy(dest,result,sizeof(uint32_t)*length);
+	}
+	//Montgomery product, a*b*R^-1 mod n
+	static void base10MontgomeryProduct(const struct montgomeryContext* ctx, const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint32_t* scratch)
+	{
+		base10Product(src1,ctx->length,src2,ctx->length,scratch);
+		scratch[2*ctx->length] = 0;
+		base10MontgomeryReduce(ctx,scratch,dest);
+	}
+	//Montgomery square, a*a*R^-1 mod n
+	static void base10MontgomerySquare(const struct montgomeryContext* ctx, const uint32_t* src, uint32_t* dest, uint32_t* scratch)
+	{
+		base10SquareProduct(src,ctx->length,scratch);
+		scratch[2*ctx->length] = 0;
+		base10MontgomeryReduce(ctx,scratch,dest);
+	}
+	//Montgomery multiplication
+	int base10MontgomeryMultiplication(const struct montgomeryContext* ctx, const uint32_t* src1, const uint32_t* src2, uint32_t* dest)
+	{
+		if(ctx->length==0) return 0;
+		uint32_t* scratch = numberWorkspacePush(2*ctx->length+1);
+		if(!scratch) return 0;
+		base10MontgomeryProduct(ctx,src1,src2,dest,scratch);
+		numberWorkspacePop(scratch);
+		return 1;
+	}
+	//Sliding window size for an exponent of the given bit length
+	static int base10WindowBits(int expBits)
+	{
+		if(expBits>671) return 6;
+		if(expBits>239) return 5;
+		if(expBits>79) return 4;
+		if(expBits>23) return 3;
+		return 1;
+	}
+	//Montgomery modulo exponentiation
+	int base10MontgomeryExponentiation(const struct montgomeryContext* ctx, const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		uint16_t modLen = ctx->length;
+		if(modLen==0 || length<modLen) return 0;
 
-		//Find starting position of src1
-		int src1_pos=length*32-1;
-		found = 0;
-		while(src1_pos>=0 && !found)
+		//Check if src1 is zero
+		if(base10SignificantLength(src1,length)==0)
 		{
-			if(src1[src1_pos/32] & (1<<(src1_pos%32)))
-				found = 1;
-			src1_pos--;
+			memset((void*) dest,0,sizeof(uint32_t)*length);
+			return 1;
 		}
 
-		//Find starting position of src2
-		int src2_pos=length*32-1;
-		found = 0;
-		while(src2_pos>=0 && !found)
+		//Exponent of zero
+		uint16_t expLen = base10SignificantLength(src2,length);
+		if(expLen==0)
 		{
-			if(src2[src2_pos/32] & (1<<(src2_pos%32)))
-				found = 1;
-			src2_pos--;
+			memset((void*) dest,0,sizeof(uint32_t)*length);
+			dest[0] = 1;
+			return 1;
 		}
 
-		//Found the two starting positions, calculate division
-		for(int cnt=src1_pos-src2_pos;cnt>=0;cnt--)
+		uint32_t* base = numberWorkspacePush(4*length+2*modLen+1);
+		if(!base) return 0;
+		uint32_t* acc = base+length;
+		uint32_t* wideMod = acc+length;
+		uint32_t* reduced = wideMod+length;
+		uint32_t* scratch = reduced+length;
+
+		//Reduce the base, then move it into Montgomery form
+		memset(wideMod,0,sizeof(uint32_t)*length);
+		memcpy(wideMod,ctx->modulus,sizeof(uint32_t)*modLen);
+		if(!base10Modulo(src1,wideMod,reduced,length))
 		{
-			//Preform shift
-			if(!standardLeftShift(src2,cnt,temp2,length))
+			numberWorkspacePop(base);
+			return 0;
+		}
+		base10MontgomeryProduct(ctx,reduced,ctx->rSquared,base,scratch);
+
+		int expBits = base10BitLength(src2,expLen);
+		if(expLen==1)
+		{
+			//Single uint32_t exponents (such as 65537) run left-to-right from the base
+			memcpy(acc,base,sizeof(uint32_t)*modLen);
+			for(int cnt=expBits-2;cnt>=0;cnt--)
 			{
-				//Shouldn't ever get here
-				free(temp1);
-				free(temp2);
-				for(int cnt=0;cnt<length;cnt++)
-					dest[cnt]=targ[cnt];
-				free(targ);
+				base10MontgomerySquare(ctx,acc,acc,scratch);
+				if(src2[0]&(1u<<cnt))
+					base10MontgomeryProduct(ctx,acc,base,acc,scratch);
+			}
+		}
+		else
+		{
+			//Odd powers base^1, base^3, ... base^(2^window-1)
+			int window = base10WindowBits(expBits);
+			int tableSize = 1<<(window-1);
+			uint32_t* table = numberWorkspacePush((tableSize+1)*modLen);
+			if(!table)
+			{
+				numberWorkspacePop(base);
 				return 0;
 			}
-
-			//If temp1>=temp2, subtract and bind to output
-			if(standardCompare(temp1,temp2,length)>=0)
+			uint32_t* baseSquared = table+tableSize*modLen;
+			memcpy(table,base,sizeof(uint32_t)*modLen);
+			base10MontgomerySquare(ctx,base,baseSquared,scratch);
+			for(int cnt=1;cnt<tableSize;cnt++)
+				base10MontgomeryProduct(ctx,table+(cnt-1)*modLen,baseSquared,table+cnt*modLen,scratch);
+
+			//Left-to-right sliding window, the top bit is always set
+			int first = 1;
+			int pos = expBits-1;
+			while(pos>=0)
 			{
-				targ[cnt/32]=targ[cnt/32] | (1<<(cnt%32));
-				base10Subtraction(temp1,temp2,temp1,length);
+				if(!(src2[pos/32]&(1u<<(pos%32))))
+				{
+					base10MontgomerySquare(ctx,acc,acc,scratch);
+					pos--;
+					continue;
+				}
 
+				//Longest window ending in a set bit
+				int low = pos-window+1;
+				if(low<0) low=0;
+				while(!(src2[low/32]&(1u<<(low%32))))
+					low++;
+				int value = 0;
+				for(int cnt=pos;cnt>=low;cnt--)
+					value = (value<<1)|((src2[cnt/32]>>(cnt%32))&1);
+
+				if(first)
+					memcpy(acc,table+(value/2)*modLen,sizeof(uint32_t)*modLen);
+				else
+				{
+					for(int cnt=pos;cnt>=low;cnt--)
+						base10MontgomerySquare(ctx,acc,acc,scratch);
+					base10MontgomeryProduct(ctx,acc,table+(value/2)*modLen,acc,scratch);
+				}
+				first = 0;
+				pos = low-1;
 			}
+			numberWorkspacePop(table);
 		}
 
-		free(temp1);
-		free(temp2);
+		//Leave Montgomery form
+		memcpy(scratch,acc,sizeof(uint32_t)*modLen);
+		memset(scratch+modLen,0,sizeof(uint32_t)*(modLen+1));
+		base10MontgomeryReduce(ctx,scratch,acc);
 
-		memcpy(dest,targ,sizeof(uint32_t)*length);
-		free(targ);
-        return 1;
-    }
-	//Modulo
-	int base10Modulo(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+		memset((void*) dest,0,sizeof(uint32_t)*length);
+		memcpy(dest,acc,sizeof(uint32_t)*modLen);
+		numberWorkspacePop(base);
+		return 1;
+	}
+	//Fill a Barrett context for a modulus of sigLen uint32_t, storage holds 2*sigLen+2
+	static int base10BarrettBuild(struct barrettContext* ctx, const uint32_t* src, uint16_t sigLen, uint32_t* storage)
 	{
-		if(length<=0) return 0;
-
-		//Exit if divide by zero
-		int found = 0;
-		for(int cnt=0;cnt<length && !found;cnt++)
-		{
-			if(src2[cnt]!=0)
-				found = 1;
-		}
-
-		if(!found)
+		//mu=b^(2*sigLen)/n, one more uint32_t than the modulus, two if n is a power of b
+		uint16_t wideLen = 2*sigLen+1;
+		uint32_t* wide = numberWorkspacePush(3*wideLen);
+		if(!wide) return 0;
+		uint32_t* wideMod = wide+wideLen;
+		uint32_t* quot = wideMod+wideLen;
+		memset(wide,0,sizeof(uint32_t)*2*wideLen);
+		wide[2*sigLen] = 1;
+		memcpy(wideMod,src,sizeof(uint32_t)*sigLen);
+		if(!base10DivMod(wide,wideMod,quot,NULL,wideLen))
 		{
-			//Zero the target
-			memset((void*) dest,0,sizeof(uint32_t)*length);
+			numberWorkspacePop(wide);
 			return 0;
 		}
 
-		uint32_t* temp1 = (uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* temp2 = (uint32_t*) malloc(length*sizeof(uint32_t));
+		ctx->length = sigLen;
+		ctx->modulus = storage;
+		ctx->mu = storage+sigLen;
+		memcpy(ctx->modulus,src,sizeof(uint32_t)*sigLen);
+		memcpy(ctx->mu,quot,sizeof(uint32_t)*(sigLen+2));
+		numberWorkspacePop(wide);
+		return 1;
+	}
+	//Barrett context
+	int base10BarrettInit(struct barrettContext* ctx, const uint32_t* src, uint16_t length)
+	{
+		ctx->length = 0;
+		ctx->modulus = NULL;
+		ctx->mu = NULL;
 
-		//Set temp1 to current src1
-		memcpy(temp1,src1,sizeof(uint32_t)*length);
+		uint16_t sigLen = base10SignificantLength(src,length);
+		if(sigLen==0) return 0;
 
-		//Find starting position of src1
-		int src1_pos=length*32-1;
-		found = 0;
-		while(src1_pos>=0 && !found)
+		uint32_t* storage = (uint32_t*) malloc((2*sigLen+2)*sizeof(uint32_t));
+		if(!storage) return 0;
+		if(!base10BarrettBuild(ctx,src,sigLen,storage))
 		{
-			if(src1[src1_pos/32] & (1<<(src1_pos%32)))
-				found = 1;
-			src1_pos--;
+			free(storage);
+			return 0;
+		}
+		return 1;
+	}
+	//Free Barrett context
+	void base10BarrettFree(struct barrettContext* ctx)
+	{
+		if(ctx->modulus) free(ctx->modulus);
+		ctx->length = 0;
+		ctx->modulus = NULL;
+		ctx->mu = NULL;
+	}
+	//Reduce src1 of srcLen<=2*ctx->length uint32_t into ctx->length uint32_t
+	static int base10BarrettReduceWide(const struct barrettContext* ctx, const uint32_t* src1, uint16_t srcLen, uint32_t* dest)
+	{
+		uint16_t k = ctx->length;
+		srcLen = base10SignificantLength(src1,srcLen);
+		memset(dest,0,sizeof(uint32_t)*k);
+		if(srcLen<k)
+		{
+			//Already below b^(k-1), and so below the modulus
+			memcpy(dest,src1,sizeof(uint32_t)*srcLen);
+			return 1;
 		}
 
-		//Find starting position of src2
-		int src2_pos=length*32-1;
-		found = 0;
-		while(src2_pos>=0 && !found)
+		uint16_t q1Len = srcLen-k+1;
+		uint16_t q2Len = q1Len+k+2;
+		uint32_t* q2 = numberWorkspacePush(q2Len+2*(k+1));
+		if(!q2) return 0;
+		uint32_t* r = q2+q2Len;
+		uint32_t* r2 = r+k+1;
+
+		//Upper part of (src1/b^(k-1))*mu, the columns skipped leave q3 at most 2 short
+		const uint32_t* q1 = src1+k-1;
+		memset(q2,0,sizeof(uint32_t)*q2Len);
+		for(int cnt=0;cnt<q1Len;cnt++)
 		{
-			if(src2[src2_pos/32] & (1<<(src2_pos%32)))
-				found = 1;
-			src2_pos--;
+			int start = k-1-cnt;
+			if(start<0) start = 0;
+			if(q1[cnt]==0) continue;
+			q2[cnt+k+2] = base10MultiplyAccumulate(ctx->mu+start,q1[cnt],q2+cnt+start,k+2-start);
 		}
+		const uint32_t* q3 = q2+k+1;
+		uint16_t q3Len = q2Len-k-1;
 
-		//Found the two starting positions, calculate division
-		for(int cnt=src1_pos-src2_pos;cnt>=0;cnt--)
+		//r=(src1-q3*n) mod b^(k+1), only the low k+1 columns of the product are needed
+		memset(r2,0,sizeof(uint32_t)*(k+1));
+		for(int cnt=0;cnt<q3Len && cnt<k+1;cnt++)
 		{
-			//Preform shift
-			if(!standardLeftShift(src2,cnt,temp2,length))
-			{
-				//Shouldn't ever get here
-                memset(dest,0,sizeof(uint32_t)*length);
-				free(temp1);
-				free(temp2);
-				return 0;
-			}
+			uint16_t len = k+1-cnt<k ? k+1-cnt : k;
+			uint32_t carry = base10MultiplyAccumulate(ctx->modulus,q3[cnt],r2+cnt,len);
+			if(cnt+len<k+1) r2[cnt+len] = carry;
+		}
+		memset(r,0,sizeof(uint32_t)*(k+1));
+		memcpy(r,src1,sizeof(uint32_t)*(srcLen<k+1 ? srcLen : k+1));
+		base10SubtractInPlace(r,k+1,r2,k+1);
+
+		//At most a few subtractions remain
+		while(r[k] || standardCompare(r,ctx->modulus,k)>=0)
+			base10SubtractInPlace(r,k+1,ctx->modulus,k);
+		memcpy(dest,r,sizeof(uint32_t)*k);
+		numberWorkspacePop(q2);
+		return 1;
+	}
+	//Barrett reduction
+	int base10BarrettReduce(const struct barrettContext* ctx, const uint32_t* src1, uint32_t* dest, uint16_t length)
+	{
+		uint16_t k = ctx->length;
+		if(k==0 || length<k) return 0;
 
-			//If temp1>=temp2, subtract and bind to output
-			if(standardCompare(temp1,temp2,length)>=0)
-				base10Subtraction(temp1,temp2,temp1,length);
+		//Wider arguments need long division
+		uint16_t srcLen = base10SignificantLength(src1,length);
+		if(srcLen>2*k)
+		{
+			uint32_t* wideMod = numberWorkspacePush(length);
+			if(!wideMod) return 0;
+			memset(wideMod,0,sizeof(uint32_t)*length);
+			memcpy(wideMod,ctx->modulus,sizeof(uint32_t)*k);
+			int ret = base10Modulo(src1,wideMod,dest,length);
+			numberWorkspacePop(wideMod);
+			return ret;
 		}
 
-		//Copy from temp into destination
-		memcpy(dest,temp1,sizeof(uint32_t)*length);
+		uint32_t* reduced = numberWorkspacePush(k);
+		if(!reduced) return 0;
+		int ret = base10BarrettReduceWide(ctx,src1,srcLen,reduced);
+		memset((void*) dest,0,sizeof(uint32_t)*length);
+		memcpy(dest,reduced,sizeof(uint32_t)*k);
+		numberWorkspacePop(reduced);
+		return ret;
+	}
+	//Product of two residues of ctx->length uint32_t, wide holds 2*ctx->length
+	static int base10BarrettProduct(const struct barrettContext* ctx, const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint32_t* wide)
+	{
+		uint16_t k = ctx->length;
+		if(src1==src2)
+			base10SquareProduct(src1,k,wide);
+		else
+			base10Product(src1,k,src2,k,wide);
+		return base10BarrettReduceWide(ctx,wide,2*k,dest);
+	}
+	//(src1*src2+src3)%src4 through one product, src3 may be NULL
+	static int base10ModProduct(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, const uint32_t* src4, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		uint16_t modLen = base10SignificantLength(src4,length);
+		if(modLen==0)
+		{
+			memset((void*) dest,0,sizeof(uint32_t)*length);
+			return 0;
+		}
 
-		free(temp1);
-		free(temp2);
-        return 1;
+		//The product is never truncated, so size the block past the arrays
+		uint16_t len1 = base10SignificantLength(src1,length);
+		uint16_t len2 = src1==src2 ? len1 : base10SignificantLength(src2,length);
+		uint16_t len3 = src3 ? base10SignificantLength(src3,length) : 0;
+		uint32_t wideLen = (uint32_t) len1+len2+1;
+		if(wideLen<(uint32_t) len3+1) wideLen = len3+1;
+		if(wideLen<modLen) wideLen = modLen;
+		if(wideLen>0xFFFF) return 0;
+
+		uint32_t* wide = numberWorkspacePush(3*wideLen);
+		if(!wide) return 0;
+		uint32_t* mod = wide+wideLen;
+		uint32_t* rem = mod+wideLen;
+		memset(wide,0,sizeof(uint32_t)*2*wideLen);
+		if(len1 && len2)
+		{
+			if(src1==src2)
+				base10SquareProduct(src1,len1,wide);
+			else
+				base10Product(src1,len1,src2,len2,wide);
+		}
+		if(len3) base10AddInPlace(wide,(uint16_t) wideLen,src3,len3);
+		memcpy(mod,src4,sizeof(uint32_t)*modLen);
+
+		int ret = base10DivMod(wide,mod,NULL,rem,(uint16_t) wideLen);
+		memset((void*) dest,0,sizeof(uint32_t)*length);
+		memcpy(dest,rem,sizeof(uint32_t)*modLen);
+		numberWorkspacePop(wide);
+		return ret;
+	}
+	//Modular multiplication
+	int base10ModMultiply(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length)
+	{
+		return base10ModProduct(src1,src2,NULL,src3,dest,length);
+	}
+	//Modular multiply and add
+	int base10ModMultiplyAdd(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, const uint32_t* src4, uint32_t* dest, uint16_t length)
+	{
+		return base10ModProduct(src1,src2,src3,src4,dest,length);
+	}
+	//Residue difference of k uint32_t, r1 and r2 below modulus, result in r1
+	static void base10ResidueDifference(uint32_t* r1, uint32_t* r2, const uint32_t* modulus, uint16_t k)
+	{
+		//r1+n-r2 is below n when r1<r2, so the carry out of r1+n cancels the borrow
+		if(standardCompare(r1,r2,k)<0)
+			base10AddInPlace(r1,k,modulus,k);
+		base10SubtractInPlace(r1,k,r2,k);
+	}
+	//Modular subtraction
+	int base10ModSubtract(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		uint32_t* r1 = numberWorkspacePush(2*length);
+		if(!r1) return 0;
+		uint32_t* r2 = r1+length;
+		if(!base10DivMod(src1,src3,NULL,r1,length) || !base10DivMod(src2,src3,NULL,r2,length))
+		{
+			memset((void*) dest,0,sizeof(uint32_t)*length);
+			numberWorkspacePop(r1);
+			return 0;
+		}
+		base10ResidueDifference(r1,r2,src3,base10SignificantLength(src3,length));
+		memcpy(dest,r1,sizeof(uint32_t)*length);
+		numberWorkspacePop(r1);
+		return 1;
 	}
-	//Exponentiation
-	int base10Exponentiation(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	//An operand of at most ctx->length significant uint32_t, reduced into residue when wider, NULL on failure
+	static const uint32_t* base10BarrettOperand(const struct barrettContext* ctx, const uint32_t* src, uint32_t* residue, uint16_t length)
 	{
-		//Zero return is error
-        if(length<=0) return 0;
-
-		//Check if src1 is zero
-		int cnt=0;
-		for(cnt=0;cnt<length && src1[cnt]==0;cnt++)
-		{}
-		if(cnt==length && src1[cnt-1]==0)
+		if(base10SignificantLength(src,length)<=ctx->length) return src;
+		if(!base10BarrettReduce(ctx,src,residue,length)) return NULL;
+		return residue;
+	}
+	//Barrett multiply and add, src3 may be NULL
+	int base10BarrettMultiplyAdd(const struct barrettContext* ctx, const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length)
+	{
+		uint16_t k = ctx->length;
+		if(k==0 || length<k) return 0;
+
+		//Operands below b^k keep a*b+c below b^(2k)
+		uint32_t* residues = numberWorkspacePush(3*length+3*k);
+		if(!residues) return 0;
+		uint32_t* wide = residues+3*length;
+		uint32_t* reduced = wide+2*k;
+		const uint32_t* a = base10BarrettOperand(ctx,src1,residues,length);
+		const uint32_t* b = src2==src1 ? a : base10BarrettOperand(ctx,src2,residues+length,length);
+		const uint32_t* c = src3 ? base10BarrettOperand(ctx,src3,residues+2*length,length) : NULL;
+		if(!a || !b || (src3 && !c))
 		{
-			memset((void*) dest,0,sizeof(uint32_t)*length);
-			return 1;
+			numberWorkspacePop(residues);
+			return 0;
 		}
+		if(a==b)
+			base10SquareProduct(a,k,wide);
+		else
+			base10Product(a,k,b,k,wide);
+		if(c)
+			base10AddInPlace(wide,2*k,c,k);
+
+		int ret = base10BarrettReduceWide(ctx,wide,2*k,reduced);
+		memset((void*) dest,0,sizeof(uint32_t)*length);
+		memcpy(dest,reduced,sizeof(uint32_t)*k);
+		numberWorkspacePop(residues);
+		return ret;
+	}
+	//Barrett multiplication
+	int base10BarrettMultiply(const struct barrettContext* ctx, const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		return base10BarrettMultiplyAdd(ctx,src1,src2,NULL,dest,length);
+	}
+	//Barrett subtraction
+	int base10BarrettSubtract(const struct barrettContext* ctx, const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		uint16_t k = ctx->length;
+		if(k==0 || length<k) return 0;
 
-		uint32_t* temp1 = (uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* temp2 = (uint32_t*) malloc(length*sizeof(uint32_t));
-
-		//Zero
-		memset((void*) temp1,0,sizeof(uint32_t)*length);
-		memcpy((void*) temp2,src1,sizeof(uint32_t)*length);
-		temp1[0]=1;
-
-		int cur_state=1;
-		int ret_state=1;
-		for(cnt=0;cnt<32*length && ret_state;cnt++)
+		uint32_t* r1 = numberWorkspacePush(2*length);
+		if(!r1) return 0;
+		uint32_t* r2 = r1+length;
+		if(!base10BarrettReduce(ctx,src1,r1,length) || !base10BarrettReduce(ctx,src2,r2,length))
 		{
-			int bigPos=cnt/32;
-			int smallPos=cnt%32;
-			if(src2[bigPos]&(1<<smallPos))
-			{
-				if(!cur_state || !base10Multiplication(temp1,temp2,temp1,length))
-					ret_state=0;
-			}
-			cur_state=base10Multiplication(temp2,temp2,temp2,length);
+			numberWorkspacePop(r1);
+			return 0;
 		}
-
-		memcpy((void*) dest,temp1,sizeof(uint32_t)*length);
-		free(temp1);
-		free(temp2);
-
-		return ret_state;
+		base10ResidueDifference(r1,r2,ctx->modulus,k);
+		memcpy(dest,r1,sizeof(uint32_t)*length);
+		numberWorkspacePop(r1);
+		return 1;
 	}
 	//Modulo exponentiation
 	int base10ModuloExponentiation(const uint32_t* src1, const uint32_t* src2,const uint32_t* src3, uint32_t* dest, uint16_t length)
@@ -351,44 +1223,67 @@ extern "C" {
 			return 1;
 		}
 
-		uint32_t* temp1 = (uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* temp2 = (uint32_t*) malloc(length*sizeof(uint32_t));
+		//Odd moduli use Montgomery multiplication when no square can overflow
+		if((src3[0]&1) && 2*base10BitLength(src3,length)<=32*length && 2*base10BitLength(src1,length)<=32*length)
+		{
+			struct montgomeryContext ctx;
+			uint16_t modLen = base10SignificantLength(src3,length);
+			uint32_t* storage = numberWorkspacePush(2*modLen);
+			if(!storage) return 0;
+			int ret = base10MontgomeryBuild(&ctx,src3,modLen,storage);
+			if(ret) ret = base10MontgomeryExponentiation(&ctx,src1,src2,dest,length);
+			numberWorkspacePop(storage);
+			return ret;
+		}
+
+		//Every other modulus is reduced by Barrett after each product
+		struct barrettContext ctx;
+		uint16_t modLen = base10SignificantLength(src3,length);
+		uint32_t* temp1 = numberWorkspacePush(2*length+2*modLen+2);
+		if(!temp1) return 0;
+		uint32_t* temp2 = temp1+length;
+		if(!base10BarrettBuild(&ctx,src3,modLen,temp2+length))
+		{
+			numberWorkspacePop(temp1);
+			return 0;
+		}
 
 		//Zero
 		memset((void*) temp1,0,sizeof(uint32_t)*length);
 		memcpy((void*) temp2,src1,sizeof(uint32_t)*length);
 		temp1[0]=1;
 
+		//Squares past the highest set bit of the exponent are never used
+		int expBits=base10BitLength(src2,length);
 		int cur_state=1;
 		int ret_state=1;
-		for(cnt=0;cnt<32*length && ret_state;cnt++)
+		for(cnt=0;cnt<expBits && ret_state;cnt++)
 		{
 			int bigPos=cnt/32;
 			int smallPos=cnt%32;
 			if(src2[bigPos]&(1<<smallPos))
 			{
-				if(!cur_state || !base10Multiplication(temp1,temp2,temp1,length))
+				if(!cur_state || !base10Multiplication(temp1,temp2,temp1,length) || !base10BarrettReduce(&ctx,temp1,temp1,length))
 					ret_state=0;
-				base10Modulo(temp1,src3,temp1,length);
 			}
-			cur_state=base10Multiplication(temp2,temp2,temp2,length);
-			base10Modulo(temp2,src3,temp2,length);
+			if(cnt+1<expBits)
+				cur_state=base10Square(temp2,temp2,length) && base10BarrettReduce(&ctx,temp2,temp2,length);
 		}
 
 		memcpy((void*) dest,temp1,sizeof(uint32_t)*length);
-		free(temp1);
-		free(temp2);
+		numberWorkspacePop(temp1);
 
 		return ret_state;
 	}
-	//GCD
-	int base10GCD(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	//Euclidean GCD
+	int base10EuclidGCD(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
 	{
 		if(length<=0) return 0;
-		uint32_t* atrace=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* btrace=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* ttrace=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* zero=(uint32_t*) malloc(length*sizeof(uint32_t));
+		uint32_t* atrace=numberWorkspacePush(4*length);
+		if(!atrace) return 0;
+		uint32_t* btrace=atrace+length;
+		uint32_t* ttrace=btrace+length;
+		uint32_t* zero=ttrace+length;
 
 		memcpy(atrace,src1,length*sizeof(uint32_t));
 		memcpy(btrace,src2,length*sizeof(uint32_t));
@@ -399,10 +1294,7 @@ extern "C" {
 			memcpy(ttrace,btrace,length*sizeof(uint32_t));
 			if(!base10Modulo(atrace,btrace,btrace,length))
 			{
-				free(atrace);
-				free(btrace);
-				free(ttrace);
-				free(zero);
+				numberWorkspacePop(atrace);
 				memset((void*) dest,0,sizeof(uint32_t)*length);
 				dest[0]=1;
 				return 0;
@@ -412,23 +1304,21 @@ extern "C" {
 
 		memcpy(dest,atrace,length*sizeof(uint32_t));
 
-		free(atrace);
-		free(btrace);
-		free(ttrace);
-		free(zero);
+		numberWorkspacePop(atrace);
 
 		return 1;
 	}
-	//Modular inverse
-	int base10ModInverse(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	//Euclidean modular inverse
+	int base10EuclidModInverse(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
 	{
 		if(length<=0) return 0;
 
 		//Check GCD first
-		uint32_t* one=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* newr=(uint32_t*) malloc(length*sizeof(uint32_t));
-        uint32_t* r=(uint32_t*) malloc(length*sizeof(uint32_t));
-        uint32_t* newt =(uint32_t*) malloc(length*sizeof(uint32_t));
+		uint32_t* one=numberWorkspacePush(9*length);
+		if(!one) return 0;
+		uint32_t* newr=one+length;
+        uint32_t* r=newr+length;
+        uint32_t* newt=r+length;
 
 		memset(one,0,length*sizeof(uint32_t));
         memset(r,0,length*sizeof(uint32_t));
@@ -437,27 +1327,24 @@ extern "C" {
 
         int algoStatus=base10Modulo(src1,src2,newr,length);
 		one[0]=1;
-		if(!base10GCD(newr,src2,newt,length) || standardCompare(newt,one,length)!=0)
+		if(!base10EuclidGCD(newr,src2,newt,length) || standardCompare(newt,one,length)!=0)
 		{
 			memcpy(dest,one,length*sizeof(uint32_t));
-			free(one);
-			free(newr);
-            free(r);
-            free(newt);
+			numberWorkspacePop(one);
 			return 0;
 		}
 
-		uint32_t* zero=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* t=(uint32_t*) malloc(length*sizeof(uint32_t));
+		uint32_t* zero=newt+length;
+		uint32_t* t=zero+length;
 
 		memset(zero,0,length*sizeof(uint32_t));
 		memset(t,0,length*sizeof(uint32_t));
 
 		memcpy(newt,one,length*sizeof(uint32_t));
 
-		uint32_t* quotient=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* hld=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* temp=(uint32_t*) malloc(length*sizeof(uint32_t));
+		uint32_t* quotient=t+length;
+		uint32_t* hld=quotient+length;
+		uint32_t* temp=hld+length;
 
 		while(standardCompare(newr,zero,length)!=0 && algoStatus)
 		{
@@ -471,12 +1358,9 @@ extern "C" {
 			algoStatus&=base10Subtraction(t,hld,newt,length);
 			memcpy(t,temp,length*sizeof(uint32_t));
 
+			//Remainder sequence is r mod newr, reducing by src2 stalls when newr divides src2
 			memcpy(temp,newr,length*sizeof(uint32_t));
-			algoStatus&=base10Multiplication(quotient,newr,hld,length);
-			algoStatus&=base10Modulo(hld,src2,hld,length);
-			if(standardCompare(r,hld,length)==-1)
-				algoStatus&=base10Addition(r,src2,r,length);
-			algoStatus&=base10Subtraction(r,hld,newr,length);
+			algoStatus&=base10Modulo(r,newr,newr,length);
 			memcpy(r,temp,length*sizeof(uint32_t));
 
 			algoStatus&=base10Modulo(t,src2,t,length);
@@ -488,21 +1372,329 @@ extern "C" {
 			memcpy(dest,t,length*sizeof(uint32_t));
 
 		//Free all the temps
-		free(one);
-		free(newr);
+		numberWorkspacePop(one);
+
+		return algoStatus;
+	}
+
+	//Number of trailing zero bits
+	static int base10TrailingZeros(const uint32_t* src, uint16_t length)
+	{
+		int cnt=0;
+		while(cnt<length && src[cnt]==0)
+			cnt++;
+		if(cnt==length) return 32*length;
+		int ret = 32*cnt;
+		for(uint32_t low=src[cnt];!(low&1);low>>=1)
+			ret++;
+		return ret;
+	}
+	//Right shift in place
+	static void base10ShiftRightInPlace(uint32_t* src, uint16_t length, int bits)
+	{
+		int bigShift = bits/32;
+		int smallShift = bits%32;
+		for(int cnt=0;cnt<length;cnt++)
+		{
+			uint32_t low = cnt+bigShift<length ? src[cnt+bigShift] : 0;
+			uint32_t high = cnt+bigShift+1<length ? src[cnt+bigShift+1] : 0;
+			src[cnt] = smallShift ? (low>>smallShift)|(high<<(32-smallShift)) : low;
+		}
+	}
+	//Check if a number is one
+	static int base10IsOne(const uint32_t* src, uint16_t length)
+	{
+		return src[0]==1 && base10SignificantLength(src,length)==1;
+	}
+	//Binary GCD
+	int base10GCD(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+		uint32_t* buffer = numberWorkspacePush(2*length);
+		if(!buffer) return 0;
+		uint32_t* a = buffer;
+		uint32_t* b = buffer+length;
+		memcpy(a,src1,length*sizeof(uint32_t));
+		memcpy(b,src2,length*sizeof(uint32_t));
+
+		//gcd(a,0)=a
+		uint16_t len = base10SignificantLength(a,length);
+		uint16_t lenB = base10SignificantLength(b,length);
+		if(len==0 || lenB==0)
+		{
+			memcpy(dest,len==0 ? b : a,length*sizeof(uint32_t));
+			numberWorkspacePop(buffer);
+			return 1;
+		}
+		if(lenB>len) len=lenB;
+
+		//Remove the common power of 2, then keep a odd
+		int zerosA = base10TrailingZeros(a,len);
+		int zerosB = base10TrailingZeros(b,len);
+		int shift = zerosA<zerosB ? zerosA : zerosB;
+		base10ShiftRightInPlace(a,len,zerosA);
+		do
+		{
+			base10ShiftRightInPlace(b,len,base10TrailingZeros(b,len));
+			if(standardCompare(a,b,len)>0)
+			{
+				uint32_t* hld = a;
+				a = b;
+				b = hld;
+			}
+			base10SubtractInPlace(b,len,a,len);
+			while(len>1 && a[len-1]==0 && b[len-1]==0)
+				len--;
+		}
+		while(base10SignificantLength(b,len)!=0);
+
+		int ret = standardLeftShift(a,shift,dest,length);
+		numberWorkspacePop(buffer);
+		return ret;
+	}
+	//Binary inverse modulo an odd number, arrays must leave the top uint32_t clear
+	static int base10OddModInverse(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		uint32_t* u = numberWorkspacePush(4*length);
+		if(!u) return 0;
+		uint32_t* v = u+length;
+		uint32_t* x1 = v+length;
+		uint32_t* x2 = x1+length;
+		memcpy(u,src1,length*sizeof(uint32_t));
+		memcpy(v,src2,length*sizeof(uint32_t));
+		memset(x1,0,2*length*sizeof(uint32_t));
+		x1[0] = 1;
+
+		//Invariants: x1*src1=u and x2*src1=v modulo src2
+		int ret = 0;
+		while(base10SignificantLength(u,length)!=0)
+		{
+			if(base10IsOne(u,length))
+			{
+				memcpy(dest,x1,length*sizeof(uint32_t));
+				ret = 1;
+				break;
+			}
+			if(base10IsOne(v,length))
+			{
+				memcpy(dest,x2,length*sizeof(uint32_t));
+				ret = 1;
+				break;
+			}
 
-		free(zero);
-		free(t);
-		free(r);
-		free(newt);
+			while(!(u[0]&1))
+			{
+				base10ShiftRightInPlace(u,length,1);
+				if(x1[0]&1) base10AddInPlace(x1,length,src2,length);
+				base10ShiftRightInPlace(x1,length,1);
+			}
+			while(!(v[0]&1))
+			{
+				base10ShiftRightInPlace(v,length,1);
+				if(x2[0]&1) base10AddInPlace(x2,length,src2,length);
+				base10ShiftRightInPlace(x2,length,1);
+			}
 
-		free(quotient);
-		free(hld);
-		free(temp);
+			if(standardCompare(u,v,length)>=0)
+			{
+				base10SubtractInPlace(u,length,v,length);
+				if(standardCompare(x1,x2,length)<0) base10AddInPlace(x1,length,src2,length);
+				base10SubtractInPlace(x1,length,x2,length);
+			}
+			else
+			{
+				base10SubtractInPlace(v,length,u,length);
+				if(standardCompare(x2,x1,length)<0) base10AddInPlace(x2,length,src2,length);
+				base10SubtractInPlace(x2,length,x1,length);
+			}
+		}
 
-		return algoStatus;
+		numberWorkspacePop(u);
+		return ret;
+	}
+	//Inverse of an odd number modulo an even number, x=(1+m*(a-(m^-1 mod a)))/a
+	static int base10EvenModInverse(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		uint16_t aLen = base10SignificantLength(src1,length);
+		uint16_t mLen = base10SignificantLength(src2,length);
+		uint16_t aWidth = aLen+1;
+		uint16_t wide = mLen+aLen+1;
+		uint32_t* reduced = numberWorkspacePush(length+3*aWidth+3*wide);
+		if(!reduced) return 0;
+		uint32_t* aw = reduced+length;
+		uint32_t* mw = aw+aWidth;
+		uint32_t* y = mw+aWidth;
+		uint32_t* prod = y+aWidth;
+		uint32_t* divisor = prod+wide;
+		uint32_t* quot = divisor+wide;
+
+		//m^-1 mod a, the modulus is now odd
+		int ret = base10Modulo(src2,src1,reduced,length);
+		memset(aw,0,2*aWidth*sizeof(uint32_t));
+		memcpy(aw,src1,aLen*sizeof(uint32_t));
+		memcpy(mw,reduced,aLen*sizeof(uint32_t));
+		if(ret) ret = base10OddModInverse(mw,aw,y,aWidth);
+
+		if(ret)
+		{
+			//a-y, then (1+m*(a-y))/a
+			base10SubtractInPlace(aw,aWidth,y,aWidth);
+			uint32_t one = 1;
+			prod[wide-1] = 0;
+			base10Product(src2,mLen,aw,aLen,prod);
+			base10AddInPlace(prod,wide,&one,1);
+			memset(divisor,0,wide*sizeof(uint32_t));
+			memcpy(divisor,src1,aLen*sizeof(uint32_t));
+			ret = base10DivMod(prod,divisor,quot,NULL,wide);
+		}
+		if(ret)
+		{
+			memset((void*) dest,0,length*sizeof(uint32_t));
+			memcpy(dest,quot,mLen*sizeof(uint32_t));
+		}
+		numberWorkspacePop(reduced);
+		return ret;
+	}
+	//Binary modular inverse
+	int base10ModInverse(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		if(length<=0) return 0;
+
+		uint16_t modLen = base10SignificantLength(src2,length);
+		uint16_t width = modLen+1;
+		uint32_t* a = numberWorkspacePush(3*width);
+		if(!a) return 0;
+		uint32_t* m = a+width;
+		uint32_t* inv = m+width;
+		memset(a,0,3*width*sizeof(uint32_t));
+
+		//Zero modulus, or no inverse exists
+		int ret = 0;
+		if(modLen>0)
+		{
+			uint32_t* reduced = numberWorkspacePush(length);
+			int good = reduced && base10Modulo(src1,src2,reduced,length);
+			if(good)
+			{
+				memcpy(a,reduced,modLen*sizeof(uint32_t));
+				memcpy(m,src2,modLen*sizeof(uint32_t));
+			}
+			numberWorkspacePop(reduced);
+
+			if(!good)
+				ret = 0;
+			else if(base10IsOne(m,width))
+				ret = 1;
+			else if(base10IsOne(a,width))
+			{
+				inv[0] = 1;
+				ret = 1;
+			}
+			else if(m[0]&1)
+				ret = base10OddModInverse(a,m,inv,width);
+			else if(a[0]&1)
+				ret = base10EvenModInverse(a,m,inv,width);
+		}
+
+		memset((void*) dest,0,length*sizeof(uint32_t));
+		if(ret)
+			memcpy(dest,inv,modLen*sizeof(uint32_t));
+		else
+			dest[0] = 1;
+		numberWorkspacePop(a);
+		return ret;
 	}
+	//Batched modular inverse, one inversion of the product of every argument
+	int base10BatchModInverse(const uint32_t** src1, const uint32_t* src2, uint32_t** dest, uint32_t count, uint16_t length)
+	{
+		if(length<=0) return 0;
+		if(count==0) return 1;
+
+		uint16_t k = base10SignificantLength(src2,length);
+		if(k==0) return 0;
+
+		struct barrettContext ctx;
+		uint32_t* storage = numberWorkspacePush(2*k+2);
+
+		//prefix[i] is the product of the first i+1 residues
+		uint32_t* prefix = numberWorkspacePush(count*(uint32_t)k);
+		uint32_t* reduced = numberWorkspacePush(length);
+		uint32_t* wide = numberWorkspacePush(8*(uint32_t)k);
+		if(!storage || !prefix || !reduced || !wide || !base10BarrettBuild(&ctx,src2,k,storage))
+		{
+			numberWorkspacePop(wide);
+			numberWorkspacePop(reduced);
+			numberWorkspacePop(prefix);
+			numberWorkspacePop(storage);
+			return 0;
+		}
+		uint32_t* inv = wide+2*k;
+		uint32_t* tm = inv+2*k;
+		uint32_t* mod = tm+2*k;
+		int ret = 1;
+		for(uint32_t cnt=0;cnt<count && ret;cnt++)
+		{
+			ret = base10BarrettReduce(&ctx,src1[cnt],reduced,length);
+			uint32_t* pre = prefix+cnt*k;
+			if(cnt==0)
+				memcpy(pre,reduced,k*sizeof(uint32_t));
+			else if(ret)
+				ret = base10BarrettProduct(&ctx,pre-k,reduced,pre,wide);
+
+			//Residues are kept in dest for the second pass, src1 may be dest
+			memset(dest[cnt],0,length*sizeof(uint32_t));
+			memcpy(dest[cnt],reduced,k*sizeof(uint32_t));
+		}
+
+		//A single inversion, which fails if any argument has no inverse
+		if(ret)
+		{
+			memset(tm,0,4*k*sizeof(uint32_t));
+			memcpy(tm,prefix+(count-1)*k,k*sizeof(uint32_t));
+			memcpy(mod,src2,k*sizeof(uint32_t));
+			ret = base10ModInverse(tm,mod,inv,2*k);
+		}
 
+		//Peel one residue off the running inverse at a time
+		for(uint32_t cnt=count-1;ret && cnt>0;cnt--)
+		{
+			ret = base10BarrettProduct(&ctx,inv,prefix+(cnt-1)*k,tm,wide) && base10BarrettProduct(&ctx,inv,dest[cnt],inv,wide);
+			memcpy(dest[cnt],tm,k*sizeof(uint32_t));
+		}
+		if(ret)
+			memcpy(dest[0],inv,k*sizeof(uint32_t));
+
+		numberWorkspacePop(wide);
+		numberWorkspacePop(reduced);
+		numberWorkspacePop(prefix);
+		numberWorkspacePop(storage);
+		return ret;
+	}
+	//Odd primes below 256, trial divisors ahead of Miller-Rabin
+	static const uint16_t _base10TrialPrimes[] = {
+		3,5,7,11,13,17,19,23,29,31,37,41,43,47,53,59,
+		61,67,71,73,79,83,89,97,101,103,107,109,113,127,131,137,
+		139,149,151,157,163,167,173,179,181,191,193,197,199,211,223,227,
+		229,233,239,241,251};
+	static const int _base10TrialCount = sizeof(_base10TrialPrimes)/sizeof(uint16_t);
+	//Remainder of a number by a single limb
+	static uint32_t base10SmallRemainder(const uint32_t* src, uint16_t length, uint32_t div)
+	{
+		uint64_t rem = 0;
+		for(int cnt=length-1;cnt>=0;cnt--)
+			rem = ((rem<<32)|src[cnt])%div;
+		return (uint32_t) rem;
+	}
+	//Smallest trial prime dividing a number, 0 if there is none
+	static uint32_t base10TrialFactor(const uint32_t* src, uint16_t length)
+	{
+		for(int cnt=0;cnt<_base10TrialCount;cnt++)
+		{
+			if(base10SmallRemainder(src,length,_base10TrialPrimes[cnt])==0)
+				return _base10TrialPrimes[cnt];
+		}
+		return 0;
+	}
 	//Tests if a number is prime
 	int primeTest(const uint32_t* src1, uint16_t test_iteration, uint16_t length)
 	{
@@ -511,7 +1703,6 @@ extern "C" {
 
 		int trace = 1;
 		int flag = 0;
-		int algoStatus = 1;
 
 		//Check for zero set
 		while(!flag && trace<length)
@@ -533,9 +1724,26 @@ extern "C" {
 		//Check for even case
 		if(!(src1[0]&1)) return 0;
 
-		//Miller-Rabin Test
-		uint32_t* one=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* minusOne=(uint32_t*) malloc(length*sizeof(uint32_t));
+		//Trial division, a small prime only divides itself
+		uint16_t sigLen = base10SignificantLength(src1,length);
+		uint32_t factor = base10TrialFactor(src1,sigLen);
+		if(factor) return sigLen==1 && src1[0]==factor;
+
+		return base10MillerRabin(src1,test_iteration,length);
+	}
+	//Miller-Rabin rounds on an odd candidate above 3
+	int base10MillerRabin(const uint32_t* src1, uint16_t test_iteration, uint16_t length)
+	{
+		if(length<=0) return 0;
+		if(test_iteration<=2) return 0;
+
+		int trace;
+		int flag;
+		int algoStatus = 1;
+
+		uint32_t* one=numberWorkspacePush(5*length);
+		if(!one) return 0;
+		uint32_t* minusOne=one+length;
 
 		memset(one,0,length*sizeof(uint32_t));
 		one[0]=1;
@@ -552,13 +1760,22 @@ extern "C" {
 				algoStatus=0;
 		}
 
-		uint32_t* x=(uint32_t*) malloc(length*sizeof(uint32_t));
-		uint32_t* d=(uint32_t*) malloc(length*sizeof(uint32_t));
-		algoStatus&=standardLeftShift(minusOne,trace,d,length);
-		uint32_t* test=(uint32_t*) malloc(length*sizeof(uint32_t));
+		uint32_t* x=minusOne+length;
+		uint32_t* d=x+length;
+		algoStatus&=standardRightShift(minusOne,trace,d,length);
+		uint32_t* test=d+length;
+		memset(test,0,length*sizeof(uint32_t));
 		int s=trace;
 		int cnt=0;
 
+		//The squaring loop reduces by the candidate every step
+		struct barrettContext ctx;
+		uint16_t modLen=base10SignificantLength(src1,length);
+		uint32_t* storage=numberWorkspacePush(4*modLen+2);
+		if(!storage || !base10BarrettBuild(&ctx,src1,modLen,storage))
+			algoStatus=0;
+		uint32_t* wide=storage ? storage+2*modLen+2 : NULL;
+
 		//Preform the test
 		srand((unsigned)time(NULL));
 		while(cnt<test_iteration && algoStatus)
@@ -575,13 +1792,13 @@ extern "C" {
 				{
 					trace--;
 					if(flag)
-						test[trace]=rand()^(rand()<<1);
+						test[trace]=(uint32_t)rand()^((uint32_t)rand()<<1);
 					else
 						test[trace]=0;
 					if(src1[trace]!=0&&!flag)
 					{
 						flag=1;
-						test[trace] = (rand()^(rand()<<1))%src1[trace];
+						test[trace] = ((uint32_t)rand()^((uint32_t)rand()<<1))%src1[trace];
 					}
 				}
 				if(test[0]<3)
@@ -594,8 +1811,7 @@ extern "C" {
 				trace=1;
 				while(trace<s&&!flag&&algoStatus)
 				{
-					algoStatus&=base10Multiplication(x,x,x,length);
-					algoStatus&=base10Modulo(x,src1,x,length);
+					algoStatus&=base10BarrettProduct(&ctx,x,x,x,wide);
 
 					if(algoStatus&&standardCompare(x,one,length)==0)
 						algoStatus=0;
@@ -609,14 +1825,423 @@ extern "C" {
 			cnt++;
 		}
 
-		free(x);
-		free(one);
-		free(minusOne);
-		free(d);
-		free(test);
+		numberWorkspacePop(storage);
+		numberWorkspacePop(one);
 
 		return algoStatus;
 	}
+	//Strong probable prime test to base 2 of the context modulus
+	static int base10StrongBaseTwo(const struct barrettContext* ctx)
+	{
+		//The exponentiation needs twice the modulus width
+		uint16_t width = 2*ctx->length;
+		uint32_t* mod = numberWorkspacePush(5*width);
+		if(!mod) return 0;
+		uint32_t* minusOne = mod+width;
+		uint32_t* d = minusOne+width;
+		uint32_t* base = d+width;
+		uint32_t* x = base+width;
+		memset(mod,0,4*width*sizeof(uint32_t));
+		memcpy(mod,ctx->modulus,ctx->length*sizeof(uint32_t));
+		memcpy(minusOne,mod,width*sizeof(uint32_t));
+		minusOne[0]--;
+		base[0] = 2;
+
+		//n-1 = d*2^s
+		int s = 1;
+		while(!(minusOne[s/32]&(1u<<(s%32))))
+			s++;
+		standardRightShift(minusOne,s,d,width);
+
+		int ret = base10ModuloExponentiation(base,d,mod,x,width);
+		int found = base10IsOne(x,width) || standardCompare(x,minusOne,width)==0;
+		for(int cnt=1;ret && !found && cnt<s;cnt++)
+		{
+			ret = base10Square(x,x,width) && base10BarrettReduce(ctx,x,x,width);
+			found = standardCompare(x,minusOne,width)==0;
+		}
+		numberWorkspacePop(mod);
+		return ret && found;
+	}
+	//Jacobi symbol of two small values, n odd
+	static int base10SmallJacobi(uint32_t a, uint32_t n)
+	{
+		int ret = 1;
+		a %= n;
+		while(a)
+		{
+			while(!(a&1))
+			{
+				a >>= 1;
+				if((n&7)==3 || (n&7)==5) ret = -ret;
+			}
+			uint32_t tm = a;
+			a = n;
+			n = tm;
+			if((a&3)==3 && (n&3)==3) ret = -ret;
+			a %= n;
+		}
+		return n==1 ? ret : 0;
+	}
+	//Jacobi symbol (d/n) of a small odd d and an odd n
+	static int base10LucasJacobi(int32_t d, const uint32_t* src, uint16_t length)
+	{
+		uint32_t mag = d<0 ? (uint32_t) -d : (uint32_t) d;
+		int ret = base10SmallJacobi(base10SmallRemainder(src,length,mag),mag);
+
+		//(-1/n), then quadratic reciprocity
+		if(d<0 && (src[0]&3)==3) ret = -ret;
+		if((mag&3)==3 && (src[0]&3)==3) ret = -ret;
+		return ret;
+	}
+	//Checks an odd number for a perfect square, -1 if the check could not run
+	static int base10PerfectSquare(const uint32_t* src, uint16_t length)
+	{
+		//Odd squares are 1 mod 8
+		if((src[0]&7)!=1) return 0;
+
+		uint16_t width = 2*length+2;
+		uint32_t* wide = numberWorkspacePush(4*width);
+		if(!wide) return -1;
+		uint32_t* root = wide+width;
+		uint32_t* quot = root+width;
+		uint32_t* next = quot+width;
+		memset(wide,0,4*width*sizeof(uint32_t));
+		memcpy(wide,src,length*sizeof(uint32_t));
+
+		//Newton's method, from a power of two above the root
+		int bit = (base10BitLength(src,length)+1)/2;
+		root[bit/32] = 1u<<(bit%32);
+		int ret = 1;
+		for(;;)
+		{
+			ret = base10DivMod(wide,root,quot,NULL,width);
+			if(!ret) break;
+			base10AddInPlace(quot,width,root,width);
+			standardRightShift(quot,1,next,width);
+			if(standardCompare(next,root,width)>=0) break;
+			memcpy(root,next,width*sizeof(uint32_t));
+		}
+
+		if(ret) ret = base10Square(root,quot,width);
+		ret = ret ? standardCompare(quot,wide,width)==0 : -1;
+		numberWorkspacePop(wide);
+		return ret;
+	}
+	//Lucas residue times a small signed value
+	static int base10LucasScale(const struct barrettContext* ctx, const uint32_t* src1, int32_t src2, uint32_t* dest, uint32_t* wide)
+	{
+		uint16_t k = ctx->length;
+		memset(wide,0,(k+1)*sizeof(uint32_t));
+		wide[k] = base10MultiplyAccumulate(src1,src2<0 ? (uint32_t) -src2 : (uint32_t) src2,wide,k);
+		if(!base10BarrettReduceWide(ctx,wide,k+1,dest)) return 0;
+		if(src2<0 && base10SignificantLength(dest,k))
+		{
+			memcpy(wide,ctx->modulus,k*sizeof(uint32_t));
+			base10SubtractInPlace(wide,k,dest,k);
+			memcpy(dest,wide,k*sizeof(uint32_t));
+		}
+		return 1;
+	}
+	//Lucas residue addition, dest+=src1
+	static void base10LucasAdd(const struct barrettContext* ctx, const uint32_t* src1, uint32_t* dest)
+	{
+		uint16_t k = ctx->length;
+		if(base10AddInPlace(dest,k,src1,k) || standardCompare(dest,ctx->modulus,k)>=0)
+			base10SubtractInPlace(dest,k,ctx->modulus,k);
+	}
+	//Lucas residue subtraction, dest-=src1
+	static void base10LucasSubtract(const struct barrettContext* ctx, const uint32_t* src1, uint32_t* dest)
+	{
+		uint16_t k = ctx->length;
+		if(base10SubtractInPlace(dest,k,src1,k))
+			base10AddInPlace(dest,k,ctx->modulus,k);
+	}
+	//Lucas residue halving, dest/=2
+	static void base10LucasHalve(const struct barrettContext* ctx, uint32_t* dest)
+	{
+		uint16_t k = ctx->length;
+		uint32_t carry = 0;
+		if(dest[0]&1)
+			carry = base10AddInPlace(dest,k,ctx->modulus,k);
+		for(int cnt=0;cnt<k;cnt++)
+		{
+			uint32_t high = cnt+1<k ? dest[cnt+1] : carry;
+			dest[cnt] = (dest[cnt]>>1)|(high<<31);
+		}
+	}
+	//Strong Lucas probable prime test of the context modulus, with Selfridge's parameters
+	static int base10StrongLucas(const struct barrettContext* ctx)
+	{
+		const uint32_t* mod = ctx->modulus;
+		uint16_t k = ctx->length;
+
+		//First D of 5, -7, 9, -11, ... with (D/n)=-1, the modulus is above every D tried
+		int32_t d = 5;
+		for(int cnt=1;;cnt++)
+		{
+			int jac = base10LucasJacobi(d,mod,k);
+			if(jac==-1) break;
+			if(jac==0) return 0;
+
+			//Squares have no such D, a check that could not run fails the test
+			if(cnt==8 && base10PerfectSquare(mod,k)) return 0;
+			d = d>0 ? -d-2 : -d+2;
+		}
+		int32_t q = (1-d)/4;
+
+		uint32_t* u = numberWorkspacePush(7*k+1);
+		if(!u) return 0;
+		uint32_t* v = u+k;
+		uint32_t* qk = v+k;
+		uint32_t* tm = qk+k;
+		uint32_t* wide = tm+k;
+		uint32_t* exp = wide+2*k;
+		memset(u,0,(7*k+1)*sizeof(uint32_t));
+
+		//n+1 = e*2^s
+		memcpy(exp,mod,k*sizeof(uint32_t));
+		uint32_t one = 1;
+		base10AddInPlace(exp,k+1,&one,1);
+		int s = 1;
+		while(!(exp[s/32]&(1u<<(s%32))))
+			s++;
+		standardRightShift(exp,s,exp,k+1);
+
+		//U_1=1, V_1=P=1 and Q^1
+		u[0] = 1;
+		v[0] = 1;
+		int good = base10LucasScale(ctx,u,q,qk,wide);
+		for(int bit=base10BitLength(exp,k+1)-2;good && bit>=0;bit--)
+		{
+			//U_2j=U_j*V_j, V_2j=V_j^2-2*Q^j
+			good = base10BarrettProduct(ctx,u,v,u,wide) && base10BarrettProduct(ctx,v,v,v,wide);
+			base10LucasSubtract(ctx,qk,v);
+			base10LucasSubtract(ctx,qk,v);
+			good = good && base10BarrettProduct(ctx,qk,qk,qk,wide);
+			if(!good || !(exp[bit/32]&(1u<<(bit%32)))) continue;
+
+			//U_j+1=(U_j+V_j)/2, V_j+1=(D*U_j+V_j)/2
+			good = base10LucasScale(ctx,u,d,tm,wide);
+			base10LucasAdd(ctx,v,tm);
+			base10LucasHalve(ctx,tm);
+			base10LucasAdd(ctx,v,u);
+			base10LucasHalve(ctx,u);
+			memcpy(v,tm,k*sizeof(uint32_t));
+			good = good && base10LucasScale(ctx,qk,q,qk,wide);
+		}
+
+		//U_e=0, or V_e*2^r=0 for some r<s
+		int ret = good && (!base10SignificantLength(u,k) || !base10SignificantLength(v,k));
+		for(int cnt=1;good && !ret && cnt<s;cnt++)
+		{
+			good = base10BarrettProduct(ctx,v,v,v,wide);
+			base10LucasSubtract(ctx,qk,v);
+			base10LucasSubtract(ctx,qk,v);
+			good = good && base10BarrettProduct(ctx,qk,qk,qk,wide);
+			ret = good && !base10SignificantLength(v,k);
+		}
+		numberWorkspacePop(u);
+		return ret;
+	}
+	//Baillie-PSW probable prime test
+	int base10BPSWTest(const uint32_t* src1, uint16_t length)
+	{
+		if(length<=0) return 0;
+
+		//Small values match primeTest
+		uint16_t sigLen = base10SignificantLength(src1,length);
+		if(sigLen<=1 && src1[0]<4) return src1[0]!=0;
+		if(!(src1[0]&1)) return 0;
+
+		uint32_t factor = base10TrialFactor(src1,sigLen);
+		if(factor) return sigLen==1 && src1[0]==factor;
+
+		//No factor below 257, so anything below 257^2 is prime
+		if(sigLen==1 && src1[0]<257*257) return 1;
+
+		struct barrettContext ctx;
+		uint32_t* storage=numberWorkspacePush(2*sigLen+2);
+		int ret = storage && base10BarrettBuild(&ctx,src1,sigLen,storage);
+		ret = ret && base10StrongBaseTwo(&ctx) && base10StrongLucas(&ctx);
+		numberWorkspacePop(storage);
+		return ret;
+	}
+	//Probable prime test in the requested mode
+	int base10ProbablePrime(const uint32_t* src1, int mode, uint16_t test_iteration, uint16_t length)
+	{
+		if(mode==crypto_primetest_bpsw)
+			return base10BPSWTest(src1,length);
+		return primeTest(src1,test_iteration,length);
+	}
+	//Sieve of Eratosthenes over the odd numbers below crypto_primesieve_limit
+	static uint32_t* base10BuildSievePrimes(uint32_t* count)
+	{
+		*count = 0;
+		uint32_t half = crypto_primesieve_limit/2;
+		unsigned char* composite = (unsigned char*) malloc(half);
+		if(!composite) return NULL;
+		memset(composite,0,half);
+		uint32_t total = 0;
+		for(uint32_t cnt=1;cnt<half;cnt++)
+		{
+			if(composite[cnt]) continue;
+			total++;
+			uint32_t p = 2*cnt+1;
+			for(uint32_t mul=p*p/2;mul<half;mul+=p)
+				composite[mul] = 1;
+		}
+
+		uint32_t* primes = (uint32_t*) malloc(total*sizeof(uint32_t));
+		if(primes)
+		{
+			for(uint32_t cnt=1;cnt<half;cnt++)
+			{
+				if(!composite[cnt])
+					primes[(*count)++] = 2*cnt+1;
+			}
+		}
+		free(composite);
+		return primes;
+	}
+	//Built once and shared by every sieve
+	struct base10SievePrimeTable
+	{
+		uint32_t count;
+		uint32_t* primes;
+		base10SievePrimeTable(){primes = base10BuildSievePrimes(&count);}
+		~base10SievePrimeTable(){if(primes) free(primes);}
+	};
+	static const uint32_t* base10SievePrimes(uint32_t* count)
+	{
+		static const struct base10SievePrimeTable table;
+		*count = table.count;
+		return table.primes;
+	}
+	//Build a sieve over the shared prime table
+	int base10PrimeSieveInit(struct primeSieve* sieve, const uint32_t* src1, uint16_t length)
+	{
+		memset(sieve,0,sizeof(struct primeSieve));
+		if(length<=0) return 0;
+
+		uint32_t count;
+		const uint32_t* primes = base10SievePrimes(&count);
+		if(!primes) return 0;
+		sieve->residues = (uint32_t*) malloc(count*sizeof(uint32_t));
+		if(!sieve->residues) return 0;
+		sieve->primes = primes;
+		sieve->count = count;
+
+		//Residues of the starting candidate
+		uint16_t sigLen = base10SignificantLength(src1,length);
+		for(uint32_t cnt=0;cnt<sieve->count;cnt++)
+			sieve->residues[cnt] = base10SmallRemainder(src1,sigLen,sieve->primes[cnt]);
+		if(sigLen==1 && src1[0]<(uint32_t) crypto_primesieve_limit)
+			sieve->small = src1[0];
+		return 1;
+	}
+	//Release a sieve
+	void base10PrimeSieveFree(struct primeSieve* sieve)
+	{
+		if(sieve->residues) free(sieve->residues);
+		memset(sieve,0,sizeof(struct primeSieve));
+	}
+	//Move the sieve's candidate forward by step
+	void base10PrimeSieveAdvance(struct primeSieve* sieve, uint32_t step)
+	{
+		for(uint32_t cnt=0;cnt<sieve->count;cnt++)
+		{
+			uint32_t p = sieve->primes[cnt];
+			uint32_t r = sieve->residues[cnt]+step%p;
+			sieve->residues[cnt] = r>=p ? r-p : r;
+		}
+		if(sieve->small && step<(uint32_t) crypto_primesieve_limit-sieve->small)
+			sieve->small += step;
+		else
+			sieve->small = 0;
+	}
+	//Check the sieve's candidate for a small factor
+	int base10PrimeSieveSurvivor(const struct primeSieve* sieve)
+	{
+		for(uint32_t cnt=0;cnt<sieve->count;cnt++)
+		{
+			if(sieve->residues[cnt]==0 && sieve->primes[cnt]!=sieve->small)
+				return 0;
+		}
+		return 1;
+	}
+	//Walks a sieve and its candidate forward until a probable prime
+	int base10PrimeSieveSearch(struct primeSieve* sieve, uint32_t* src1, uint32_t step, uint32_t count, int mode, uint16_t test_iteration, uint16_t length)
+	{
+		if(length<=0 || step==0 || !sieve->residues) return 0;
+		if(mode!=crypto_primetest_bpsw && test_iteration<=2) return 0;
+
+		uint32_t* inc = numberWorkspacePush(length);
+		if(!inc) return 0;
+		memset(inc,0,length*sizeof(uint32_t));
+		inc[0] = step;
+
+		//The full test only runs on candidates without a small factor
+		int found = 0;
+		for(uint32_t cnt=0;!found && (count==0 || cnt<count);cnt++)
+		{
+			if(base10PrimeSieveSurvivor(sieve) && base10ProbablePrime(src1,mode,test_iteration,length))
+				found = 1;
+			else if(base10Addition(src1,inc,src1,length))
+				base10PrimeSieveAdvance(sieve,step);
+			else
+			{
+				//The range ran past length, nothing is left to walk
+				base10PrimeSieveFree(sieve);
+				break;
+			}
+		}
+		numberWorkspacePop(inc);
+		return found;
+	}
+	//Searches src1, src1+step, ... for a probable prime
+	int base10PrimeSearch(const uint32_t* src1, uint32_t step, uint32_t count, uint32_t* dest, int mode, uint16_t test_iteration, uint16_t length)
+	{
+		if(length<=0 || step==0) return 0;
+		if(mode!=crypto_primetest_bpsw && test_iteration<=2) return 0;
+
+		uint32_t* targ = numberWorkspacePush(length);
+		if(!targ) return 0;
+		memcpy(targ,src1,length*sizeof(uint32_t));
+
+		struct primeSieve sieve;
+		int found = base10PrimeSieveInit(&sieve,targ,length);
+		if(found) found = base10PrimeSieveSearch(&sieve,targ,step,count,mode,test_iteration,length);
+		base10PrimeSieveFree(&sieve);
+
+		if(found) memcpy(dest,targ,length*sizeof(uint32_t));
+		numberWorkspacePop(targ);
+		return found;
+	}
+	//Finds the first probable prime at or above src1
+	int base10NextPrime(const uint32_t* src1, uint32_t* dest, int mode, uint16_t test_iteration, uint16_t length)
+	{
+		if(length<=0) return 0;
+		if(mode!=crypto_primetest_bpsw && test_iteration<=2) return 0;
+
+		if(base10SignificantLength(src1,length)<=1 && src1[0]<=2)
+		{
+			memset(dest,0,length*sizeof(uint32_t));
+			dest[0] = 2;
+			return 1;
+		}
+
+		//Only odd candidates are walked
+		uint32_t* targ = numberWorkspacePush(2*length);
+		if(!targ) return 0;
+		uint32_t* one = targ+length;
+		memset(one,0,length*sizeof(uint32_t));
+		one[0] = !(src1[0]&1);
+		int ret = base10Addition(src1,one,targ,length);
+		if(ret) ret = base10PrimeSearch(targ,2,0,dest,mode,test_iteration,length);
+		numberWorkspacePop(targ);
+		return ret;
+	}
 
 #ifdef __cplusplus
 }
@@ -58,6 +58,39 @@ extern "C" {
      * @return 1 if success, 0 if failed
      */
     int base10Subtraction(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 sized addition
+     *
+     * Preforms src1+src2 where each argument
+     * has its own length.  Only the significant
+     * limbs are walked and dest is zero-filled
+     * above the sum.  dest may be either argument.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] len1 Number of uint32_t in src1
+     * @param [in] src2 Argument 2
+     * @param [in] len2 Number of uint32_t in src2
+     * @param [out] dest Output
+     * @param [in] destLen Number of uint32_t in dest
+     * @return 1 if success, 0 if failed
+     */
+    int base10SizedAddition(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* dest, uint16_t destLen);
+    /** @brief Base-10 sized subtraction
+     *
+     * Preforms src1-src2 where each argument
+     * has its own length.  Only the significant
+     * limbs are walked and dest is zero-filled
+     * above the difference.  dest may be either
+     * argument.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] len1 Number of uint32_t in src1
+     * @param [in] src2 Argument 2
+     * @param [in] len2 Number of uint32_t in src2
+     * @param [out] dest Output
+     * @param [in] destLen Number of uint32_t in dest
+     * @return 1 if success, 0 if failed
+     */
+    int base10SizedSubtraction(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* dest, uint16_t destLen);
 
     /** @brief Base-10 multiplication
      *
@@ -74,6 +107,130 @@ extern "C" {
      * @return 1 if success, 0 if failed
      */
     int base10Multiplication(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 Karatsuba multiplication
+     *
+     * This function takes in two arrays which
+     * represent base-10 numbers, preforms src1*src2
+     * on the pair and then output the result to
+     * dest.  Operands at or above the Karatsuba
+     * threshold are split recursively, smaller
+     * operands fall back to schoolbook multiplication.
+     * Note that all three arrays must be the same size.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10KaratsubaMultiplication(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 sized multiplication
+     *
+     * Preforms src1*src2 where each argument
+     * has its own length.  The product is built
+     * over the significant limbs only, so its
+     * width is exactly the sum of the significant
+     * lengths.  dest may be either argument.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] len1 Number of uint32_t in src1
+     * @param [in] src2 Argument 2
+     * @param [in] len2 Number of uint32_t in src2
+     * @param [out] dest Output
+     * @param [in] destLen Number of uint32_t in dest
+     * @return 1 if success, 0 if the product does not fit
+     */
+    int base10SizedMultiplication(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* dest, uint16_t destLen);
+    /** @brief Karatsuba crossover threshold
+     *
+     * Products where the shorter operand has
+     * fewer significant uint32_t than this
+     * threshold use schoolbook multiplication.
+     *
+     * @return Threshold in uint32_t, 24 by default
+     */
+    uint16_t base10KaratsubaThreshold();
+    /** @brief Set the Karatsuba crossover threshold
+     *
+     * Thresholds below 4 are raised to 4.  Each
+     * product reads the threshold once, so it
+     * may be changed while other threads multiply.
+     *
+     * @param [in] threshold Threshold in uint32_t
+     * @return void
+     */
+    void setBase10KaratsubaThreshold(uint16_t threshold);
+    /** @brief Workspace size for base-10 kernels
+     *
+     * Number of uint32_t a workspace needs so
+     * that any base-10 kernel, including
+     * modulo exponentiation, prime testing and
+     * the 64-bit limb kernels, runs at the given
+     * length without heap allocations.  The bound
+     * holds for any Karatsuba threshold.
+     *
+     * @param [in] length Number of uint32_t in the arrays
+     * @return Workspace size in uint32_t
+     */
+    uint32_t base10WorkspaceSize(uint16_t length);
+    /** @brief Base-10 double-width multiplication
+     *
+     * This function takes in two arrays which
+     * represent base-10 numbers, preforms src1*src2
+     * on the pair and then output the result to
+     * dest.  Note that src1 and src2 must be the
+     * same size and dest must be twice that size.
+     * dest may not overlap either argument.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output, 2*length uint32_t
+     * @param [in] length Number of uint32_t in the arguments
+     * @return 1 if success, 0 if failed
+     */
+    int base10FullMultiplication(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 square
+     *
+     * This function takes in an array which
+     * represents a base-10 number, preforms src1*src1
+     * and then outputs the result to dest.  Each
+     * cross product is computed once and doubled,
+     * operands at or above twice the Karatsuba
+     * threshold are split recursively.  Note that
+     * both arrays must be the same size.
+     *
+     * @param [in] src1 Argument 1
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10Square(const uint32_t* src1, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 sized square
+     *
+     * Preforms src1*src1 where the argument
+     * and the output have their own lengths.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] len1 Number of uint32_t in src1
+     * @param [out] dest Output
+     * @param [in] destLen Number of uint32_t in dest
+     * @return 1 if success, 0 if the square does not fit
+     */
+    int base10SizedSquare(const uint32_t* src1, uint16_t len1, uint32_t* dest, uint16_t destLen);
+    /** @brief Base-10 multiply-accumulate
+     *
+     * Preforms dest+=src1*src2 where src2 is a
+     * single uint32_t.  This is the inner
+     * loop of all of the base-10 multiplication
+     * routines.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Single uint32_t multiplier
+     * @param [in/out] dest Accumulator
+     * @param [in] length Number of uint32_t in src1 and dest
+     * @return Carry out of the top of dest
+     */
+    uint32_t base10MultiplyAccumulate(const uint32_t* src1, uint32_t src2, uint32_t* dest, uint16_t length);
     /** @brief Base-10 division
      *
      * This function takes in two arrays which
@@ -105,6 +262,24 @@ extern "C" {
      */
     int base10Modulo(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
 
+    /** @brief Base-10 division with remainder
+     *
+     * This function takes in two arrays which
+     * represent base-10 numbers, preforms src1/src2
+     * and src1%src2 on the pair in a single pass
+     * and then outputs the results to quot
+     * and rem.  Either output may be NULL.
+     * Note that all four arrays must be the same size.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] quot Quotient
+     * @param [out] rem Remainder
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10DivMod(const uint32_t* src1, const uint32_t* src2, uint32_t* quot, uint32_t* rem, uint16_t length);
+
     /** @brief Base-10 exponentiation
      *
      * This function takes in two arrays which
@@ -120,12 +295,432 @@ extern "C" {
      * @return 1 if success, 0 if failed
      */
 	int base10Exponentiation(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Montgomery reduction context
+     *
+     * Holds the pre-computed values required
+     * to preform Montgomery multiplication against
+     * a single odd modulus.  Built by
+     * base10MontgomeryInit and released by
+     * base10MontgomeryFree.
+     */
+    struct montgomeryContext
+    {
+        /** @brief Significant uint32_t in the modulus */
+        uint16_t length;
+        /** @brief -modulus^-1 mod 2^32 */
+        uint32_t nPrime;
+        /** @brief Modulus, length uint32_t */
+        uint32_t* modulus;
+        /** @brief R^2 mod modulus, length uint32_t */
+        uint32_t* rSquared;
+    };
+
+    /** @brief Build a Montgomery context
+     *
+     * Pre-computes the values needed to preform
+     * Montgomery multiplication modulo src.
+     * The context must be released with
+     * base10MontgomeryFree.
+     *
+     * @param [out] ctx Context to be built
+     * @param [in] src Modulus
+     * @param [in] length Number of uint32_t in src
+     * @return 1 if success, 0 if the modulus is even or zero
+     */
+    int base10MontgomeryInit(struct montgomeryContext* ctx, const uint32_t* src, uint16_t length);
+    /** @brief Release a Montgomery context
+     *
+     * @param [in/out] ctx Context to be released
+     * @return void
+     */
+    void base10MontgomeryFree(struct montgomeryContext* ctx);
+    /** @brief Montgomery multiplication
+     *
+     * Preforms src1*src2*R^-1 mod n, where n
+     * is the context modulus and R=2^(32*ctx->length).
+     * All three arrays must be ctx->length long and
+     * the arguments must be less than the modulus.
+     *
+     * @param [in] ctx Montgomery context
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @return 1 if success, 0 if failed
+     */
+    int base10MontgomeryMultiplication(const struct montgomeryContext* ctx, const uint32_t* src1, const uint32_t* src2, uint32_t* dest);
+    /** @brief Montgomery modulo exponentiation
+     *
+     * Preforms src1^src2 mod n, where n is
+     * the context modulus.  The context may be
+     * re-used for any number of exponentiations.
+     *
+     * @param [in] ctx Montgomery context
+     * @param [in] src1 Base
+     * @param [in] src2 Exponent
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays, at least ctx->length
+     * @return 1 if success, 0 if failed
+     */
+    int base10MontgomeryExponentiation(const struct montgomeryContext* ctx, const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
 	int base10ModuloExponentiation(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length);
 
+    /** @brief Barrett reduction context
+     *
+     * Holds the pre-computed values required
+     * to reduce by a single modulus, odd or
+     * even, without long division.  Built by
+     * base10BarrettInit and released by
+     * base10BarrettFree.
+     */
+    struct barrettContext
+    {
+        /** @brief Significant uint32_t in the modulus, k */
+        uint16_t length;
+        /** @brief Modulus, length uint32_t */
+        uint32_t* modulus;
+        /** @brief floor(2^(64*k)/modulus), length+2 uint32_t */
+        uint32_t* mu;
+    };
+
+    /** @brief Build a Barrett context
+     *
+     * Pre-computes the values needed to preform
+     * Barrett reduction modulo src.  The
+     * context must be released with
+     * base10BarrettFree.
+     *
+     * @param [out] ctx Context to be built
+     * @param [in] src Modulus
+     * @param [in] length Number of uint32_t in src
+     * @return 1 if success, 0 if the modulus is zero
+     */
+    int base10BarrettInit(struct barrettContext* ctx, const uint32_t* src, uint16_t length);
+    /** @brief Release a Barrett context
+     *
+     * @param [in/out] ctx Context to be released
+     * @return void
+     */
+    void base10BarrettFree(struct barrettContext* ctx);
+    /** @brief Barrett reduction
+     *
+     * Preforms src1 mod n, where n is the
+     * context modulus.  Arguments of up to
+     * 2*ctx->length significant uint32_t are
+     * reduced with two partial products,
+     * wider arguments fall back to long division.
+     * src1 and dest may be the same array.
+     *
+     * @param [in] ctx Barrett context
+     * @param [in] src1 Argument
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays, at least ctx->length
+     * @return 1 if success, 0 if failed
+     */
+    int base10BarrettReduce(const struct barrettContext* ctx, const uint32_t* src1, uint32_t* dest, uint16_t length);
+    /** @brief Barrett multiplication
+     *
+     * Preforms (src1*src2) mod n, where n is
+     * the context modulus, reducing the product
+     * directly from the kernel workspace.  When
+     * src1 and src2 are the same array, the
+     * product is a square.  Any of the arrays
+     * may be the same.
+     *
+     * @param [in] ctx Barrett context
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays, at least ctx->length
+     * @return 1 if success, 0 if failed
+     */
+    int base10BarrettMultiply(const struct barrettContext* ctx, const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Barrett multiply and add
+     *
+     * Preforms (src1*src2+src3) mod n, where
+     * n is the context modulus.  Any of the
+     * arrays may be the same.
+     *
+     * @param [in] ctx Barrett context
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [in] src3 Argument 3, may be NULL
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays, at least ctx->length
+     * @return 1 if success, 0 if failed
+     */
+    int base10BarrettMultiplyAdd(const struct barrettContext* ctx, const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length);
+    /** @brief Barrett subtraction
+     *
+     * Preforms (src1-src2) mod n, where n is
+     * the context modulus, so the result is
+     * never negative.  Any of the arrays may
+     * be the same.
+     *
+     * @param [in] ctx Barrett context
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays, at least ctx->length
+     * @return 1 if success, 0 if failed
+     */
+    int base10BarrettSubtract(const struct barrettContext* ctx, const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+
+    /** @brief Base-10 modular multiplication
+     *
+     * Preforms (src1*src2) mod src3.  The full
+     * product is built in the kernel workspace,
+     * so no argument needs to be wider than
+     * its value.  When src1 and src2 are the
+     * same array, the product is a square.
+     * Any of the arrays may be the same.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [in] src3 Modulus
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if the modulus is zero
+     */
+    int base10ModMultiply(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 modular multiply and add
+     *
+     * Preforms (src1*src2+src3) mod src4.  Any
+     * of the arrays may be the same.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [in] src3 Argument 3
+     * @param [in] src4 Modulus
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if the modulus is zero
+     */
+    int base10ModMultiplyAdd(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, const uint32_t* src4, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 modular subtraction
+     *
+     * Preforms (src1-src2) mod src3, so the
+     * result is never negative.  Any of the
+     * arrays may be the same.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [in] src3 Modulus
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if the modulus is zero
+     */
+    int base10ModSubtract(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length);
+
+    /** @brief Base-10 GCD
+     *
+     * Binary (Stein) GCD, preformed in place
+     * on a single copy of the arguments.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
 	int base10GCD(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 Euclidean GCD
+     *
+     * Reference GCD built from repeated
+     * modulo operations.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+	int base10EuclidGCD(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 modular inverse
+     *
+     * Calculates (src1^-1) % src2 with a binary
+     * extended GCD.  Even moduli are handled by
+     * inverting the modulus against src1.  If no
+     * inverse exists, dest is set to 1.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Modulus
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
 	int base10ModInverse(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 Euclidean modular inverse
+     *
+     * Reference modular inverse built from the
+     * extended Euclidean algorithm.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Modulus
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+	int base10EuclidModInverse(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief Base-10 batched modular inverse
+     *
+     * Inverts every src1[i] modulo src2 with a
+     * single modular inverse of their product.
+     * Prefix products and one backward pass
+     * bring the cost of n inverses to one
+     * inverse and 3(n-1) modular products.
+     * src1[i] and dest[i] may be the same array.
+     *
+     * @param [in] src1 Arguments
+     * @param [in] src2 Modulus
+     * @param [out] dest Outputs, left undefined on failure
+     * @param [in] count Number of arguments
+     * @param [in] length Number of uint32_t in each array
+     * @return 1 if success, 0 if any argument has no inverse
+     */
+	int base10BatchModInverse(const uint32_t** src1, const uint32_t* src2, uint32_t** dest, uint32_t count, uint16_t length);
 
 	int primeTest(const uint32_t* src1, uint16_t test_iteration, uint16_t length);
+    /** @brief Base-10 Miller-Rabin rounds
+     *
+     * The rounds of primeTest without its small
+     * cases and trial division.  src1 must be odd
+     * and greater than 3.
+     *
+     * @param [in] src1 Argument
+     * @param [in] test_iteration Number of rounds, more than 2
+     * @param [in] length Number of uint32_t in src1
+     * @return 1 if probably prime, 0 otherwise
+     */
+	int base10MillerRabin(const uint32_t* src1, uint16_t test_iteration, uint16_t length);
+    /** @brief Base-10 Baillie-PSW test
+     *
+     * Trial division by the primes below 256,
+     * a strong probable prime test to base 2 and
+     * a strong Lucas test with Selfridge's
+     * parameters.  No composite is known to
+     * pass both, and the pair costs about three
+     * modular exponentiations.
+     *
+     * @param [in] src1 Argument
+     * @param [in] length Number of uint32_t in src1
+     * @return 1 if probably prime, 0 otherwise
+     */
+	int base10BPSWTest(const uint32_t* src1, uint16_t length);
+    /** @brief Base-10 probable prime test
+     *
+     * @param [in] src1 Argument
+     * @param [in] mode crypto_primetest_millerrabin or crypto_primetest_bpsw
+     * @param [in] test_iteration Miller-Rabin rounds, unused by Baillie-PSW
+     * @param [in] length Number of uint32_t in src1
+     * @return 1 if probably prime, 0 otherwise
+     */
+	int base10ProbablePrime(const uint32_t* src1, int mode, uint16_t test_iteration, uint16_t length);
+
+    /** @brief Small-prime sieve
+     *
+     * Tracks the residues of a candidate modulo
+     * every odd prime below crypto_primesieve_limit.
+     * The residues are stepped along with the
+     * candidate, so rejecting a candidate with a
+     * small factor costs no division.  The table
+     * of primes is built once and shared by every
+     * sieve, each sieve owns only its residues.
+     */
+    struct primeSieve
+    {
+        /** @brief Number of primes in the sieve */
+        uint32_t count;
+        /** @brief Odd primes below crypto_primesieve_limit, shared */
+        const uint32_t* primes;
+        /** @brief Candidate modulo each prime */
+        uint32_t* residues;
+        /** @brief Candidate while it is below crypto_primesieve_limit, 0 otherwise */
+        uint32_t small;
+    };
+
+    /** @brief Build a prime sieve
+     *
+     * @param [out] sieve Sieve to be built
+     * @param [in] src1 Starting candidate
+     * @param [in] length Number of uint32_t in src1
+     * @return 1 if success, 0 if failed
+     */
+	int base10PrimeSieveInit(struct primeSieve* sieve, const uint32_t* src1, uint16_t length);
+    /** @brief Release a prime sieve
+     *
+     * @param [in/out] sieve Sieve to be released
+     * @return void
+     */
+	void base10PrimeSieveFree(struct primeSieve* sieve);
+    /** @brief Advance the sieve's candidate
+     *
+     * @param [in/out] sieve Sieve to be advanced
+     * @param [in] step Amount added to the candidate
+     * @return void
+     */
+	void base10PrimeSieveAdvance(struct primeSieve* sieve, uint32_t step);
+    /** @brief Check the sieve's candidate
+     *
+     * @param [in] sieve Sieve to be checked
+     * @return 1 if no sieve prime divides the candidate, 0 otherwise
+     */
+	int base10PrimeSieveSurvivor(const struct primeSieve* sieve);
+    /** @brief Continue a sieved prime search
+     *
+     * Tests up to count candidates, starting at
+     * src1 and stepping by step, with the sieve
+     * kept in step with src1.  src1 and the sieve
+     * are left on the probable prime if one is
+     * found, else on the next untested candidate,
+     * so a search can be resumed chunk by chunk
+     * without rebuilding the sieve.  If the
+     * candidates run past length, the sieve is
+     * released.
+     *
+     * @param [in/out] sieve Sieve built for src1
+     * @param [in/out] src1 Current candidate
+     * @param [in] step Distance between candidates
+     * @param [in] count Number of candidates, 0 for no bound
+     * @param [in] mode Primality test, as in base10ProbablePrime
+     * @param [in] test_iteration Miller-Rabin rounds
+     * @param [in] length Number of uint32_t in src1
+     * @return 1 if src1 is a probable prime, 0 otherwise
+     */
+	int base10PrimeSieveSearch(struct primeSieve* sieve, uint32_t* src1, uint32_t step, uint32_t count, int mode, uint16_t test_iteration, uint16_t length);
+    /** @brief Base-10 prime search
+     *
+     * Tests count candidates, src1, src1+step,
+     * src1+2*step and so on, and outputs the first
+     * which passes base10ProbablePrime.  Candidates
+     * are screened by a primeSieve first.  Searches
+     * which start at different offsets with the
+     * same step split a range between threads.
+     *
+     * @param [in] src1 First candidate
+     * @param [in] step Distance between candidates
+     * @param [in] count Number of candidates, 0 for no bound
+     * @param [out] dest Output
+     * @param [in] mode Primality test, as in base10ProbablePrime
+     * @param [in] test_iteration Miller-Rabin rounds
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if a prime was found, 0 otherwise
+     */
+	int base10PrimeSearch(const uint32_t* src1, uint32_t step, uint32_t count, uint32_t* dest, int mode, uint16_t test_iteration, uint16_t length);
+    /** @brief Base-10 next prime
+     *
+     * Walks the odd numbers at or above src1
+     * and outputs the first which passes
+     * base10ProbablePrime.  Candidates are
+     * screened by a primeSieve first.
+     *
+     * @param [in] src1 Starting point
+     * @param [out] dest Output
+     * @param [in] mode Primality test, as in base10ProbablePrime
+     * @param [in] test_iteration Miller-Rabin rounds
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+	int base10NextPrime(const uint32_t* src1, uint32_t* dest, int mode, uint16_t test_iteration, uint16_t length);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,1340 @@
+/**
+ * This file implements the base-10 kernels
+ * which process pairs of uint32_t as a single
+ * 64-bit limb with 128-bit intermediates.
+ * Arguments are packed into uint64_t when a
+ * kernel starts and unpacked when it finishes,
+ * so callers only ever see the uint32_t layout.
+ *
+ */
+
+///@cond INTERNAL
+
+#ifndef C_BASE_TEN_64_C
+#define C_BASE_TEN_64_C
+
+#include "c_BaseTen64.h"
+#include <atomic>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef unsigned __int128 base10_64Wide;
+
+//MULX, ADCX and ADOX are reached through GCC/Clang inline assembly on x86-64, IFMA through intrinsics
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define BASE10_64_ADX
+    #define BASE10_64_IFMA
+    #include <immintrin.h>
+#endif
+
+    //Lanes in a batch, and the digits each lane is split into
+    #define BASE10_64_LANES 8
+    #define BASE10_64_DIGIT_BITS 52
+    static const uint64_t base10_64DigitMask = (((uint64_t) 1)<<BASE10_64_DIGIT_BITS)-1;
+
+    static bool baseTen64Init = false;
+    static struct numberType _baseTen64;
+
+    //Returns the definition of a 64-bit limb base Ten number
+    struct numberType* buildBaseTen64Type()
+    {
+        if(baseTen64Init) return &_baseTen64;
+
+        _baseTen64.typeID = crypto_numbertype_base10;
+        _baseTen64.name = crypto_numbername_base10_64;
+
+        _baseTen64.compare = &standardCompare;
+
+        _baseTen64.addition = &base10Addition;
+        _baseTen64.subtraction = &base10Subtraction;
+
+        _baseTen64.rightShift = &standardRightShift;
+        _baseTen64.leftShift = &standardLeftShift;
+
+        _baseTen64.multiplication = &base10_64Multiplication;
+        _baseTen64.square = &base10_64Square;
+        _baseTen64.division = &base10_64Division;
+		_baseTen64.modulo = &base10_64Modulo;
+		_baseTen64.divmod = &base10_64DivMod;
+
+		_baseTen64.exponentiation = &base10_64Exponentiation;
+		_baseTen64.moduloExponentiation = &base10_64ModuloExponentiation;
+
+		_baseTen64.gcd = &base10GCD;
+		_baseTen64.modInverse = &base10ModInverse;
+
+        _baseTen64.sizedCompare = &standardSizedCompare;
+        _baseTen64.sizedAddition = &base10SizedAddition;
+        _baseTen64.sizedSubtraction = &base10SizedSubtraction;
+        _baseTen64.sizedRightShift = &standardSizedRightShift;
+        _baseTen64.sizedLeftShift = &standardSizedLeftShift;
+        _baseTen64.sizedMultiplication = &base10_64SizedMultiplication;
+        _baseTen64.sizedSquare = &base10_64SizedSquare;
+
+        baseTen64Init = true;
+        return &_baseTen64;
+    }
+
+//Packing--------------------------------------------------------
+
+    //Take count uint64_t from the workspace
+    static uint64_t* base10_64Push(int count)
+    {
+        return (uint64_t*) numberWorkspacePush(2*(uint32_t)count);
+    }
+    //Return uint64_t to the workspace
+    static void base10_64Pop(uint64_t* ptr)
+    {
+        numberWorkspacePop((uint32_t*) ptr);
+    }
+    //Significant uint32_t in an array
+    static uint16_t base10_64SignificantWords(const uint32_t* src, uint16_t length)
+    {
+        while(length>0 && src[length-1]==0)
+            length--;
+        return length;
+    }
+    //Significant uint64_t in an array
+    static int base10_64SignificantLength(const uint64_t* src, int length)
+    {
+        while(length>0 && src[length-1]==0)
+            length--;
+        return length;
+    }
+    //Number of significant bits
+    static int base10_64BitLength(const uint32_t* src, uint16_t length)
+    {
+        length = base10_64SignificantWords(src,length);
+        if(length==0) return 0;
+        int ret = 32*(length-1);
+        for(uint32_t top=src[length-1];top;top>>=1)
+            ret++;
+        return ret;
+    }
+    //Pack words uint32_t into (words+1)/2 uint64_t
+    static void base10_64Pack(const uint32_t* src, uint16_t words, uint64_t* dest)
+    {
+        for(int cnt=0;cnt+1<words;cnt+=2)
+            dest[cnt/2] = (uint64_t) src[cnt] | ((uint64_t) src[cnt+1]<<32);
+        if(words&1)
+            dest[words/2] = src[words-1];
+    }
+    //Unpack srcLen uint64_t into length uint32_t, returns 0 if a non-zero uint32_t does not fit
+    static int base10_64Unpack(const uint64_t* src, int srcLen, uint32_t* dest, uint16_t length)
+    {
+        int ret = 1;
+        for(int cnt=length;cnt<2*srcLen;cnt++)
+        {
+            if((uint32_t) (src[cnt/2]>>(32*(cnt&1)))!=0)
+                ret = 0;
+        }
+        for(int cnt=0;cnt<length;cnt++)
+        {
+            if(cnt<2*srcLen)
+                dest[cnt] = (uint32_t) (src[cnt/2]>>(32*(cnt&1)));
+            else
+                dest[cnt] = 0;
+        }
+        return ret;
+    }
+
+//Limb kernels---------------------------------------------------
+
+    //Compare two uint64_t arrays
+    static int base10_64Compare(const uint64_t* src1, const uint64_t* src2, int length)
+    {
+        for(int cnt=length-1;cnt>=0;cnt--)
+        {
+            if(src1[cnt]>src2[cnt])
+                return 1;
+            else if(src1[cnt]<src2[cnt])
+                return -1;
+        }
+        return 0;
+    }
+    //Multiply-accumulate a single limb, returns the carry
+    static uint64_t base10_64MultiplyAccumulate(const uint64_t* src1, uint64_t src2, uint64_t* dest, int length)
+    {
+        uint64_t carry = 0;
+        for(int cnt=0;cnt<length;cnt++)
+        {
+            base10_64Wide tm = (base10_64Wide) src1[cnt] * src2 + dest[cnt] + carry;
+            dest[cnt] = (uint64_t) tm;
+            carry = (uint64_t) (tm>>64);
+        }
+        return carry;
+    }
+#ifdef BASE10_64_ADX
+    //Multiply-accumulate a single limb with MULX, the low halves ride the ADCX carry chain and the high halves ride ADOX
+    __attribute__((target("bmi2,adx"))) static uint64_t base10_64AdxMultiplyAccumulate(const uint64_t* src1, uint64_t src2, uint64_t* dest, int length)
+    {
+        uint64_t carry;
+        uint64_t blocks = (uint64_t) length>>2;
+        uint64_t tail = (uint64_t) length&3;
+
+        //LEA and JRCXZ leave CF and OF alone, so both chains survive the loop control
+        __asm__ volatile(
+            "xorl %%r8d, %%r8d\n\t"
+            "jrcxz 2f\n\t"
+            "1:\n\t"
+            "mulxq (%[src]), %%r9, %%r10\n\t"
+            "adcxq (%[dest]), %%r9\n\t"
+            "adoxq %%r8, %%r9\n\t"
+            "movq %%r9, (%[dest])\n\t"
+            "mulxq 8(%[src]), %%r9, %%r8\n\t"
+            "adcxq 8(%[dest]), %%r9\n\t"
+            "adoxq %%r10, %%r9\n\t"
+            "movq %%r9, 8(%[dest])\n\t"
+            "mulxq 16(%[src]), %%r9, %%r10\n\t"
+            "adcxq 16(%[dest]), %%r9\n\t"
+            "adoxq %%r8, %%r9\n\t"
+            "movq %%r9, 16(%[dest])\n\t"
+            "mulxq 24(%[src]), %%r9, %%r8\n\t"
+            "adcxq 24(%[dest]), %%r9\n\t"
+            "adoxq %%r10, %%r9\n\t"
+            "movq %%r9, 24(%[dest])\n\t"
+            "leaq 32(%[src]), %[src]\n\t"
+            "leaq 32(%[dest]), %[dest]\n\t"
+            "leaq -1(%%rcx), %%rcx\n\t"
+            "jrcxz 2f\n\t"
+            "jmp 1b\n\t"
+            "2:\n\t"
+            "movq %[tail], %%rcx\n\t"
+            "jrcxz 4f\n\t"
+            "3:\n\t"
+            "mulxq (%[src]), %%r9, %%r10\n\t"
+            "adcxq (%[dest]), %%r9\n\t"
+            "adoxq %%r8, %%r9\n\t"
+            "movq %%r9, (%[dest])\n\t"
+            "movq %%r10, %%r8\n\t"
+            "leaq 8(%[src]), %[src]\n\t"
+            "leaq 8(%[dest]), %[dest]\n\t"
+            "leaq -1(%%rcx), %%rcx\n\t"
+            "jrcxz 4f\n\t"
+            "jmp 3b\n\t"
+            "4:\n\t"
+            "movl $0, %%r9d\n\t"
+            "adcxq %%r9, %%r8\n\t"
+            "adoxq %%r9, %%r8\n\t"
+            "movq %%r8, %[carry]\n\t"
+            : [src] "+r" (src1), [dest] "+r" (dest), "+c" (blocks), [carry] "=r" (carry)
+            : "d" (src2), [tail] "r" (tail)
+            : "r8", "r9", "r10", "cc", "memory");
+        return carry;
+    }
+#endif
+
+    //Multiply-accumulate used by products, squares and Montgomery reduction, chosen at startup
+    typedef uint64_t (*base10_64RowFunction)(const uint64_t*, uint64_t, uint64_t*, int);
+    //Read once by each kernel, so a concurrent change never splits one row loop
+    static std::atomic<base10_64RowFunction> _base10_64Row(&base10_64MultiplyAccumulate);
+
+    //Fastest kernel tier on this host
+    int base10_64HostKernelTier()
+    {
+#ifdef BASE10_64_ADX
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx"))
+            return crypto_kerneltier_adx;
+#endif
+        return crypto_kerneltier_portable;
+    }
+    //Current kernel tier
+    int base10_64KernelTier()
+    {
+#ifdef BASE10_64_ADX
+        if(_base10_64Row.load(std::memory_order_relaxed)==&base10_64AdxMultiplyAccumulate)
+            return crypto_kerneltier_adx;
+#endif
+        return crypto_kerneltier_portable;
+    }
+    //Install a kernel tier
+    int base10_64SetKernelTier(int tier)
+    {
+        if(tier==crypto_kerneltier_portable)
+        {
+            _base10_64Row.store(&base10_64MultiplyAccumulate,std::memory_order_relaxed);
+            return 1;
+        }
+#ifdef BASE10_64_ADX
+        if(tier==crypto_kerneltier_adx && base10_64HostKernelTier()==crypto_kerneltier_adx)
+        {
+            _base10_64Row.store(&base10_64AdxMultiplyAccumulate,std::memory_order_relaxed);
+            return 1;
+        }
+#endif
+        return 0;
+    }
+
+    //Lanes used by batched modulo exponentiation, chosen at startup and read once by each batch
+    static std::atomic<int> _base10_64BatchWidth(1);
+
+    //Widest batch on this host
+    int base10_64HostBatchWidth()
+    {
+#ifdef BASE10_64_IFMA
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma"))
+            return BASE10_64_LANES;
+#endif
+        return 1;
+    }
+    //Current batch width
+    int base10_64BatchWidth()
+    {
+        return _base10_64BatchWidth.load(std::memory_order_relaxed);
+    }
+    //Install a batch width
+    int base10_64SetBatchWidth(int width)
+    {
+        if(width!=1 && (width!=BASE10_64_LANES || base10_64HostBatchWidth()!=BASE10_64_LANES))
+            return 0;
+        _base10_64BatchWidth.store(width,std::memory_order_relaxed);
+        return 1;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    //Install the fastest tier and batch width once, before main
+    __attribute__((constructor)) static void base10_64SelectKernelTier()
+    {
+        base10_64SetKernelTier(base10_64HostKernelTier());
+        base10_64SetBatchWidth(base10_64HostBatchWidth());
+    }
+#endif
+    //Multiply-subtract a single limb, returns the borrow
+    static uint64_t base10_64MultiplySubtract(const uint64_t* src1, uint64_t src2, uint64_t* dest, int length)
+    {
+        uint64_t borrow = 0;
+        for(int cnt=0;cnt<length;cnt++)
+        {
+            base10_64Wide tm = (base10_64Wide) src1[cnt] * src2 + borrow;
+            uint64_t low = (uint64_t) tm;
+            borrow = (uint64_t) (tm>>64);
+            if(dest[cnt]<low) borrow++;
+            dest[cnt] -= low;
+        }
+        return borrow;
+    }
+    //Add src into dest in place, returns the carry
+    static uint64_t base10_64AddInPlace(uint64_t* dest, int destLen, const uint64_t* src, int srcLen)
+    {
+        uint64_t carry = 0;
+        int cnt=0;
+        for(cnt=0;cnt<srcLen;cnt++)
+        {
+            base10_64Wide tm = (base10_64Wide) dest[cnt] + src[cnt] + carry;
+            dest[cnt] = (uint64_t) tm;
+            carry = (uint64_t) (tm>>64);
+        }
+        for(;cnt<destLen && carry;cnt++)
+        {
+            dest[cnt]++;
+            carry = (dest[cnt]==0);
+        }
+        return carry;
+    }
+    //Subtract src from dest in place, returns the borrow
+    static uint64_t base10_64SubtractInPlace(uint64_t* dest, int destLen, const uint64_t* src, int srcLen)
+    {
+        uint64_t borrow = 0;
+        int cnt=0;
+        for(cnt=0;cnt<srcLen;cnt++)
+        {
+            base10_64Wide tm = (base10_64Wide) dest[cnt] - src[cnt] - borrow;
+            dest[cnt] = (uint64_t) tm;
+            borrow = (uint64_t) (tm>>64)&1;
+        }
+        for(;cnt<destLen && borrow;cnt++)
+        {
+            borrow = (dest[cnt]==0);
+            dest[cnt]--;
+        }
+        return borrow;
+    }
+    //Schoolbook product, dest must hold len1+len2 and may not overlap
+    static void base10_64SchoolbookMultiplication(const uint64_t* src1, int len1, const uint64_t* src2, int len2, uint64_t* dest)
+    {
+        base10_64RowFunction row = _base10_64Row.load(std::memory_order_relaxed);
+        memset(dest,0,sizeof(uint64_t)*(len1+len2));
+        for(int cnt=0;cnt<len1;cnt++)
+        {
+            if(src1[cnt]==0) continue;
+            dest[cnt+len2] = row(src2,src1[cnt],dest+cnt,len2);
+        }
+    }
+    //Schoolbook square, each cross product is computed once and doubled, dest must hold 2*len and may not overlap
+    static void base10_64SchoolbookSquare(const uint64_t* src, int len, uint64_t* dest)
+    {
+        base10_64RowFunction row = _base10_64Row.load(std::memory_order_relaxed);
+        memset(dest,0,sizeof(uint64_t)*2*len);
+        for(int cnt=0;cnt<len;cnt++)
+        {
+            if(src[cnt]==0) continue;
+            dest[cnt+len] = row(src+cnt+1,src[cnt],dest+2*cnt+1,len-cnt-1);
+        }
+
+        //Double the cross products and add the diagonal
+        uint64_t top = 0;
+        uint64_t carry = 0;
+        for(int cnt=0;cnt<len;cnt++)
+        {
+            uint64_t low = dest[2*cnt];
+            uint64_t high = dest[2*cnt+1];
+            base10_64Wide sq = (base10_64Wide) src[cnt] * src[cnt];
+            base10_64Wide tm = (base10_64Wide) ((low<<1)|top) + (uint64_t) sq + carry;
+            dest[2*cnt] = (uint64_t) tm;
+            tm = (base10_64Wide) ((high<<1)|(low>>63)) + (uint64_t) (sq>>64) + (uint64_t) (tm>>64);
+            dest[2*cnt+1] = (uint64_t) tm;
+            top = high>>63;
+            carry = (uint64_t) (tm>>64);
+        }
+    }
+
+//Karatsuba------------------------------------------------------
+
+    //Karatsuba threshold in uint64_t, half of the base-10 threshold
+    static int base10_64KaratsubaThreshold()
+    {
+        //Below 4 limbs the split does not shrink the operands
+        int threshold = base10KaratsubaThreshold()/2;
+        if(threshold<4) threshold=4;
+        return threshold;
+    }
+    //Scratch space, in uint64_t, required for a Karatsuba product of the given length
+    static int base10_64KaratsubaScratch(int length, int threshold)
+    {
+        if(length<threshold) return 0;
+        int high = (length+1)/2;
+        return 4*(high+1)+base10_64KaratsubaScratch(high+1,threshold);
+    }
+    //Karatsuba product, dest must hold 2*length and may not overlap
+    static void base10_64KaratsubaProduct(const uint64_t* src1, const uint64_t* src2, int length, uint64_t* dest, uint64_t* scratch, int threshold)
+    {
+        if(length<threshold)
+        {
+            base10_64SchoolbookMultiplication(src1,length,src2,length,dest);
+            return;
+        }
+
+        //src = high*B^low + low
+        int low = length/2;
+        int high = length-low;
+        uint64_t* sum1 = scratch;
+        uint64_t* sum2 = sum1+high+1;
+        uint64_t* mid = sum2+high+1;
+        uint64_t* next = mid+2*(high+1);
+
+        //Low and high products
+        base10_64KaratsubaProduct(src1,src2,low,dest,next,threshold);
+        base10_64KaratsubaProduct(src1+low,src2+low,high,dest+2*low,next,threshold);
+
+        //Middle product (low1+high1)*(low2+high2)
+        memcpy(sum1,src1+low,sizeof(uint64_t)*high);
+        sum1[high] = base10_64AddInPlace(sum1,high,src1,low);
+        memcpy(sum2,src2+low,sizeof(uint64_t)*high);
+        sum2[high] = base10_64AddInPlace(sum2,high,src2,low);
+        base10_64KaratsubaProduct(sum1,sum2,high+1,mid,next,threshold);
+
+        //Remove the outer products and fold in
+        base10_64SubtractInPlace(mid,2*(high+1),dest,2*low);
+        base10_64SubtractInPlace(mid,2*(high+1),dest+2*low,2*high);
+        base10_64AddInPlace(dest+low,2*length-low,mid,base10_64SignificantLength(mid,2*(high+1)));
+    }
+    //Karatsuba square, dest must hold 2*length and may not overlap
+    static void base10_64KaratsubaSquare(const uint64_t* src, int length, uint64_t* dest, uint64_t* scratch, int threshold)
+    {
+        //Schoolbook squares are half the work of a product, so they split later
+        if(length<2*threshold)
+        {
+            base10_64SchoolbookSquare(src,length,dest);
+            return;
+        }
+
+        //Same split as the product, with one sum instead of two
+        int low = length/2;
+        int high = length-low;
+        uint64_t* sum = scratch;
+        uint64_t* mid = sum+high+1;
+        uint64_t* next = mid+2*(high+1);
+
+        base10_64KaratsubaSquare(src,low,dest,next,threshold);
+        base10_64KaratsubaSquare(src+low,high,dest+2*low,next,threshold);
+
+        memcpy(sum,src+low,sizeof(uint64_t)*high);
+        sum[high] = base10_64AddInPlace(sum,high,src,low);
+        base10_64KaratsubaSquare(sum,high+1,mid,next,threshold);
+
+        base10_64SubtractInPlace(mid,2*(high+1),dest,2*low);
+        base10_64SubtractInPlace(mid,2*(high+1),dest+2*low,2*high);
+        base10_64AddInPlace(dest+low,2*length-low,mid,base10_64SignificantLength(mid,2*(high+1)));
+    }
+    //Square of a significant length, dest must hold 2*len and may not overlap
+    static void base10_64SquareProduct(const uint64_t* src, int len, uint64_t* dest)
+    {
+        int threshold = base10_64KaratsubaThreshold();
+        if(len<2*threshold)
+        {
+            base10_64SchoolbookSquare(src,len,dest);
+            return;
+        }
+
+        //Product scratch covers the smaller squaring layout
+        uint64_t* scratch = base10_64Push(base10_64KaratsubaScratch(len,threshold));
+        if(scratch) base10_64KaratsubaSquare(src,len,dest,scratch,threshold);
+        else base10_64SchoolbookSquare(src,len,dest);
+        base10_64Pop(scratch);
+    }
+    //Product of significant lengths at one threshold, dest must hold len1+len2 and may not overlap
+    static void base10_64ThresholdProduct(const uint64_t* src1, int len1, const uint64_t* src2, int len2, uint64_t* dest, int threshold)
+    {
+        //src1 is the longer argument
+        if(len1<len2)
+        {
+            base10_64ThresholdProduct(src2,len2,src1,len1,dest,threshold);
+            return;
+        }
+        if(len2<threshold)
+        {
+            base10_64SchoolbookMultiplication(src1,len1,src2,len2,dest);
+            return;
+        }
+        if(len1==len2)
+        {
+            uint64_t* scratch = base10_64Push(base10_64KaratsubaScratch(len2,threshold));
+            if(scratch) base10_64KaratsubaProduct(src1,src2,len2,dest,scratch,threshold);
+            else base10_64SchoolbookMultiplication(src1,len1,src2,len2,dest);
+            base10_64Pop(scratch);
+            return;
+        }
+
+        //Balanced products of len2 uint64_t chunks of src1, rather than padding src2 to len1
+        uint64_t* part = base10_64Push(2*len2+base10_64KaratsubaScratch(len2,threshold));
+        if(!part)
+        {
+            base10_64SchoolbookMultiplication(src1,len1,src2,len2,dest);
+            return;
+        }
+        memset(dest,0,sizeof(uint64_t)*(len1+len2));
+        int pos = 0;
+        for(;len1-pos>=len2;pos+=len2)
+        {
+            base10_64KaratsubaProduct(src1+pos,src2,len2,part,part+2*len2,threshold);
+            base10_64AddInPlace(dest+pos,len1+len2-pos,part,2*len2);
+        }
+        if(pos<len1)
+        {
+            base10_64ThresholdProduct(src1+pos,len1-pos,src2,len2,part,threshold);
+            base10_64AddInPlace(dest+pos,len1+len2-pos,part,len1-pos+len2);
+        }
+        base10_64Pop(part);
+    }
+    //Product of significant lengths, dest must hold len1+len2 and may not overlap
+    static void base10_64Product(const uint64_t* src1, int len1, const uint64_t* src2, int len2, uint64_t* dest)
+    {
+        base10_64ThresholdProduct(src1,len1,src2,len2,dest,base10_64KaratsubaThreshold());
+    }
+
+//Number type kernels--------------------------------------------
+
+    //Multiplication
+    int base10_64Multiplication(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+    {
+        return base10_64SizedMultiplication(src1,length,src2,length,dest,length);
+    }
+    //Sized multiplication
+    int base10_64SizedMultiplication(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* dest, uint16_t destLen)
+    {
+        if(destLen<=0) return 0;
+
+        uint16_t words1 = base10_64SignificantWords(src1,len1);
+        uint16_t words2 = base10_64SignificantWords(src2,len2);
+        if(words1==0 || words2==0)
+        {
+            memset(dest,0,sizeof(uint32_t)*destLen);
+            return 1;
+        }
+
+        //Pack, build the full product, then truncate
+        int limbs1 = (words1+1)/2;
+        int limbs2 = (words2+1)/2;
+        uint64_t* arg1 = base10_64Push(2*(limbs1+limbs2));
+        if(!arg1) return 0;
+        uint64_t* arg2 = arg1+limbs1;
+        uint64_t* targ = arg2+limbs2;
+        base10_64Pack(src1,words1,arg1);
+        base10_64Pack(src2,words2,arg2);
+        base10_64Product(arg1,limbs1,arg2,limbs2,targ);
+        int ret = base10_64Unpack(targ,limbs1+limbs2,dest,destLen);
+        base10_64Pop(arg1);
+        return ret;
+    }
+    //Square
+    int base10_64Square(const uint32_t* src1, uint32_t* dest, uint16_t length)
+    {
+        return base10_64SizedSquare(src1,length,dest,length);
+    }
+    //Sized square
+    int base10_64SizedSquare(const uint32_t* src1, uint16_t len1, uint32_t* dest, uint16_t destLen)
+    {
+        if(destLen<=0) return 0;
+
+        uint16_t words = base10_64SignificantWords(src1,len1);
+        if(words==0)
+        {
+            memset(dest,0,sizeof(uint32_t)*destLen);
+            return 1;
+        }
+
+        //Pack, build the full square, then truncate
+        int len = (words+1)/2;
+        uint64_t* arg = base10_64Push(3*len);
+        if(!arg) return 0;
+        uint64_t* targ = arg+len;
+        base10_64Pack(src1,words,arg);
+        base10_64SquareProduct(arg,len,targ);
+        int ret = base10_64Unpack(targ,2*len,dest,destLen);
+        base10_64Pop(arg);
+        return ret;
+    }
+    //Division and modulo of packed limbs (Knuth, algorithm D), numLen>=divLen and the top divisor limb is non-zero
+    static int base10_64DivModLimbs(const uint64_t* src1, int numLen, const uint64_t* src2, int divLen, uint64_t* quot, uint64_t* rem)
+    {
+        //Normalized numerator (one extra uint64_t) and divisor
+        uint64_t* num = base10_64Push(numLen+1+divLen);
+        if(!num) return 0;
+        uint64_t* div = num+numLen+1;
+
+        //Shift so the top bit of the divisor is set
+        int shift = 0;
+        for(uint64_t top=src2[divLen-1];!(top&0x8000000000000000ull);top<<=1)
+            shift++;
+        if(shift)
+        {
+            for(int cnt=divLen-1;cnt>0;cnt--)
+                div[cnt] = (src2[cnt]<<shift)|(src2[cnt-1]>>(64-shift));
+            div[0] = src2[0]<<shift;
+            num[numLen] = src1[numLen-1]>>(64-shift);
+            for(int cnt=numLen-1;cnt>0;cnt--)
+                num[cnt] = (src1[cnt]<<shift)|(src1[cnt-1]>>(64-shift));
+            num[0] = src1[0]<<shift;
+        }
+        else
+        {
+            memcpy(div,src2,sizeof(uint64_t)*divLen);
+            memcpy(num,src1,sizeof(uint64_t)*numLen);
+            num[numLen] = 0;
+        }
+
+        for(int cnt=numLen-divLen;cnt>=0;cnt--)
+        {
+            //Estimate the quotient digit from the top two uint64_t
+            base10_64Wide top = ((base10_64Wide) num[cnt+divLen]<<64)|num[cnt+divLen-1];
+            base10_64Wide qhat = top/div[divLen-1];
+            base10_64Wide rhat = top%div[divLen-1];
+            while((qhat>>64) || (divLen>1 && qhat*div[divLen-2]>((rhat<<64)|num[cnt+divLen-2])))
+            {
+                qhat--;
+                rhat += div[divLen-1];
+                if(rhat>>64) break;
+            }
+
+            //Subtract qhat*div, the estimate is at most one too large
+            uint64_t borrow = base10_64MultiplySubtract(div,(uint64_t) qhat,num+cnt,divLen);
+            if(num[cnt+divLen]<borrow)
+            {
+                qhat--;
+                num[cnt+divLen] += base10_64AddInPlace(num+cnt,divLen,div,divLen)-borrow;
+            }
+            else
+                num[cnt+divLen] -= borrow;
+            if(quot) quot[cnt] = (uint64_t) qhat;
+        }
+
+        //Un-normalize the remainder
+        if(rem)
+        {
+            for(int cnt=0;cnt<divLen;cnt++)
+            {
+                rem[cnt] = num[cnt]>>shift;
+                if(shift) rem[cnt] |= num[cnt+1]<<(64-shift);
+            }
+        }
+        base10_64Pop(num);
+        return 1;
+    }
+    //Division and modulo
+    int base10_64DivMod(const uint32_t* src1, const uint32_t* src2, uint32_t* quot, uint32_t* rem, uint16_t length)
+    {
+        if(length<=0) return 0;
+
+        //Exit if divide by zero
+        uint16_t words2 = base10_64SignificantWords(src2,length);
+        if(words2==0)
+        {
+            if(quot) memset((void*) quot,0,sizeof(uint32_t)*length);
+            if(rem) memset((void*) rem,0,sizeof(uint32_t)*length);
+            return 0;
+        }
+        uint16_t words1 = base10_64SignificantWords(src1,length);
+        int divLen = (words2+1)/2;
+        int numLen = (words1+1)/2;
+        if(numLen<divLen) numLen=divLen;
+
+        //Packed numerator, divisor, quotient and remainder
+        uint64_t* num = base10_64Push(2*numLen+divLen+1);
+        if(!num) return 0;
+        uint64_t* div = num+numLen;
+        uint64_t* q = div+divLen;
+        uint64_t* r = q+numLen-divLen+1;
+        memset(num,0,sizeof(uint64_t)*numLen);
+        base10_64Pack(src1,words1,num);
+        base10_64Pack(src2,words2,div);
+        int ret = base10_64DivModLimbs(num,numLen,div,divLen,q,r);
+
+        //Bind outputs, the quotient and remainder always fit
+        if(ret && quot) base10_64Unpack(q,numLen-divLen+1,quot,length);
+        if(ret && rem) base10_64Unpack(r,divLen,rem,length);
+        base10_64Pop(num);
+        return ret;
+    }
+    //Division
+    int base10_64Division(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+    {
+        return base10_64DivMod(src1,src2,dest,NULL,length);
+    }
+	//Modulo
+	int base10_64Modulo(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		return base10_64DivMod(src1,src2,NULL,dest,length);
+	}
+	//Exponentiation
+	int base10_64Exponentiation(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		//Zero return is error
+        if(length<=0) return 0;
+
+		//Check if src1 is zero
+		if(base10_64SignificantWords(src1,length)==0)
+		{
+			memset((void*) dest,0,sizeof(uint32_t)*length);
+			return 1;
+		}
+
+		uint32_t* temp1 = numberWorkspacePush(2*length);
+		if(!temp1) return 0;
+		uint32_t* temp2 = temp1+length;
+
+		memset((void*) temp1,0,sizeof(uint32_t)*length);
+		memcpy((void*) temp2,src1,sizeof(uint32_t)*length);
+		temp1[0]=1;
+
+		//Squares past the highest set bit of the exponent are never used
+		int expBits=base10_64BitLength(src2,length);
+		int cur_state=1;
+		int ret_state=1;
+		for(int cnt=0;cnt<expBits && ret_state;cnt++)
+		{
+			if(src2[cnt/32]&(1u<<(cnt%32)))
+			{
+				if(!cur_state || !base10_64Multiplication(temp1,temp2,temp1,length))
+					ret_state=0;
+			}
+			if(cnt+1<expBits)
+				cur_state=base10_64Square(temp2,temp2,length);
+		}
+
+		memcpy((void*) dest,temp1,sizeof(uint32_t)*length);
+		numberWorkspacePop(temp1);
+
+		return ret_state;
+	}
+
+//Montgomery-----------------------------------------------------
+
+	//Fill a Montgomery context for a packed odd modulus of sigLen uint64_t, storage holds 2*sigLen
+	static int base10_64MontgomeryBuild(struct montgomeryContext64* ctx, const uint64_t* src, int sigLen, uint64_t* storage)
+	{
+		//n^-1 mod 2^64 by Newton iteration, each step doubles the correct bits
+		uint64_t inv = src[0];
+		for(int cnt=0;cnt<5;cnt++)
+			inv *= 2-src[0]*inv;
+
+		//R^2 mod n where R=2^(64*sigLen)
+		int wideLen = 2*sigLen+1;
+		uint64_t* wide = base10_64Push(wideLen);
+		if(!wide) return 0;
+		memset(wide,0,sizeof(uint64_t)*wideLen);
+		wide[2*sigLen] = 1;
+
+		ctx->length = (uint16_t) sigLen;
+		ctx->nPrime = (uint64_t) 0-inv;
+		ctx->modulus = storage;
+		ctx->rSquared = storage+sigLen;
+		memcpy(ctx->modulus,src,sizeof(uint64_t)*sigLen);
+		int ret = base10_64DivModLimbs(wide,wideLen,src,sigLen,NULL,ctx->rSquared);
+		base10_64Pop(wide);
+		return ret;
+	}
+	//Montgomery context
+	int base10_64MontgomeryInit(struct montgomeryContext64* ctx, const uint32_t* src, uint16_t length)
+	{
+		ctx->length = 0;
+		ctx->nPrime = 0;
+		ctx->modulus = NULL;
+		ctx->rSquared = NULL;
+
+		//Only defined for odd moduli
+		uint16_t words = base10_64SignificantWords(src,length);
+		if(words==0 || !(src[0]&1)) return 0;
+
+		int sigLen = (words+1)/2;
+		uint64_t* storage = (uint64_t*) malloc(2*sigLen*sizeof(uint64_t));
+		if(!storage) return 0;
+		uint64_t* packed = base10_64Push(sigLen);
+		int ret = packed!=NULL;
+		if(ret)
+		{
+			base10_64Pack(src,words,packed);
+			ret = base10_64MontgomeryBuild(ctx,packed,sigLen,storage);
+			base10_64Pop(packed);
+		}
+		if(!ret) base10_64MontgomeryFree(ctx);
+		return ret;
+	}
+	//Free Montgomery context
+	void base10_64MontgomeryFree(struct montgomeryContext64* ctx)
+	{
+		if(ctx->modulus) free(ctx->modulus);
+		ctx->length = 0;
+		ctx->nPrime = 0;
+		ctx->modulus = NULL;
+		ctx->rSquared = NULL;
+	}
+	//Montgomery reduction of a 2*length+1 product, scratch is overwritten
+	static void base10_64MontgomeryReduce(const struct montgomeryContext64* ctx, uint64_t* scratch, uint64_t* dest)
+	{
+		int length = ctx->length;
+		base10_64RowFunction row = _base10_64Row.load(std::memory_order_relaxed);
+		for(int cnt=0;cnt<length;cnt++)
+		{
+			uint64_t m = scratch[cnt]*ctx->nPrime;
+			uint64_t carry = row(ctx->modulus,m,scratch+cnt,length);
+			base10_64AddInPlace(scratch+cnt+length,2*length+1-cnt-length,&carry,1);
+		}
+
+		//Result is below 2n, one subtraction at most
+		uint64_t* result = scratch+length;
+		if(result[length] || base10_64Compare(result,ctx->modulus,length)>=0)
+			base10_64SubtractInPlace(result,length+1,ctx->modulus,length);
+		memcpy(dest,result,sizeof(uint64_t)*length);
+	}
+	//Montgomery product, a*b*R^-1 mod n
+	static void base10_64MontgomeryProduct(const struct montgomeryContext64* ctx, const uint64_t* src1, const uint64_t* src2, uint64_t* dest, uint64_t* scratch)
+	{
+		base10_64Product(src1,ctx->length,src2,ctx->length,scratch);
+		scratch[2*ctx->length] = 0;
+		base10_64MontgomeryReduce(ctx,scratch,dest);
+	}
+	//Montgomery square, a*a*R^-1 mod n
+	static void base10_64MontgomerySquare(const struct montgomeryContext64* ctx, const uint64_t* src, uint64_t* dest, uint64_t* scratch)
+	{
+		base10_64SquareProduct(src,ctx->length,scratch);
+		scratch[2*ctx->length] = 0;
+		base10_64MontgomeryReduce(ctx,scratch,dest);
+	}
+	//Sliding window size for an exponent of the given bit length
+	static int base10_64WindowBits(int expBits)
+	{
+		if(expBits>671) return 6;
+		if(expBits>239) return 5;
+		if(expBits>79) return 4;
+		if(expBits>23) return 3;
+		return 1;
+	}
+	//Montgomery modulo exponentiation
+	int base10_64MontgomeryExponentiation(const struct montgomeryContext64* ctx, const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length)
+	{
+		int modLen = ctx->length;
+		if(modLen==0) return 0;
+
+		//The modulus, and so the result, must fit in length uint32_t
+		if(2*modLen>length+1 || (2*modLen==length+1 && (ctx->modulus[modLen-1]>>32)))
+			return 0;
+
+		//Check if src1 is zero
+		uint16_t words1 = base10_64SignificantWords(src1,length);
+		if(words1==0)
+		{
+			memset((void*) dest,0,sizeof(uint32_t)*length);
+			return 1;
+		}
+
+		//Exponent of zero
+		int expBits = base10_64BitLength(src2,length);
+		if(expBits==0)
+		{
+			memset((void*) dest,0,sizeof(uint32_t)*length);
+			dest[0] = 1;
+			return 1;
+		}
+
+		int len1 = (words1+1)/2;
+		if(len1<modLen) len1=modLen;
+		uint64_t* packed = base10_64Push(len1+5*modLen+1);
+		if(!packed) return 0;
+		uint64_t* base = packed+len1;
+		uint64_t* acc = base+modLen;
+		uint64_t* reduced = acc+modLen;
+		uint64_t* scratch = reduced+modLen;
+
+		//Reduce the base, then move it into Montgomery form
+		memset(packed,0,sizeof(uint64_t)*len1);
+		base10_64Pack(src1,words1,packed);
+		if(!base10_64DivModLimbs(packed,len1,ctx->modulus,modLen,NULL,reduced))
+		{
+			base10_64Pop(packed);
+			return 0;
+		}
+		base10_64MontgomeryProduct(ctx,reduced,ctx->rSquared,base,scratch);
+
+		if(expBits<=32)
+		{
+			//Single uint32_t exponents (such as 65537) run left-to-right from the base
+			memcpy(acc,base,sizeof(uint64_t)*modLen);
+			for(int cnt=expBits-2;cnt>=0;cnt--)
+			{
+				base10_64MontgomerySquare(ctx,acc,acc,scratch);
+				if(src2[0]&(1u<<cnt))
+					base10_64MontgomeryProduct(ctx,acc,base,acc,scratch);
+			}
+		}
+		else
+		{
+			//Odd powers base^1, base^3, ... base^(2^window-1)
+			int window = base10_64WindowBits(expBits);
+			int tableSize = 1<<(window-1);
+			uint64_t* table = base10_64Push((tableSize+1)*modLen);
+			if(!table)
+			{
+				base10_64Pop(packed);
+				return 0;
+			}
+			uint64_t* baseSquared = table+tableSize*modLen;
+			memcpy(table,base,sizeof(uint64_t)*modLen);
+			base10_64MontgomerySquare(ctx,base,baseSquared,scratch);
+			for(int cnt=1;cnt<tableSize;cnt++)
+				base10_64MontgomeryProduct(ctx,table+(cnt-1)*modLen,baseSquared,table+cnt*modLen,scratch);
+
+			//Left-to-right sliding window, the top bit is always set
+			int first = 1;
+			int pos = expBits-1;
+			while(pos>=0)
+			{
+				if(!(src2[pos/32]&(1u<<(pos%32))))
+				{
+					base10_64MontgomerySquare(ctx,acc,acc,scratch);
+					pos--;
+					continue;
+				}
+
+				//Longest window ending in a set bit
+				int low = pos-window+1;
+				if(low<0) low=0;
+				while(!(src2[low/32]&(1u<<(low%32))))
+					low++;
+				int value = 0;
+				for(int cnt=pos;cnt>=low;cnt--)
+					value = (value<<1)|((src2[cnt/32]>>(cnt%32))&1);
+
+				if(first)
+					memcpy(acc,table+(value/2)*modLen,sizeof(uint64_t)*modLen);
+				else
+				{
+					for(int cnt=pos;cnt>=low;cnt--)
+						base10_64MontgomerySquare(ctx,acc,acc,scratch);
+					base10_64MontgomeryProduct(ctx,acc,table+(value/2)*modLen,acc,scratch);
+				}
+				first = 0;
+				pos = low-1;
+			}
+			base10_64Pop(table);
+		}
+
+		//Leave Montgomery form
+		memcpy(scratch,acc,sizeof(uint64_t)*modLen);
+		memset(scratch+modLen,0,sizeof(uint64_t)*(modLen+1));
+		base10_64MontgomeryReduce(ctx,scratch,acc);
+
+		base10_64Unpack(acc,modLen,dest,length);
+		base10_64Pop(packed);
+		return 1;
+	}
+	//Modulo exponentiation
+	int base10_64ModuloExponentiation(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length)
+	{
+		//Zero return is error
+        if(length<=0) return 0;
+
+		//Even moduli, and arguments whose reference squares could overflow, keep the base-10 behaviour
+		if(!(src3[0]&1) || 2*base10_64BitLength(src3,length)>32*length || 2*base10_64BitLength(src1,length)>32*length)
+			return base10ModuloExponentiation(src1,src2,src3,dest,length);
+
+		//Check if src1 is zero
+		if(base10_64SignificantWords(src1,length)==0)
+		{
+			memset((void*) dest,0,sizeof(uint32_t)*length);
+			return 1;
+		}
+
+		//Temporary context drawn from the workspace
+		struct montgomeryContext64 ctx;
+		uint16_t words = base10_64SignificantWords(src3,length);
+		int modLen = (words+1)/2;
+		uint64_t* storage = base10_64Push(3*modLen);
+		if(!storage) return 0;
+		uint64_t* packed = storage+2*modLen;
+		base10_64Pack(src3,words,packed);
+		int ret = base10_64MontgomeryBuild(&ctx,packed,modLen,storage);
+		if(ret) ret = base10_64MontgomeryExponentiation(&ctx,src1,src2,dest,length);
+		base10_64Pop(storage);
+		return ret;
+	}
+
+//Batches--------------------------------------------------------
+
+#ifdef BASE10_64_IFMA
+
+    //Whether the scalar kernel would run the Montgomery ladder, and the result is not trivially 0 or 1
+    static int base10_64LaneEligible(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint16_t length)
+    {
+        if(!(src3[0]&1) || 2*base10_64BitLength(src3,length)>32*length || 2*base10_64BitLength(src1,length)>32*length)
+            return 0;
+        return base10_64SignificantWords(src1,length)>0 && base10_64SignificantWords(src2,length)>0;
+    }
+
+    //Lane-interleaved Montgomery product in 52-bit digits, a*b*2^(-52*digits) mod m, operands below m
+    __attribute__((target("avx512f,avx512ifma"))) static void base10_64LaneProduct(const uint64_t* a, const uint64_t* b, const uint64_t* m, const uint64_t* k0, uint64_t* dest, uint64_t* scratch, int digits)
+    {
+        const __m512i zero = _mm512_setzero_si512();
+        const __m512i mask = _mm512_set1_epi64((long long) base10_64DigitMask);
+        const __m512i kVal = _mm512_loadu_si512(k0);
+        //Shifts merge into zero across every lane, the unmasked forms start from an undefined vector
+        const __mmask8 lanes = (__mmask8) 0xFF;
+        for(int cnt=0;cnt<2*digits+1;cnt++)
+            _mm512_storeu_si512(scratch+BASE10_64_LANES*cnt,zero);
+
+        //Digits stay unnormalized, 4*digits additions of 52-bit values fit in a uint64_t
+        for(int i=0;i<digits;i++)
+        {
+            uint64_t* acc = scratch+BASE10_64_LANES*i;
+            __m512i bVal = _mm512_loadu_si512(b+BASE10_64_LANES*i);
+
+            //The bottom digit picks the multiple of m which clears it
+            __m512i aVal = _mm512_loadu_si512(a);
+            __m512i mVal = _mm512_loadu_si512(m);
+            __m512i low = _mm512_madd52lo_epu64(_mm512_loadu_si512(acc),aVal,bVal);
+            __m512i qVal = _mm512_madd52lo_epu64(zero,low,kVal);
+            for(int j=0;j<digits;j++)
+            {
+                if(j>0)
+                {
+                    aVal = _mm512_loadu_si512(a+BASE10_64_LANES*j);
+                    mVal = _mm512_loadu_si512(m+BASE10_64_LANES*j);
+                    low = _mm512_madd52lo_epu64(_mm512_loadu_si512(acc+BASE10_64_LANES*j),aVal,bVal);
+                }
+                __m512i high = _mm512_loadu_si512(acc+BASE10_64_LANES*(j+1));
+                _mm512_storeu_si512(acc+BASE10_64_LANES*j,_mm512_madd52lo_epu64(low,mVal,qVal));
+                high = _mm512_madd52hi_epu64(high,aVal,bVal);
+                _mm512_storeu_si512(acc+BASE10_64_LANES*(j+1),_mm512_madd52hi_epu64(high,mVal,qVal));
+            }
+            __m512i next = _mm512_loadu_si512(acc+BASE10_64_LANES);
+            next = _mm512_add_epi64(next,_mm512_mask_srli_epi64(zero,lanes,_mm512_loadu_si512(acc),BASE10_64_DIGIT_BITS));
+            _mm512_storeu_si512(acc+BASE10_64_LANES,next);
+        }
+
+        //Normalize the upper half, the result is below 2m
+        uint64_t* result = scratch+BASE10_64_LANES*digits;
+        __m512i carry = zero;
+        for(int j=0;j<=digits;j++)
+        {
+            __m512i val = _mm512_add_epi64(_mm512_loadu_si512(result+BASE10_64_LANES*j),carry);
+            carry = _mm512_mask_srli_epi64(zero,lanes,val,BASE10_64_DIGIT_BITS);
+            _mm512_storeu_si512(result+BASE10_64_LANES*j,_mm512_and_si512(val,mask));
+        }
+
+        //Subtract m from the lanes which are not below it
+        __m512i borrow = zero;
+        for(int j=0;j<digits;j++)
+        {
+            __m512i val = _mm512_sub_epi64(_mm512_loadu_si512(result+BASE10_64_LANES*j),_mm512_loadu_si512(m+BASE10_64_LANES*j));
+            val = _mm512_add_epi64(val,borrow);
+            borrow = _mm512_mask_srai_epi64(zero,lanes,val,BASE10_64_DIGIT_BITS);
+            _mm512_storeu_si512(dest+BASE10_64_LANES*j,_mm512_and_si512(val,mask));
+        }
+        __m512i top = _mm512_add_epi64(_mm512_loadu_si512(result+BASE10_64_LANES*digits),borrow);
+        __mmask8 keep = _mm512_cmplt_epi64_mask(top,zero);
+        for(int j=0;j<digits;j++)
+        {
+            __m512i val = _mm512_mask_blend_epi64(keep,_mm512_loadu_si512(dest+BASE10_64_LANES*j),_mm512_loadu_si512(result+BASE10_64_LANES*j));
+            _mm512_storeu_si512(dest+BASE10_64_LANES*j,val);
+        }
+    }
+
+    //Split limbs into lane digits
+    static void base10_64ToDigits(const uint64_t* src, int srcLen, uint64_t* dest, int lane, int digits)
+    {
+        for(int cnt=0;cnt<digits;cnt++)
+        {
+            int bit = BASE10_64_DIGIT_BITS*cnt;
+            uint64_t val = 0;
+            if(bit/64<srcLen)
+                val = src[bit/64]>>(bit%64);
+            if(bit%64>64-BASE10_64_DIGIT_BITS && bit/64+1<srcLen)
+                val |= src[bit/64+1]<<(64-bit%64);
+            dest[BASE10_64_LANES*cnt+lane] = val&base10_64DigitMask;
+        }
+    }
+    //Join lane digits into limbs
+    static void base10_64FromDigits(const uint64_t* src, int lane, int digits, uint64_t* dest, int destLen)
+    {
+        memset(dest,0,sizeof(uint64_t)*destLen);
+        for(int cnt=0;cnt<digits;cnt++)
+        {
+            int bit = BASE10_64_DIGIT_BITS*cnt;
+            uint64_t val = src[BASE10_64_LANES*cnt+lane];
+            if(bit/64<destLen)
+                dest[bit/64] |= val<<(bit%64);
+            if(bit%64>64-BASE10_64_DIGIT_BITS && bit/64+1<destLen)
+                dest[bit/64+1] |= val>>(64-bit%64);
+        }
+    }
+    //Bits [pos,pos+count) of an exponent
+    static uint32_t base10_64ExponentWindow(const uint32_t* src, int pos, int count, uint16_t length)
+    {
+        uint32_t ret = 0;
+        for(int cnt=count-1;cnt>=0;cnt--)
+        {
+            int bit = pos+cnt;
+            ret <<= 1;
+            if(bit>=0 && bit/32<length)
+                ret |= (src[bit/32]>>(bit%32))&1;
+        }
+        return ret;
+    }
+
+    //Eight eligible exponentiations, one per lane, with a shared fixed window
+    static int base10_64LaneExponentiation(const uint32_t* const* src1, const uint32_t* const* src2, const uint32_t* const* src3, uint32_t* const* dest, uint16_t length)
+    {
+        //Digits cover the widest modulus
+        int modBits = 0;
+        int expBits = 0;
+        for(int lane=0;lane<BASE10_64_LANES;lane++)
+        {
+            int bits = base10_64BitLength(src3[lane],length);
+            if(bits>modBits) modBits = bits;
+            bits = base10_64BitLength(src2[lane],length);
+            if(bits>expBits) expBits = bits;
+        }
+        int digits = (modBits+BASE10_64_DIGIT_BITS-1)/BASE10_64_DIGIT_BITS;
+        if(digits>1024)
+        {
+            //Unnormalized digits would overflow, this is well beyond any key size
+            int ret = 1;
+            for(int lane=0;lane<BASE10_64_LANES;lane++)
+            {
+                if(!base10_64ModuloExponentiation(src1[lane],src2[lane],src3[lane],dest[lane],length))
+                    ret = 0;
+            }
+            return ret;
+        }
+        int limbs = (length+1)/2;
+        int window = 1;
+        if(expBits>256) window = 5;
+        else if(expBits>64) window = 4;
+        else if(expBits>20) window = 3;
+        int tableSize = 1<<window;
+
+        //Lane vectors are digits*BASE10_64_LANES uint64_t
+        int vecLen = BASE10_64_LANES*digits;
+        int wideLen = (2*BASE10_64_DIGIT_BITS*digits)/64+1;
+        uint32_t* storage = numberWorkspacePush(2*((tableSize+6)*vecLen+BASE10_64_LANES*(2*digits+2)+wideLen+3*limbs));
+        if(!storage) return 0;
+        uint64_t* table = (uint64_t*) storage;
+        uint64_t* modulus = table+tableSize*vecLen;
+        uint64_t* rSquared = modulus+vecLen;
+        uint64_t* base = rSquared+vecLen;
+        uint64_t* acc = base+vecLen;
+        uint64_t* temp = acc+vecLen;
+        uint64_t* one = temp+vecLen;
+        uint64_t* scratch = one+vecLen;
+        uint64_t* k0 = scratch+BASE10_64_LANES*(2*digits+1);
+        uint64_t* wide = k0+BASE10_64_LANES;
+        uint64_t* packedMod = wide+wideLen;
+        uint64_t* packedSrc = packedMod+limbs;
+        uint64_t* rem = packedSrc+limbs;
+
+        int ret = 1;
+        memset(one,0,sizeof(uint64_t)*vecLen);
+        for(int lane=0;ret && lane<BASE10_64_LANES;lane++)
+        {
+            uint16_t words = base10_64SignificantWords(src3[lane],length);
+            int modLen = (words+1)/2;
+            memset(packedMod,0,sizeof(uint64_t)*limbs);
+            base10_64Pack(src3[lane],words,packedMod);
+            base10_64ToDigits(packedMod,modLen,modulus,lane,digits);
+
+            //-m^-1 mod 2^52
+            uint64_t inv = packedMod[0];
+            for(int cnt=0;cnt<5;cnt++)
+                inv *= 2-packedMod[0]*inv;
+            k0[lane] = ((uint64_t) 0-inv)&base10_64DigitMask;
+
+            //R^2 mod m where R=2^(52*digits)
+            memset(wide,0,sizeof(uint64_t)*wideLen);
+            wide[(2*BASE10_64_DIGIT_BITS*digits)/64] = ((uint64_t) 1)<<((2*BASE10_64_DIGIT_BITS*digits)%64);
+            ret = base10_64DivModLimbs(wide,wideLen,packedMod,modLen,NULL,rem);
+            base10_64ToDigits(rem,modLen,rSquared,lane,digits);
+
+            //Reduced base
+            uint16_t words1 = base10_64SignificantWords(src1[lane],length);
+            int len1 = (words1+1)/2;
+            memset(packedSrc,0,sizeof(uint64_t)*limbs);
+            base10_64Pack(src1[lane],words1,packedSrc);
+            if(len1<modLen) len1 = modLen;
+            ret = ret && base10_64DivModLimbs(packedSrc,len1,packedMod,modLen,NULL,rem);
+            base10_64ToDigits(rem,modLen,base,lane,digits);
+            one[lane] = 1;
+        }
+
+        if(!ret)
+        {
+            numberWorkspacePop(storage);
+            return 0;
+        }
+
+        //Table of base^k in Montgomery form, table[0] is R mod m
+        base10_64LaneProduct(rSquared,one,modulus,k0,table,scratch,digits);
+        base10_64LaneProduct(base,rSquared,modulus,k0,table+vecLen,scratch,digits);
+        for(int cnt=2;cnt<tableSize;cnt++)
+            base10_64LaneProduct(table+(cnt-1)*vecLen,table+vecLen,modulus,k0,table+cnt*vecLen,scratch,digits);
+
+        //Fixed windows keep every lane on the same sequence of products
+        int windows = (expBits+window-1)/window;
+        uint32_t index[BASE10_64_LANES];
+        for(int win=windows-1;win>=0;win--)
+        {
+            int any = 0;
+            for(int lane=0;lane<BASE10_64_LANES;lane++)
+            {
+                index[lane] = base10_64ExponentWindow(src2[lane],win*window,window,length);
+                if(index[lane]) any = 1;
+            }
+            if(win<windows-1)
+            {
+                for(int cnt=0;cnt<window;cnt++)
+                    base10_64LaneProduct(acc,acc,modulus,k0,acc,scratch,digits);
+                if(!any) continue;
+            }
+
+            //Each lane selects its own table entry
+            uint64_t* target = win<windows-1 ? temp : acc;
+            for(int j=0;j<digits;j++)
+            {
+                for(int lane=0;lane<BASE10_64_LANES;lane++)
+                    target[BASE10_64_LANES*j+lane] = table[index[lane]*vecLen+BASE10_64_LANES*j+lane];
+            }
+            if(target==temp)
+                base10_64LaneProduct(acc,temp,modulus,k0,acc,scratch,digits);
+        }
+
+        //Out of Montgomery form
+        base10_64LaneProduct(acc,one,modulus,k0,acc,scratch,digits);
+        for(int lane=0;lane<BASE10_64_LANES;lane++)
+        {
+            base10_64FromDigits(acc,lane,digits,rem,limbs);
+            if(!base10_64Unpack(rem,limbs,dest[lane],length))
+                ret = 0;
+        }
+        numberWorkspacePop(storage);
+        return ret;
+    }
+#endif
+
+    //Batched modulo exponentiation
+    int base10_64BatchModuloExponentiation(const uint32_t* const* src1, const uint32_t* const* src2, const uint32_t* const* src3, uint32_t* const* dest, uint16_t count, uint16_t length)
+    {
+        if(length<=0) return 0;
+        int ret = 1;
+
+#ifdef BASE10_64_IFMA
+        if(base10_64BatchWidth()==BASE10_64_LANES)
+        {
+            const uint32_t* lane1[BASE10_64_LANES];
+            const uint32_t* lane2[BASE10_64_LANES];
+            const uint32_t* lane3[BASE10_64_LANES];
+            uint32_t* laneDest[BASE10_64_LANES];
+            uint32_t* spare = NULL;
+            int lanes = 0;
+
+            //Gather eligible entries into full sets of lanes
+            for(int cnt=0;cnt<count;cnt++)
+            {
+                if(!base10_64LaneEligible(src1[cnt],src2[cnt],src3[cnt],length))
+                {
+                    if(!base10_64ModuloExponentiation(src1[cnt],src2[cnt],src3[cnt],dest[cnt],length))
+                        ret = 0;
+                    continue;
+                }
+                lane1[lanes] = src1[cnt];
+                lane2[lanes] = src2[cnt];
+                lane3[lanes] = src3[cnt];
+                laneDest[lanes] = dest[cnt];
+                lanes++;
+                if(lanes<BASE10_64_LANES) continue;
+                if(!base10_64LaneExponentiation(lane1,lane2,lane3,laneDest,length))
+                    ret = 0;
+                lanes = 0;
+            }
+
+            //Eight lanes cost about three scalar exponentiations, so pad a set of three or more
+            if(lanes>=3 && (spare = numberWorkspacePush(length)))
+            {
+                for(int cnt=lanes;cnt<BASE10_64_LANES;cnt++)
+                {
+                    lane1[cnt] = lane1[0];
+                    lane2[cnt] = lane2[0];
+                    lane3[cnt] = lane3[0];
+                    laneDest[cnt] = spare;
+                }
+                if(!base10_64LaneExponentiation(lane1,lane2,lane3,laneDest,length))
+                    ret = 0;
+                lanes = 0;
+            }
+
+            //Short sets run on the scalar kernel
+            for(int cnt=0;cnt<lanes;cnt++)
+            {
+                if(!base10_64ModuloExponentiation(lane1[cnt],lane2[cnt],lane3[cnt],laneDest[cnt],length))
+                    ret = 0;
+            }
+            if(spare) numberWorkspacePop(spare);
+            return ret;
+        }
+#endif
+
+        for(int cnt=0;cnt<count;cnt++)
+        {
+            if(!base10_64ModuloExponentiation(src1[cnt],src2[cnt],src3[cnt],dest[cnt],length))
+                ret = 0;
+        }
+        return ret;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
+///@endcond
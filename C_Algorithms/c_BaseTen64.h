@@ -0,0 +1,313 @@
+/**
+ * Contains functions which
+ * define a base-10 integer
+ * processed in 64-bit limbs.
+ * These functions are bound
+ * to a number type.
+ *
+ */
+
+#ifndef C_BASE_TEN_64_H
+#define C_BASE_TEN_64_H
+
+#include "c_BaseTen.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	/** @brief Construct a 64-bit limb base-10 number
+     *
+     * This function will return a numberType
+     * pointer defining the function pointers
+     * for a base-10 number whose kernels treat
+     * each pair of uint32_t as one 64-bit limb
+     * with 128-bit intermediates.  Arrays keep
+     * the uint32_t layout of a base-10 number,
+     * so the type ID is crypto_numbertype_base10
+     * and the two types may be mixed freely.
+     * Linear-time operations are shared with
+     * the base-10 type.  Note that the resulting
+     * pointer points to a structure which is static
+     * to the c_BaseTen64.c file.
+     *
+     * @return Pointer to numberType of type base-10, 64-bit limbs
+     */
+    struct numberType* buildBaseTen64Type();
+
+    /** @brief Fastest kernel tier on this host
+     *
+     * Reads CPUID and reports crypto_kerneltier_adx
+     * if the processor supports both BMI2 and ADX,
+     * otherwise crypto_kerneltier_portable.
+     *
+     * @return Fastest supported kernel tier
+     */
+    int base10_64HostKernelTier();
+    /** @brief Installed kernel tier
+     *
+     * The multiply-accumulate kernel behind
+     * multiplication, square and Montgomery
+     * reduction is chosen once at startup from
+     * base10_64HostKernelTier().
+     *
+     * @return Kernel tier currently in use
+     */
+    int base10_64KernelTier();
+    /** @brief Install a kernel tier
+     *
+     * Replaces the multiply-accumulate kernel
+     * used by every 64-bit limb function.  Intended
+     * for differential testing against the portable
+     * tier.  Each kernel call reads the tier once, so
+     * a call already running on another thread keeps
+     * the tier it started with.
+     *
+     * @param [in] tier crypto_kerneltier_portable or crypto_kerneltier_adx
+     * @return 1 if success, 0 if the host does not support the tier
+     */
+    int base10_64SetKernelTier(int tier);
+
+    /** @brief 64-bit limb multiplication
+     *
+     * This function takes in two arrays which
+     * represent base-10 numbers, preforms src1*src2
+     * on the pair and then output the result to
+     * dest.  Note that all three arrays must
+     * be the same size.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10_64Multiplication(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief 64-bit limb sized multiplication
+     *
+     * Preforms src1*src2 where each argument
+     * has its own length.  Only the significant
+     * words are packed and multiplied.  dest may
+     * be either argument.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] len1 Number of uint32_t in src1
+     * @param [in] src2 Argument 2
+     * @param [in] len2 Number of uint32_t in src2
+     * @param [out] dest Output
+     * @param [in] destLen Number of uint32_t in dest
+     * @return 1 if success, 0 if the product does not fit
+     */
+    int base10_64SizedMultiplication(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2, uint32_t* dest, uint16_t destLen);
+    /** @brief 64-bit limb square
+     *
+     * This function takes in an array which
+     * represents a base-10 number, preforms src1*src1
+     * and then outputs the result to dest.  Note
+     * that both arrays must be the same size.
+     *
+     * @param [in] src1 Argument 1
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10_64Square(const uint32_t* src1, uint32_t* dest, uint16_t length);
+    /** @brief 64-bit limb sized square
+     *
+     * Preforms src1*src1 where the argument
+     * and the output have their own lengths.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] len1 Number of uint32_t in src1
+     * @param [out] dest Output
+     * @param [in] destLen Number of uint32_t in dest
+     * @return 1 if success, 0 if the square does not fit
+     */
+    int base10_64SizedSquare(const uint32_t* src1, uint16_t len1, uint32_t* dest, uint16_t destLen);
+    /** @brief 64-bit limb division
+     *
+     * This function takes in two arrays which
+     * represent base-10 numbers, preforms src1/src2
+     * on the pair and then output the result to
+     * dest.  Note that all three arrays must
+     * be the same size.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10_64Division(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief 64-bit limb modulo
+     *
+     * This function takes in two arrays which
+     * represent base-10 numbers, preforms src1%src2
+     * on the pair and then output the result to
+     * dest.  Note that all three arrays must
+     * be the same size.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10_64Modulo(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief 64-bit limb division with remainder
+     *
+     * Knuth's algorithm D over 64-bit limbs.
+     * Either output may be NULL.  Note that
+     * all four arrays must be the same size.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] quot Quotient
+     * @param [out] rem Remainder
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10_64DivMod(const uint32_t* src1, const uint32_t* src2, uint32_t* quot, uint32_t* rem, uint16_t length);
+    /** @brief 64-bit limb exponentiation
+     *
+     * This function takes in two arrays which
+     * represent base-10 numbers, preforms src1^src2
+     * on the pair and then output the result to
+     * dest.  Note that all three arrays must
+     * be the same size.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] src2 Argument 2
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10_64Exponentiation(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+
+    /** @brief 64-bit limb Montgomery reduction context
+     *
+     * Holds the pre-computed values required
+     * to preform Montgomery multiplication in
+     * 64-bit limbs against a single odd modulus.
+     * Built by base10_64MontgomeryInit and
+     * released by base10_64MontgomeryFree.
+     */
+    struct montgomeryContext64
+    {
+        /** @brief Significant uint64_t in the modulus */
+        uint16_t length;
+        /** @brief -modulus^-1 mod 2^64 */
+        uint64_t nPrime;
+        /** @brief Modulus, length uint64_t */
+        uint64_t* modulus;
+        /** @brief R^2 mod modulus, length uint64_t */
+        uint64_t* rSquared;
+    };
+
+    /** @brief Build a 64-bit limb Montgomery context
+     *
+     * Pre-computes the values needed to preform
+     * Montgomery multiplication modulo src.
+     * The context must be released with
+     * base10_64MontgomeryFree.
+     *
+     * @param [out] ctx Context to be built
+     * @param [in] src Modulus
+     * @param [in] length Number of uint32_t in src
+     * @return 1 if success, 0 if the modulus is even or zero
+     */
+    int base10_64MontgomeryInit(struct montgomeryContext64* ctx, const uint32_t* src, uint16_t length);
+    /** @brief Release a 64-bit limb Montgomery context
+     *
+     * @param [in/out] ctx Context to be released
+     * @return void
+     */
+    void base10_64MontgomeryFree(struct montgomeryContext64* ctx);
+    /** @brief 64-bit limb Montgomery modulo exponentiation
+     *
+     * Preforms src1^src2 mod n, where n is
+     * the context modulus.  The context may be
+     * re-used for any number of exponentiations.
+     *
+     * @param [in] ctx Montgomery context
+     * @param [in] src1 Base
+     * @param [in] src2 Exponent
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays, the modulus must fit
+     * @return 1 if success, 0 if failed
+     */
+    int base10_64MontgomeryExponentiation(const struct montgomeryContext64* ctx, const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t length);
+    /** @brief 64-bit limb modulo exponentiation
+     *
+     * Preforms src1^src2 mod src3.  Odd moduli
+     * run a 64-bit limb Montgomery ladder under
+     * the same conditions as base10ModuloExponentiation,
+     * every other case is handed to that function.
+     *
+     * @param [in] src1 Base
+     * @param [in] src2 Exponent
+     * @param [in] src3 Modulus
+     * @param [out] dest Output
+     * @param [in] length Number of uint32_t in the arrays
+     * @return 1 if success, 0 if failed
+     */
+    int base10_64ModuloExponentiation(const uint32_t* src1, const uint32_t* src2, const uint32_t* src3, uint32_t* dest, uint16_t length);
+
+    /** @brief Widest batch on this host
+     *
+     * Reads CPUID and reports 8 if the processor
+     * supports AVX-512F and AVX-512 IFMA, otherwise 1.
+     *
+     * @return Lanes supported by base10_64BatchModuloExponentiation
+     */
+    int base10_64HostBatchWidth();
+    /** @brief Installed batch width
+     *
+     * Chosen once at startup from
+     * base10_64HostBatchWidth().  A width
+     * of 1 runs every entry of a batch on
+     * base10_64ModuloExponentiation.
+     *
+     * @return Lanes used by base10_64BatchModuloExponentiation
+     */
+    int base10_64BatchWidth();
+    /** @brief Install a batch width
+     *
+     * Intended for differential testing against
+     * the scalar path.  Each batch reads the width
+     * once, so a batch already running on another
+     * thread keeps the width it started with.
+     *
+     * @param [in] width 1 or 8
+     * @return 1 if success, 0 if the host does not support the width
+     */
+    int base10_64SetBatchWidth(int width);
+    /** @brief Batched modulo exponentiation
+     *
+     * Preforms src1[i]^src2[i] mod src3[i] for
+     * every i below count.  Entries which would
+     * run the Montgomery ladder in
+     * base10_64ModuloExponentiation are packed
+     * eight at a time into AVX-512 IFMA lanes of
+     * 52-bit digits, with a fixed window shared
+     * by the lanes.  Every other entry, and every
+     * entry when the batch width is 1, runs on
+     * base10_64ModuloExponentiation.  Results
+     * match that function exactly.  Destinations
+     * must not overlap any source of another entry.
+     *
+     * @param [in] src1 Bases
+     * @param [in] src2 Exponents
+     * @param [in] src3 Moduli
+     * @param [out] dest Outputs
+     * @param [in] count Number of entries
+     * @param [in] length Number of uint32_t in every array
+     * @return 1 if every entry succeeded, 0 if any failed
+     */
+    int base10_64BatchModuloExponentiation(const uint32_t* const* src1, const uint32_t* const* src2, const uint32_t* const* src3, uint32_t* const* dest, uint16_t count, uint16_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
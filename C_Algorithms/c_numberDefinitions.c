@@ -20,8 +20,19 @@ extern "C" {
     const int crypto_numbertype_default=0;
 	const int crypto_numbertype_base10=1;
 
+	const int crypto_kerneltier_portable=0;
+	const int crypto_kerneltier_adx=1;
+
+	const int crypto_primesieve_limit=32768;
+
+	const int crypto_primetest_millerrabin=0;
+	const int crypto_primetest_bpsw=1;
+
+	const int crypto_limbpool_cache=262144;
+
 	const char* crypto_numbername_default="NULL Type";
 	const char* crypto_numbername_base10="Base 10 Type";
+	const char* crypto_numbername_base10_64="Base 10 Type (64-bit)";
 
     static bool nullInit = false;
     static struct numberType _nullType;
@@ -43,8 +54,10 @@ extern "C" {
         _nullType.leftShift = NULL;
 
         _nullType.multiplication = NULL;
+        _nullType.square = NULL;
         _nullType.division = NULL;
 		_nullType.modulo = NULL;
+		_nullType.divmod = NULL;
 
 		_nullType.exponentiation = NULL;
 		_nullType.moduloExponentiation = NULL;
@@ -52,9 +65,260 @@ extern "C" {
 		_nullType.gcd = NULL;
 		_nullType.modInverse = NULL;
 
+        _nullType.sizedCompare = NULL;
+        _nullType.sizedAddition = NULL;
+        _nullType.sizedSubtraction = NULL;
+        _nullType.sizedRightShift = NULL;
+        _nullType.sizedLeftShift = NULL;
+        _nullType.sizedMultiplication = NULL;
+        _nullType.sizedSquare = NULL;
+
         nullInit = true;
         return &_nullType;
     }
+#ifdef __cplusplus
+    //Releases the default workspace when its thread exits
+    struct numberWorkspaceHolder
+    {
+        struct numberWorkspace workspace;
+        ~numberWorkspaceHolder(){numberWorkspaceFree(&workspace);}
+    };
+    static thread_local struct numberWorkspaceHolder _threadWorkspace;
+    static thread_local struct numberWorkspace* _boundWorkspace = NULL;
+    static thread_local uint32_t _workspaceAllocations = 0;
+    #define THREAD_WORKSPACE (_threadWorkspace.workspace)
+#else
+    static _Thread_local struct numberWorkspace _threadWorkspace;
+    static _Thread_local struct numberWorkspace* _boundWorkspace = NULL;
+    static _Thread_local uint32_t _workspaceAllocations = 0;
+    #define THREAD_WORKSPACE _threadWorkspace
+#endif
+
+    //Limb pool size classes run from 256 to 65536 uint32_t, a number holds up to 128 inline
+    #define LIMB_POOL_CLASSES 9
+    #define LIMB_POOL_UNCACHED 0xFFFFFFFF
+    struct numberLimbPool
+    {
+        uint32_t* blocks[LIMB_POOL_CLASSES];
+        struct numberLimbPoolStats stats;
+    };
+#ifdef __cplusplus
+    //Returns the cached limb storage when its thread exits
+    struct numberLimbPoolHolder
+    {
+        struct numberLimbPool pool;
+        ~numberLimbPoolHolder();
+    };
+    static thread_local struct numberLimbPoolHolder _threadLimbPool;
+    static thread_local int _limbPoolClosed = 0;
+    numberLimbPoolHolder::~numberLimbPoolHolder()
+    {
+        numberLimbPoolTrim();
+        _limbPoolClosed = 1;
+    }
+    #define THREAD_LIMB_POOL (_threadLimbPool.pool)
+#else
+    static _Thread_local struct numberLimbPool _threadLimbPool;
+    static _Thread_local int _limbPoolClosed = 0;
+    #define THREAD_LIMB_POOL _threadLimbPool
+#endif
+
+    //Build a workspace
+    int numberWorkspaceInit(struct numberWorkspace* ws, uint32_t size)
+    {
+        memset(ws,0,sizeof(struct numberWorkspace));
+        if(size==0) return 1;
+        ws->buffer = (uint32_t*) malloc(size*sizeof(uint32_t));
+        if(!ws->buffer) return 0;
+        ws->size = size;
+        return 1;
+    }
+    //Release a workspace
+    void numberWorkspaceFree(struct numberWorkspace* ws)
+    {
+        if(ws->buffer) free(ws->buffer);
+        memset(ws,0,sizeof(struct numberWorkspace));
+    }
+    //Bind a workspace to this thread
+    struct numberWorkspace* bindNumberWorkspace(struct numberWorkspace* ws)
+    {
+        struct numberWorkspace* ret = _boundWorkspace;
+        _boundWorkspace = ws;
+        return ret;
+    }
+    //Replace the default workspace buffer, only while nothing is in use
+    static int numberWorkspaceGrow(struct numberWorkspace* ws, uint32_t size)
+    {
+        if(ws->used || ws->spilled) return 0;
+        if(size<=ws->size) return 1;
+        uint32_t* buffer = (uint32_t*) malloc(size*sizeof(uint32_t));
+        if(!buffer) return 0;
+        _workspaceAllocations++;
+        if(ws->buffer) free(ws->buffer);
+        ws->buffer = buffer;
+        ws->size = size;
+        return 1;
+    }
+    //Reserve the default workspace
+    int numberWorkspaceReserve(uint32_t size)
+    {
+        return numberWorkspaceGrow(&THREAD_WORKSPACE,size);
+    }
+    //Workspace heap allocations on this thread
+    uint32_t numberWorkspaceAllocations()
+    {
+        return _workspaceAllocations;
+    }
+    //Take scratch space
+    uint32_t* numberWorkspacePush(uint32_t size)
+    {
+        struct numberWorkspace* ws = _boundWorkspace ? _boundWorkspace : &THREAD_WORKSPACE;
+
+        //Even sizes keep every block aligned for uint64_t
+        if(size==0) size=1;
+        size = (size+1)&~((uint32_t)1);
+        if(ws->used+ws->spilled+size>ws->peak)
+            ws->peak = ws->used+ws->spilled+size;
+
+        if(ws->used+size<=ws->size)
+        {
+            uint32_t* ret = ws->buffer+ws->used;
+            ws->used += size;
+            return ret;
+        }
+
+        //Spill to the heap, the size is kept in the two uint32_t in front of the block
+        _workspaceAllocations++;
+        uint32_t* ret = (uint32_t*) malloc((size+2)*sizeof(uint32_t));
+        if(!ret) return NULL;
+        ret[0] = size;
+        ws->spilled += size;
+        return ret+2;
+    }
+    //Return scratch space
+    void numberWorkspacePop(uint32_t* ptr)
+    {
+        if(!ptr) return;
+        struct numberWorkspace* ws = _boundWorkspace ? _boundWorkspace : &THREAD_WORKSPACE;
+        if(ws->buffer && ptr>=ws->buffer && ptr<ws->buffer+ws->size)
+            ws->used = (uint32_t) (ptr-ws->buffer);
+        else
+        {
+            ws->spilled -= ptr[-2];
+            free(ptr-2);
+        }
+
+        //The default workspace grows to the largest demand once idle
+        if(ws==&THREAD_WORKSPACE && ws->peak>ws->size)
+            numberWorkspaceGrow(ws,ws->peak);
+    }
+
+    //Take limb storage, the class and capacity are kept in the two uint32_t in front of the block
+    uint32_t* numberLimbAlloc(uint32_t size, uint32_t* capacity)
+    {
+        uint32_t cls = 0;
+        uint32_t cap = 256;
+        while(cap<size && cls<LIMB_POOL_CLASSES)
+        {
+            cls++;
+            cap<<=1;
+        }
+        if(cls==LIMB_POOL_CLASSES)
+        {
+            cls = LIMB_POOL_UNCACHED;
+            cap = size;
+        }
+        if(capacity) *capacity = cap;
+
+        //Storage outlived the thread's pool
+        if(_limbPoolClosed)
+        {
+            uint32_t* ret = (uint32_t*) malloc((cap+2)*sizeof(uint32_t));
+            if(!ret) return NULL;
+            ret[0] = LIMB_POOL_UNCACHED;
+            ret[1] = cap;
+            return ret+2;
+        }
+
+        struct numberLimbPool* pool = &THREAD_LIMB_POOL;
+        uint32_t* ret;
+        if(cls!=LIMB_POOL_UNCACHED && pool->blocks[cls])
+        {
+            ret = pool->blocks[cls];
+            memcpy(&pool->blocks[cls],ret,sizeof(uint32_t*));
+            pool->stats.cachedBytes -= cap*sizeof(uint32_t);
+        }
+        else
+        {
+            ret = (uint32_t*) malloc((cap+2)*sizeof(uint32_t));
+            if(!ret) return NULL;
+            ret[0] = cls;
+            ret[1] = cap;
+            ret += 2;
+            pool->stats.heapAllocations++;
+        }
+
+        pool->stats.allocations++;
+        pool->stats.bytes += cap*sizeof(uint32_t);
+        if(pool->stats.bytes>pool->stats.peakBytes)
+            pool->stats.peakBytes = pool->stats.bytes;
+        return ret;
+    }
+    //Return limb storage, blocks are chained through their first uint32_t
+    void numberLimbFree(uint32_t* ptr)
+    {
+        if(!ptr) return;
+        uint32_t cls = ptr[-2];
+        uint64_t bytes = ((uint64_t) ptr[-1])*sizeof(uint32_t);
+        if(_limbPoolClosed)
+        {
+            free(ptr-2);
+            return;
+        }
+
+        //A block taken on another thread stays in that thread's bytes, this thread's bytes stop at zero
+        struct numberLimbPool* pool = &THREAD_LIMB_POOL;
+        if(pool->stats.bytes>=bytes) pool->stats.bytes -= bytes;
+        else pool->stats.bytes = 0;
+
+        if(cls==LIMB_POOL_UNCACHED ||
+            pool->stats.cachedBytes+bytes>((uint64_t) crypto_limbpool_cache)*sizeof(uint32_t))
+        {
+            free(ptr-2);
+            return;
+        }
+        memcpy(ptr,&pool->blocks[cls],sizeof(uint32_t*));
+        pool->blocks[cls] = ptr;
+        pool->stats.cachedBytes += bytes;
+    }
+    //Limb pool statistics for this thread
+    struct numberLimbPoolStats numberLimbPoolStatistics()
+    {
+        if(_limbPoolClosed)
+        {
+            struct numberLimbPoolStats ret;
+            memset(&ret,0,sizeof(struct numberLimbPoolStats));
+            return ret;
+        }
+        return THREAD_LIMB_POOL.stats;
+    }
+    //Return cached limb storage to the heap
+    void numberLimbPoolTrim()
+    {
+        if(_limbPoolClosed) return;
+        struct numberLimbPool* pool = &THREAD_LIMB_POOL;
+        for(int cls=0;cls<LIMB_POOL_CLASSES;cls++)
+        {
+            while(pool->blocks[cls])
+            {
+                uint32_t* ptr = pool->blocks[cls];
+                memcpy(&pool->blocks[cls],ptr,sizeof(uint32_t*));
+                free(ptr-2);
+            }
+        }
+        pool->stats.cachedBytes = 0;
+    }
+
     //Standard compare function
     int standardCompare(const uint32_t* src1, const uint32_t* src2, uint16_t length)
     {
@@ -72,34 +336,26 @@ extern "C" {
     {
 		if(length<=0) return 0;
 
-		uint32_t* targ = (uint32_t*) malloc(length*sizeof(uint32_t));
         uint16_t bigShift=src2/32;
         uint16_t smallShift=src2%32;
-
-        //Set to zero
-        int cnt=0;
-        for(cnt=0;cnt<length;cnt++)
-            targ[cnt]=0;
         if(bigShift>=length)
 		{
-			for(int cnt=0;cnt<length;cnt++)
-			dest[cnt]=targ[cnt];
-			free(targ);
+			memset((void*) dest,0,sizeof(uint32_t)*length);
             return 1;
 		}
 
-        uint32_t carry=src1[bigShift]>>smallShift;
-        for(cnt=bigShift+1;cnt<length;cnt++)
+        //Ascending order reads ahead of the write, so dest may be src1
+        int cnt=0;
+        for(cnt=0;cnt+bigShift+1<length;cnt++)
         {
             if(smallShift>0)
-                targ[cnt-bigShift-1]=carry|src1[cnt]<<(32-smallShift);
+                dest[cnt]=(src1[cnt+bigShift]>>smallShift)|(src1[cnt+bigShift+1]<<(32-smallShift));
             else
-                targ[cnt-bigShift-1]=carry;
-            carry=src1[cnt]>>smallShift;
+                dest[cnt]=src1[cnt+bigShift];
         }
-		for(int cnt=0;cnt<length;cnt++)
-			dest[cnt]=targ[cnt];
-		free(targ);
+        dest[cnt]=src1[cnt+bigShift]>>smallShift;
+        for(cnt++;cnt<length;cnt++)
+            dest[cnt]=0;
         return 1;
     }
     //Standard left shift function
@@ -107,39 +363,125 @@ extern "C" {
     {
         if(length<=0) return 0;
 
-        //Set to zero
-		uint32_t* targ = (uint32_t*) malloc(length*sizeof(uint32_t));
+        uint32_t bigShift=src2/32;
+        uint16_t smallShift=src2%32;
+
+        //Check for bits shifted out before dest is written
+        int ret=1;
         int cnt=0;
-        for(cnt=0;cnt<length;cnt++)
-            targ[cnt]=0;
+        for(cnt=(bigShift<length ? length-bigShift : 0);cnt<length;cnt++)
+        {
+            if(src1[cnt]>0)
+                ret=0;
+        }
+        if(bigShift>=length)
+        {
+            memset((void*) dest,0,sizeof(uint32_t)*length);
+            return ret;
+        }
+        if(smallShift>0 && (src1[length-bigShift-1]>>(32-smallShift))>0)
+            ret=0;
 
+        //Descending order reads behind the write, so dest may be src1
+        for(cnt=length-1;cnt>(int)bigShift;cnt--)
+        {
+            if(smallShift>0)
+                dest[cnt]=(src1[cnt-bigShift]<<smallShift)|(src1[cnt-bigShift-1]>>(32-smallShift));
+            else
+                dest[cnt]=src1[cnt-bigShift];
+        }
+        dest[bigShift]=src1[0]<<smallShift;
+        for(cnt=0;cnt<(int)bigShift;cnt++)
+            dest[cnt]=0;
+        return ret;
+    }
+    //Significant length (limbs below the highest non-zero limb)
+    static uint16_t standardSignificantLength(const uint32_t* src, uint16_t length)
+    {
+        while(length>0 && src[length-1]==0)
+            length--;
+        return length;
+    }
+    //Sized compare function
+    int standardSizedCompare(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2)
+    {
+        len1 = standardSignificantLength(src1,len1);
+        len2 = standardSignificantLength(src2,len2);
+        if(len1!=len2) return len1>len2 ? 1 : -1;
+        return standardCompare(src1,src2,len1);
+    }
+    //Sized right shift function
+    int standardSizedRightShift(const uint32_t* src1, uint16_t len1, uint16_t src2, uint32_t* dest, uint16_t destLen)
+    {
+        if(destLen<=0) return 0;
 
         uint16_t bigShift=src2/32;
         uint16_t smallShift=src2%32;
-        uint32_t oldVal = 0;
+        int len=standardSignificantLength(src1,len1);
 
-        for(cnt=0;cnt+bigShift<length;cnt++)
+        //Exact output width, limbs past dest must be zero
+        int outLen=len>bigShift ? len-bigShift : 0;
+        if(outLen>0 && (src1[len-1]>>smallShift)==0)
+            outLen--;
+        int ret=1;
+        if(outLen>destLen)
         {
-            if(smallShift>0)
-            {
-                targ[cnt+bigShift]=oldVal | (src1[cnt]<<smallShift);
-                oldVal = src1[cnt]>>(32-smallShift);
-            }
-            else
-                targ[cnt+bigShift]=src1[cnt];
+            outLen=destLen;
+            ret=0;
         }
 
-		for(int cnt=0;cnt<length;cnt++)
-			dest[cnt]=targ[cnt];
-		free(targ);
-        if(oldVal>0) return 0;
+        //Ascending order reads ahead of the write, so dest may be src1
+        int cnt=0;
+        for(cnt=0;cnt<outLen;cnt++)
+        {
+            dest[cnt]=src1[cnt+bigShift]>>smallShift;
+            if(smallShift>0 && cnt+bigShift+1<len)
+                dest[cnt]|=src1[cnt+bigShift+1]<<(32-smallShift);
+        }
+        for(;cnt<destLen;cnt++)
+            dest[cnt]=0;
+        return ret;
+    }
+    //Sized left shift function
+    int standardSizedLeftShift(const uint32_t* src1, uint16_t len1, uint16_t src2, uint32_t* dest, uint16_t destLen)
+    {
+        if(destLen<=0) return 0;
 
-        for(;cnt<length;cnt++)
+        int bigShift=src2/32;
+        uint16_t smallShift=src2%32;
+        int len=standardSignificantLength(src1,len1);
+        if(len==0)
         {
-            if(src1[cnt]>0)
-                return 0;
+            memset((void*) dest,0,sizeof(uint32_t)*destLen);
+            return 1;
         }
-        return 1;
+
+        //Exact output width, limbs past dest must be zero
+        int outLen=len+bigShift;
+        if(smallShift>0 && (src1[len-1]>>(32-smallShift))>0)
+            outLen++;
+        int ret=1;
+        if(outLen>destLen)
+        {
+            outLen=destLen;
+            ret=0;
+        }
+
+        //Descending order reads behind the write, so dest may be src1
+        for(int cnt=destLen-1;cnt>=outLen;cnt--)
+            dest[cnt]=0;
+        for(int cnt=outLen-1;cnt>=bigShift;cnt--)
+        {
+            uint32_t t=0;
+            if(cnt-bigShift<len)
+                t=src1[cnt-bigShift]<<smallShift;
+            if(smallShift>0 && cnt-bigShift>0)
+                t|=src1[cnt-bigShift-1]>>(32-smallShift);
+            dest[cnt]=t;
+        }
+        for(int cnt=0;cnt<bigShift && cnt<destLen;cnt++)
+            dest[cnt]=0;
+        return ret;
     }
 
 #ifdef __cplusplus
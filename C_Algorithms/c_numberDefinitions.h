@@ -50,6 +50,35 @@ extern "C" {
      * @return 1 if success, 0 if failed
      */
 	typedef int (*tripleCalculation)(const uint32_t*,const uint32_t*,const uint32_t*,uint32_t*,uint16_t);
+    /** @brief Division with remainder function typedef
+     *
+     * This function typedef defines a function
+     * which takes in two arrays which represent
+     * numbers, divides the first by the second
+     * and outputs both the quotient and the
+     * remainder.  Either output may be NULL.
+     *
+     * @param [in] uint32_t* Argument 1
+     * @param [in] uint32_t* Argument 2
+     * @param [out] uint32_t* Quotient
+     * @param [out] uint32_t* Remainder
+     * @param [in] uint16_t size
+     * @return 1 if success, 0 if failed
+     */
+    typedef int (*divmodFunction)(const uint32_t*,const uint32_t*,uint32_t*,uint32_t*,uint16_t);
+    /** @brief Square function typedef
+     *
+     * This function typedef defines a function
+     * which takes in an array representing a
+     * number, multiplies it by itself and
+     * outputs the result into the second array.
+     *
+     * @param [in] uint32_t* Argument 1
+     * @param [out] uint32_t* Output
+     * @param [in] uint16_t size
+     * @return 1 if success, 0 if failed
+     */
+    typedef int (*squareFunction)(const uint32_t*,uint32_t*,uint16_t);
     /** @brief Shift operator function typedef
      *
      * This function typedef defines a function
@@ -77,6 +106,59 @@ extern "C" {
      * @return -1 if 1<2, 0 if 1==2, 1 if 1>2
      */
     typedef int (*compareFunction)(const uint32_t*,const uint32_t*,uint16_t);
+    /** @brief Sized operator function typedef
+     *
+     * As operatorFunction, but each argument
+     * carries its own length.  Zero high limbs
+     * are skipped and dest is written out to its
+     * own length.
+     *
+     * @param [in] uint32_t* Argument 1
+     * @param [in] uint16_t Size of argument 1
+     * @param [in] uint32_t* Argument 2
+     * @param [in] uint16_t Size of argument 2
+     * @param [out] uint32_t* Output
+     * @param [in] uint16_t Size of output
+     * @return 1 if success, 0 if failed
+     */
+    typedef int (*sizedOperatorFunction)(const uint32_t*,uint16_t,const uint32_t*,uint16_t,uint32_t*,uint16_t);
+    /** @brief Sized square function typedef
+     *
+     * As squareFunction, but the argument and
+     * the output carry their own lengths.
+     *
+     * @param [in] uint32_t* Argument 1
+     * @param [in] uint16_t Size of argument 1
+     * @param [out] uint32_t* Output
+     * @param [in] uint16_t Size of output
+     * @return 1 if success, 0 if failed
+     */
+    typedef int (*sizedSquareFunction)(const uint32_t*,uint16_t,uint32_t*,uint16_t);
+    /** @brief Sized shift function typedef
+     *
+     * As shiftFunction, but the argument and
+     * the output carry their own lengths.
+     *
+     * @param [in] uint32_t* Argument 1
+     * @param [in] uint16_t Size of argument 1
+     * @param [in] uint16_t Bits to shift
+     * @param [out] uint32_t* Output
+     * @param [in] uint16_t Size of output
+     * @return 1 if success, 0 if failed
+     */
+    typedef int (*sizedShiftFunction)(const uint32_t*,uint16_t,uint16_t,uint32_t*,uint16_t);
+    /** @brief Sized comparison function typedef
+     *
+     * As compareFunction, but each argument
+     * carries its own length.
+     *
+     * @param [in] uint32_t* Argument 1
+     * @param [in] uint16_t Size of argument 1
+     * @param [in] uint32_t* Argument 2
+     * @param [in] uint16_t Size of argument 2
+     * @return -1 if 1<2, 0 if 1==2, 1 if 1>2
+     */
+    typedef int (*sizedCompareFunction)(const uint32_t*,uint16_t,const uint32_t*,uint16_t);
 
     /** @brief Number type function structure
      *
@@ -115,12 +197,18 @@ extern "C" {
         /** @brief Pointer to multiplication function
          */
         operatorFunction multiplication;
+        /** @brief Pointer to square function
+         */
+        squareFunction square;
         /** @brief Pointer to division function
          */
         operatorFunction division;
         /** @brief Pointer to modulo function
          */
 		operatorFunction modulo;
+        /** @brief Pointer to combined division and modulo function
+         */
+		divmodFunction divmod;
 
         /** @brief Pointer to exponentiation function
          */
@@ -135,8 +223,182 @@ extern "C" {
         /** @brief Pointer to modulo inverse function
          */
 		operatorFunction modInverse;
+
+        /** @brief Pointer to sized comparison function, may be NULL
+         */
+        sizedCompareFunction sizedCompare;
+        /** @brief Pointer to sized addition function, may be NULL
+         */
+        sizedOperatorFunction sizedAddition;
+        /** @brief Pointer to sized subtraction function, may be NULL
+         */
+        sizedOperatorFunction sizedSubtraction;
+        /** @brief Pointer to sized right-shift function, may be NULL
+         */
+        sizedShiftFunction sizedRightShift;
+        /** @brief Pointer to sized left-shift function, may be NULL
+         */
+        sizedShiftFunction sizedLeftShift;
+        /** @brief Pointer to sized multiplication function, may be NULL
+         */
+        sizedOperatorFunction sizedMultiplication;
+        /** @brief Pointer to sized square function, may be NULL
+         */
+        sizedSquareFunction sizedSquare;
+    };
+
+    /** @brief Scratch workspace for number kernels
+     *
+     * A stack of uint32_t which number kernels
+     * draw their temporaries from instead of
+     * the heap.  Each thread owns a default
+     * workspace which grows to the largest demand
+     * it has seen.  A caller may instead bind
+     * its own workspace to the thread with
+     * bindNumberWorkspace.  Requests which do not
+     * fit fall back to the heap.
+     */
+    struct numberWorkspace
+    {
+        /** @brief Workspace memory */
+        uint32_t* buffer;
+        /** @brief Capacity of buffer in uint32_t */
+        uint32_t size;
+        /** @brief uint32_t currently in use */
+        uint32_t used;
+        /** @brief uint32_t currently spilled to the heap */
+        uint32_t spilled;
+        /** @brief Largest demand seen, in uint32_t */
+        uint32_t peak;
     };
 
+    /** @brief Build a workspace
+     *
+     * @param [out] ws Workspace to be built
+     * @param [in] size Capacity in uint32_t
+     * @return 1 if success, 0 if failed
+     */
+    int numberWorkspaceInit(struct numberWorkspace* ws, uint32_t size);
+    /** @brief Release a workspace
+     *
+     * @param [in/out] ws Workspace to be released
+     * @return void
+     */
+    void numberWorkspaceFree(struct numberWorkspace* ws);
+    /** @brief Bind a workspace to this thread
+     *
+     * Kernels called on this thread draw from
+     * ws until another workspace is bound.
+     * Binding NULL restores the thread's
+     * default workspace.  A workspace may only
+     * be bound to one thread at a time.
+     *
+     * @param [in] ws Workspace to bind, or NULL
+     * @return Previously bound workspace, NULL for the default
+     */
+    struct numberWorkspace* bindNumberWorkspace(struct numberWorkspace* ws);
+    /** @brief Reserve the thread's default workspace
+     *
+     * Grows the default workspace so that
+     * kernels needing up to size uint32_t run
+     * without touching the heap.
+     *
+     * @param [in] size Capacity in uint32_t
+     * @return 1 if success, 0 if failed
+     */
+    int numberWorkspaceReserve(uint32_t size);
+    /** @brief Heap allocations made by the workspace on this thread
+     *
+     * Counts workspace growth and spills
+     * since the thread started.  Other heap
+     * use by the kernels is not counted.
+     *
+     * @return Number of workspace heap allocations
+     */
+    uint32_t numberWorkspaceAllocations();
+    /** @brief Take scratch space from the bound workspace
+     *
+     * Space must be returned with numberWorkspacePop
+     * in the reverse order it was taken.  The
+     * returned space is aligned for uint64_t.
+     *
+     * @param [in] size Number of uint32_t required
+     * @return Pointer to size uint32_t, NULL if a spill could not be allocated
+     */
+    uint32_t* numberWorkspacePush(uint32_t size);
+    /** @brief Return scratch space to the bound workspace
+     *
+     * Pointers must be returned in the reverse
+     * order they were taken.
+     *
+     * @param [in] ptr Pointer from numberWorkspacePush, may be NULL
+     * @return void
+     */
+    void numberWorkspacePop(uint32_t* ptr);
+
+    /** @brief Limb pool statistics
+     *
+     * Counters for the calling thread's limb
+     * pool.  Storage released on a different
+     * thread than it was taken on is counted
+     * against the releasing thread, so the
+     * taking thread's bytes and peakBytes keep
+     * it and the releasing thread's bytes are
+     * reduced, stopping at zero.  Per-thread
+     * bytes are exact only when storage is
+     * released on the thread which took it.
+     */
+    struct numberLimbPoolStats
+    {
+        /** @brief Blocks handed out */
+        uint64_t allocations;
+        /** @brief Blocks which had to come from the heap */
+        uint64_t heapAllocations;
+        /** @brief Bytes currently handed out */
+        uint64_t bytes;
+        /** @brief Largest value bytes has reached */
+        uint64_t peakBytes;
+        /** @brief Bytes held for re-use */
+        uint64_t cachedBytes;
+    };
+
+    /** @brief Take limb storage from the thread's pool
+     *
+     * Storage is grouped into power-of-two size
+     * classes from 256 to 65536 uint32_t, larger
+     * blocks are not cached.  Each thread keeps its own free
+     * blocks, so threads never contend for them
+     * and a block of a class which has been
+     * released before does not touch the heap.
+     * The returned space is aligned for uint64_t.
+     *
+     * @param [in] size Number of uint32_t required
+     * @param [out] capacity Number of uint32_t actually available, may be NULL
+     * @return Pointer to at least size uint32_t, NULL if failed
+     */
+    uint32_t* numberLimbAlloc(uint32_t size, uint32_t* capacity);
+    /** @brief Return limb storage to the thread's pool
+     *
+     * May be called from any thread.
+     *
+     * @param [in] ptr Pointer from numberLimbAlloc, may be NULL
+     * @return void
+     */
+    void numberLimbFree(uint32_t* ptr);
+    /** @brief Statistics for this thread's limb pool
+     *
+     * @return Pool statistics
+     */
+    struct numberLimbPoolStats numberLimbPoolStatistics();
+    /** @brief Release the thread's cached limb storage
+     *
+     * Returns every block held for re-use
+     * to the heap.  The statistics are kept.
+     *
+     * @return void
+     */
+    void numberLimbPoolTrim();
+
     /** @brief Construct a NULL number
      *
      * This function will return a numberType
@@ -186,6 +448,46 @@ extern "C" {
      * @return 1 if success, 0 if failed
      */
     int standardLeftShift(const uint32_t* src1, uint16_t src2, uint32_t* dest, uint16_t length);
+    /** @brief Sized comparison
+     *
+     * Compares two arrays of different
+     * lengths, ignoring zero high limbs.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] len1 Number of uint32_t in src1
+     * @param [in] src2 Argument 2
+     * @param [in] len2 Number of uint32_t in src2
+     * @return -1 if 1<2, 0 if 1==2, 1 if 1>2
+     */
+    int standardSizedCompare(const uint32_t* src1, uint16_t len1, const uint32_t* src2, uint16_t len2);
+    /** @brief Sized right shift
+     *
+     * Shifts the significant limbs of src1 in
+     * the right direction src2 number of bits.
+     * dest may be src1.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] len1 Number of uint32_t in src1
+     * @param [in] src2 Bits to shift
+     * @param [out] dest Output
+     * @param [in] destLen Number of uint32_t in dest
+     * @return 1 if success, 0 if failed
+     */
+    int standardSizedRightShift(const uint32_t* src1, uint16_t len1, uint16_t src2, uint32_t* dest, uint16_t destLen);
+    /** @brief Sized left shift
+     *
+     * Shifts the significant limbs of src1 in
+     * the left direction src2 number of bits.
+     * dest may be src1.
+     *
+     * @param [in] src1 Argument 1
+     * @param [in] len1 Number of uint32_t in src1
+     * @param [in] src2 Bits to shift
+     * @param [out] dest Output
+     * @param [in] destLen Number of uint32_t in dest
+     * @return 1 if success, 0 if bits were shifted out of dest
+     */
+    int standardSizedLeftShift(const uint32_t* src1, uint16_t len1, uint16_t src2, uint32_t* dest, uint16_t destLen);
 
 #ifdef __cplusplus
 }
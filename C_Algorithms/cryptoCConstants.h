@@ -30,6 +30,54 @@ extern const int crypto_numbertype_default;
  */
 extern const int crypto_numbertype_base10;
 
+/** @brief Portable kernel tier
+ *
+ * This constant is 0.  It represents the
+ * reference multiply-accumulate kernels,
+ * written in portable C.
+ */
+extern const int crypto_kerneltier_portable;
+/** @brief MULX/ADX kernel tier
+ *
+ * This constant is 1.  It represents
+ * multiply-accumulate kernels built on
+ * the x86-64 BMI2 and ADX instructions.
+ */
+extern const int crypto_kerneltier_adx;
+
+/** @brief Prime sieve bound
+ *
+ * This constant is 32768.  Key generation
+ * sieves candidates by every odd prime
+ * below this bound before running any
+ * Miller-Rabin rounds.
+ */
+extern const int crypto_primesieve_limit;
+
+/** @brief Miller-Rabin prime test
+ *
+ * This constant is 0.  It represents a
+ * prime test of repeated Miller-Rabin
+ * rounds with random bases.
+ */
+extern const int crypto_primetest_millerrabin;
+/** @brief Baillie-PSW prime test
+ *
+ * This constant is 1.  It represents a
+ * prime test of a base-2 strong probable
+ * prime test and a strong Lucas test.
+ */
+extern const int crypto_primetest_bpsw;
+
+/** @brief Limb pool cache limit
+ *
+ * This constant is 262144.  Each thread
+ * keeps at most this many uint32_t of
+ * released limb storage for re-use, the
+ * rest is returned to the heap.
+ */
+extern const int crypto_limbpool_cache;
+
 /** @brief Default number marker
  *
  * This constant is "NULL Type".  It represents an
@@ -43,6 +91,16 @@ extern const char* crypto_numbername_default;
  * base-10, or standard integer.
  */
 extern const char* crypto_numbername_base10;
+/** @brief Base-10 64-bit limb number marker
+ *
+ * This constant is "Base 10 Type (64-bit)".
+ * It represents a base-10 number whose
+ * kernels process pairs of uint32_t as
+ * a single 64-bit limb.  The data layout,
+ * and therefore the type ID, is that of
+ * a base-10 number.
+ */
+extern const char* crypto_numbername_base10_64;
 
 ///@cond INTERAL
 
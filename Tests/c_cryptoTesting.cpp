@@ -18,6 +18,44 @@ using namespace test;
 using namespace os;
 using namespace crypto;
 
+//Heap calls are only counted on glibc, where malloc can be replaced, and not under AddressSanitizer
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+    #define C_CRYPTO_HEAP_COUNT
+#endif
+
+#ifdef C_CRYPTO_HEAP_COUNT
+    extern "C"
+    {
+        void* __libc_malloc(size_t size);
+        void* __libc_calloc(size_t count, size_t size);
+        void* __libc_realloc(void* ptr, size_t size);
+        void __libc_free(void* ptr);
+
+        static unsigned long _heapCalls = 0;
+
+        //Counting replacements of the allocator
+        void* malloc(size_t size)
+        {
+            _heapCalls++;
+            return __libc_malloc(size);
+        }
+        void* calloc(size_t count, size_t size)
+        {
+            _heapCalls++;
+            return __libc_calloc(count,size);
+        }
+        void* realloc(void* ptr, size_t size)
+        {
+            _heapCalls++;
+            return __libc_realloc(ptr,size);
+        }
+        void free(void* ptr)
+        {
+            __libc_free(ptr);
+        }
+    }
+#endif
+
     //Confirms NULL value
     void nullNumberType()
     {
@@ -37,8 +75,10 @@ using namespace crypto;
         if(_nullType->leftShift != NULL) generalTestException::throwException("NULL type left shift defined!!",locString);
 
         if(_nullType->multiplication != NULL) generalTestException::throwException("NULL type multiplication defined!!",locString);
+        if(_nullType->square != NULL) generalTestException::throwException("NULL type square defined!!",locString);
         if(_nullType->division != NULL) generalTestException::throwException("NULL type division defined!!",locString);
 		if(_nullType->modulo != NULL) generalTestException::throwException("NULL type modulo defined!!",locString);
+		if(_nullType->divmod != NULL) generalTestException::throwException("NULL type divmod defined!!",locString);
 
 		if(_nullType->exponentiation != NULL) generalTestException::throwException("NULL type exponentiation defined!!",locString);
 		if(_nullType->moduloExponentiation != NULL) generalTestException::throwException("NULL type moduloExponentiation defined!!",locString);
@@ -103,6 +143,11 @@ using namespace crypto;
             if(errorType) generalTestException::throwException("Base-10 type multiplication undefined!!",locString);
             else throw defThrow;
         }
+        if(_baseType->square == NULL)
+        {
+            if(errorType) generalTestException::throwException("Base-10 type square undefined!!",locString);
+            else throw defThrow;
+        }
         if(_baseType->division == NULL)
         {
             if(errorType) generalTestException::throwException("Base-10 type division undefined!!",locString);
@@ -113,6 +158,11 @@ using namespace crypto;
             if(errorType) generalTestException::throwException("Base-10 type modulo undefined!!",locString);
             else throw defThrow;
         }
+		if(_baseType->divmod == NULL)
+        {
+            if(errorType) generalTestException::throwException("Base-10 type divmod undefined!!",locString);
+            else throw defThrow;
+        }
 
 		if(_baseType->exponentiation == NULL)
         {
@@ -421,6 +471,19 @@ using namespace crypto;
         ret = _baseType->rightShift(src1,33,dest1,4);
         if(_baseType->compare(src2,dest1,4)!=0 || !ret)
             generalTestException::throwException("0:3:0:0>>33 failed!",locString);
+
+        //5:0:0:0>>1, in place
+        src1[0]=0;
+        src1[1]=0;
+        src1[2]=0;
+        src1[3]=5;
+        src2[0]=0;
+        src2[1]=0;
+        src2[2]=1<<31;
+        src2[3]=2;
+        ret = _baseType->rightShift(src1,1,src1,4);
+        if(_baseType->compare(src2,src1,4)!=0 || !ret)
+            generalTestException::throwException("5:0:0:0>>1 failed!",locString);
     }
     //Multiplication test
     void base10multiplicationTest()
@@ -479,6 +542,269 @@ using namespace crypto;
 		if(ret)
 			generalTestException::throwException("Overflow 2 failed!",locString);
     }
+    //Double-width multiplication test
+    void base10fullMultiplicationTest()
+    {
+        std::string locString = "c_cryptoTesting.cpp, base10fullMultiplicationTest()";
+
+        uint32_t src1[4];
+        uint32_t src2[4];
+        uint32_t dest1[8];
+        uint32_t dest2[8];
+        uint32_t wide1[8];
+        uint32_t wide2[8];
+        int ret;
+
+        src1[3]=0;  src1[2]=0;  src1[1]=0;  src1[0]=0;
+        src2[3]=0;  src2[2]=0;  src2[1]=0;  src2[0]=0;
+
+        //0*0
+        memset(dest2,0,sizeof(uint32_t)*8);
+        ret=base10FullMultiplication(src1,src2,dest1,4);
+        if(memcmp(dest1,dest2,sizeof(uint32_t)*8)!=0 || !ret)
+            generalTestException::throwException("0*0 failed!",locString);
+
+        //Max*Max
+        src1[3]=(uint32_t)-1;  src1[2]=(uint32_t)-1;  src1[1]=(uint32_t)-1;  src1[0]=(uint32_t)-1;
+        ret=base10FullMultiplication(src1,src1,dest1,4);
+        dest2[0]=1;
+        dest2[4]=(uint32_t)-2;  dest2[5]=(uint32_t)-1;  dest2[6]=(uint32_t)-1;  dest2[7]=(uint32_t)-1;
+        if(memcmp(dest1,dest2,sizeof(uint32_t)*8)!=0 || !ret)
+            generalTestException::throwException("Max*Max failed!",locString);
+
+        //Compare against the truncated multiplication
+        for(int i=0;i<20;++i)
+        {
+            memset(wide1,0,sizeof(uint32_t)*8);
+            memset(wide2,0,sizeof(uint32_t)*8);
+            for(int j=0;j<4;++j)
+            {
+                src1[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+                src2[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+                wide1[j]=src1[j];
+                wide2[j]=src2[j];
+            }
+            ret=base10FullMultiplication(src1,src2,dest1,4);
+            ret&=base10Multiplication(wide1,wide2,dest2,8);
+            if(memcmp(dest1,dest2,sizeof(uint32_t)*8)!=0 || !ret)
+                generalTestException::throwException("Random comparison failed!",locString);
+        }
+    }
+    //Karatsuba multiplication test
+    void base10karatsubaMultiplicationTest()
+    {
+        struct numberType* _baseType = typeCheckBase10();
+        std::string locString = "c_cryptoTesting.cpp, base10karatsubaMultiplicationTest()";
+
+        uint32_t src1[32];
+        uint32_t src2[32];
+        uint32_t dest1[32];
+        uint32_t dest2[32];
+        int ret1;
+        int ret2;
+
+        uint16_t oldThreshold=base10KaratsubaThreshold();
+        if(_baseType->multiplication!=&base10KaratsubaMultiplication)
+            generalTestException::throwException("Karatsuba not bound to number type!",locString);
+
+        //Force several levels of recursion
+        setBase10KaratsubaThreshold(4);
+        for(int i=0;i<40;++i)
+        {
+            int len1=1+rand()%16;
+            int len2=1+rand()%16;
+            if(i%4==0) len1=len2=16;
+            if(i%8==1) len1=len2=17;
+            //Unbalanced, the longer argument is split into chunks of the shorter
+            if(i%8==3)
+            {
+                len1=4+i%5;
+                len2=16;
+            }
+            memset(src1,0,sizeof(uint32_t)*32);
+            memset(src2,0,sizeof(uint32_t)*32);
+            for(int j=0;j<len1;++j)
+                src1[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            for(int j=0;j<len2;++j)
+                src2[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            if(i%4==2)
+            {
+                for(int j=0;j<len1;++j) src1[j]=(uint32_t)-1;
+                for(int j=0;j<len2;++j) src2[j]=(uint32_t)-1;
+            }
+
+            ret1=base10Multiplication(src1,src2,dest1,32);
+            ret2=base10KaratsubaMultiplication(src1,src2,dest2,32);
+            if(memcmp(dest1,dest2,sizeof(uint32_t)*32)!=0 || ret1!=ret2)
+            {
+                setBase10KaratsubaThreshold(oldThreshold);
+                generalTestException::throwException("Random comparison failed!",locString);
+            }
+        }
+
+        //Overflow must still be reported
+        memset(src1,0,sizeof(uint32_t)*32);
+        memset(src2,0,sizeof(uint32_t)*32);
+        src1[20]=1;
+        src2[12]=1;
+        ret1=base10KaratsubaMultiplication(src1,src2,dest1,32);
+        setBase10KaratsubaThreshold(oldThreshold);
+        if(ret1)
+            generalTestException::throwException("Overflow failed!",locString);
+    }
+    //Square test
+    void base10squareTest()
+    {
+        struct numberType* _baseType = typeCheckBase10();
+        std::string locString = "c_cryptoTesting.cpp, base10squareTest()";
+
+        uint32_t src1[32];
+        uint32_t dest1[32];
+        uint32_t dest2[32];
+        int ret1;
+        int ret2;
+
+        //Small values
+        memset(src1,0,sizeof(uint32_t)*32);
+        src1[0]=12;
+        ret1=_baseType->square(src1,dest1,32);
+        src1[0]=144;
+        if(_baseType->compare(src1,dest1,32)!=0 || !ret1)
+            generalTestException::throwException("12*12 failed!",locString);
+
+        //Squaring in place, both schoolbook and Karatsuba
+        uint16_t oldThreshold=base10KaratsubaThreshold();
+        for(int i=0;i<40;++i)
+        {
+            setBase10KaratsubaThreshold(i%2 ? 4 : oldThreshold);
+            int len=1+rand()%16;
+            if(i%4==0) len=16;
+            if(i%8==1) len=17;
+            memset(src1,0,sizeof(uint32_t)*32);
+            for(int j=0;j<len;++j)
+                src1[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            if(i%4==2)
+                for(int j=0;j<len;++j) src1[j]=(uint32_t)-1;
+
+            ret1=base10Multiplication(src1,src1,dest1,32);
+            ret2=_baseType->square(src1,src1,32);
+            if(memcmp(dest1,src1,sizeof(uint32_t)*32)!=0 || ret1!=ret2)
+            {
+                setBase10KaratsubaThreshold(oldThreshold);
+                generalTestException::throwException("Random comparison failed!",locString);
+            }
+        }
+
+        //Overflow must still be reported
+        memset(src1,0,sizeof(uint32_t)*32);
+        src1[16]=1;
+        ret1=_baseType->square(src1,dest2,32);
+        setBase10KaratsubaThreshold(oldThreshold);
+        if(ret1)
+            generalTestException::throwException("Overflow failed!",locString);
+    }
+    //Sized kernel test
+    void base10SizedKernelTest()
+    {
+        struct numberType* _baseType = typeCheckBase10();
+        struct numberType* _base64Type = buildBaseTen64Type();
+        std::string locString = "c_cryptoTesting.cpp, base10SizedKernelTest()";
+
+        uint32_t src1[32];
+        uint32_t src2[32];
+        uint32_t dest1[32];
+        uint32_t dest2[32];
+        int ret1;
+        int ret2;
+
+        if(_baseType->sizedMultiplication!=&base10SizedMultiplication || _base64Type->sizedMultiplication!=&base10_64SizedMultiplication)
+            generalTestException::throwException("Sized kernels not bound!",locString);
+
+        //Differently sized arguments match the padded kernels
+        uint16_t oldThreshold=base10KaratsubaThreshold();
+        for(int i=0;i<60;++i)
+        {
+            setBase10KaratsubaThreshold(i%2 ? 4 : oldThreshold);
+            int len1=1+rand()%16;
+            int len2=1+rand()%16;
+            int sig1=rand()%(len1+1);
+            int sig2=rand()%(len2+1);
+            memset(src1,0,sizeof(uint32_t)*32);
+            memset(src2,0,sizeof(uint32_t)*32);
+            for(int j=0;j<sig1;++j)
+                src1[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            for(int j=0;j<sig2;++j)
+                src2[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            if(i%4==2)
+            {
+                for(int j=0;j<sig1;++j) src1[j]=(uint32_t)-1;
+                for(int j=0;j<sig2;++j) src2[j]=(uint32_t)-1;
+            }
+            int destLen=(len1>len2 ? len1 : len2)+rand()%8;
+            uint16_t shift=rand()%(32*destLen);
+
+            if(standardSizedCompare(src1,len1,src2,len2)!=standardCompare(src1,src2,32))
+                generalTestException::throwException("Compare failed!",locString);
+
+            ret1=base10Addition(src1,src2,dest1,destLen);
+            ret2=base10SizedAddition(src1,len1,src2,len2,dest2,destLen);
+            if(ret1!=ret2 || (ret1 && memcmp(dest1,dest2,sizeof(uint32_t)*destLen)!=0))
+                generalTestException::throwException("Addition failed!",locString);
+
+            ret1=base10Subtraction(src1,src2,dest1,destLen);
+            ret2=base10SizedSubtraction(src1,len1,src2,len2,dest2,destLen);
+            if(ret1!=ret2 || (ret1 && memcmp(dest1,dest2,sizeof(uint32_t)*destLen)!=0))
+                generalTestException::throwException("Subtraction failed!",locString);
+
+            ret1=standardRightShift(src1,shift,dest1,destLen);
+            ret2=standardSizedRightShift(src1,len1,shift,dest2,destLen);
+            if(ret1!=ret2 || memcmp(dest1,dest2,sizeof(uint32_t)*destLen)!=0)
+                generalTestException::throwException("Right shift failed!",locString);
+
+            ret1=standardLeftShift(src1,shift,dest1,destLen);
+            ret2=standardSizedLeftShift(src1,len1,shift,dest2,destLen);
+            if(ret1!=ret2 || memcmp(dest1,dest2,sizeof(uint32_t)*destLen)!=0)
+                generalTestException::throwException("Left shift failed!",locString);
+
+            ret1=base10Multiplication(src1,src2,dest1,destLen);
+            ret2=base10SizedMultiplication(src1,len1,src2,len2,dest2,destLen);
+            if(ret1!=ret2 || memcmp(dest1,dest2,sizeof(uint32_t)*destLen)!=0)
+                generalTestException::throwException("Multiplication failed!",locString);
+            ret2=base10_64SizedMultiplication(src1,len1,src2,len2,dest2,destLen);
+            if(ret1!=ret2 || memcmp(dest1,dest2,sizeof(uint32_t)*destLen)!=0)
+                generalTestException::throwException("64-bit multiplication failed!",locString);
+
+            ret1=base10Multiplication(src1,src1,dest1,destLen);
+            ret2=base10SizedSquare(src1,len1,dest2,destLen);
+            if(ret1!=ret2 || memcmp(dest1,dest2,sizeof(uint32_t)*destLen)!=0)
+                generalTestException::throwException("Square failed!",locString);
+            ret2=base10_64SizedSquare(src1,len1,dest2,destLen);
+            if(ret1!=ret2 || memcmp(dest1,dest2,sizeof(uint32_t)*destLen)!=0)
+                generalTestException::throwException("64-bit square failed!",locString);
+
+            //Output may be the wider argument
+            memcpy(dest1,src1,sizeof(uint32_t)*32);
+            ret1=base10Addition(src1,src2,dest2,destLen);
+            ret2=base10SizedAddition(dest1,destLen,src2,len2,dest1,destLen);
+            if(ret1!=ret2 || (ret1 && memcmp(dest1,dest2,sizeof(uint32_t)*destLen)!=0))
+                generalTestException::throwException("In place addition failed!",locString);
+            memcpy(dest1,src1,sizeof(uint32_t)*32);
+            ret1=standardLeftShift(src1,shift%64,dest2,destLen);
+            ret2=standardSizedLeftShift(dest1,destLen,shift%64,dest1,destLen);
+            if(ret1!=ret2 || memcmp(dest1,dest2,sizeof(uint32_t)*destLen)!=0)
+                generalTestException::throwException("In place left shift failed!",locString);
+        }
+        setBase10KaratsubaThreshold(oldThreshold);
+
+        //Significant limbs past dest are an overflow
+        memset(src1,0,sizeof(uint32_t)*32);
+        src1[0]=1;
+        src1[8]=1;
+        if(base10SizedAddition(src1,16,src1,1,dest1,8) || standardSizedRightShift(src1,16,0,dest1,8))
+            generalTestException::throwException("Overflow failed!",locString);
+        if(!base10SizedAddition(src1,8,src1,1,dest1,8) || dest1[0]!=2)
+            generalTestException::throwException("Short argument failed!",locString);
+    }
     //Division test
     void base10divisionTest()
     {
@@ -619,6 +945,67 @@ using namespace crypto;
         if(_baseType->compare(src1,dest1,4)!=0 || !ret)
             generalTestException::throwException("0:0:1:3%0:0:1:0 failed!",locString);
 
+	}
+	//Base 10 division with remainder test
+	void base10divmodTest()
+	{
+		struct numberType* _baseType = typeCheckBase10();
+        std::string locString = "c_cryptoTesting.cpp, base10divmodTest()";
+
+        uint32_t src1[16];
+        uint32_t src2[16];
+        uint32_t quot1[16];
+        uint32_t rem1[16];
+        uint32_t quot2[16];
+        uint32_t rem2[16];
+        int ret;
+
+        //Divide by zero
+        memset(src1,0,sizeof(uint32_t)*16);
+        memset(src2,0,sizeof(uint32_t)*16);
+        src1[0]=5;
+        ret=_baseType->divmod(src1,src2,quot1,rem1,16);
+        if(ret || _baseType->compare(quot1,src2,16)!=0 || _baseType->compare(rem1,src2,16)!=0)
+            generalTestException::throwException("Divide by zero failed!",locString);
+
+        //Quotient digit estimate one too large, requires add-back
+        memset(src1,0,sizeof(uint32_t)*16);
+        memset(src2,0,sizeof(uint32_t)*16);
+        src1[3]=0x7fff;  src1[2]=0x8000;
+        src2[2]=0x8000;  src2[0]=1;
+        ret=_baseType->divmod(src1,src2,quot1,rem1,16);
+        memset(quot2,0,sizeof(uint32_t)*16);
+        memset(rem2,0,sizeof(uint32_t)*16);
+        quot2[0]=0xfffe0000;
+        rem2[2]=0x7fff;  rem2[1]=0xffffffff;  rem2[0]=0x00020000;
+        if(!ret || _baseType->compare(quot1,quot2,16)!=0 || _baseType->compare(rem1,rem2,16)!=0)
+            generalTestException::throwException("Add-back failed!",locString);
+
+        //Random comparison against division and modulo
+        for(int i=0;i<40;++i)
+        {
+            int len1=1+rand()%16;
+            int len2=1+rand()%len1;
+            memset(src1,0,sizeof(uint32_t)*16);
+            memset(src2,0,sizeof(uint32_t)*16);
+            for(int j=0;j<len1;++j)
+                src1[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            for(int j=0;j<len2;++j)
+                src2[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            if(src2[len2-1]==0) src2[len2-1]=1;
+
+            ret=_baseType->divmod(src1,src2,quot1,rem1,16);
+            _baseType->division(src1,src2,quot2,16);
+            _baseType->modulo(src1,src2,rem2,16);
+            if(!ret || _baseType->compare(quot1,quot2,16)!=0 || _baseType->compare(rem1,rem2,16)!=0)
+                generalTestException::throwException("Random comparison failed!",locString);
+
+            //quot*src2+rem==src1
+            _baseType->multiplication(quot1,src2,quot2,16);
+            _baseType->addition(quot2,rem1,quot2,16);
+            if(_baseType->compare(quot2,src1,16)!=0 || _baseType->compare(rem1,src2,16)>=0)
+                generalTestException::throwException("Identity failed!",locString);
+        }
 	}
 	//Base 10 exponentiation
 	void base10exponentiationTest()
@@ -844,6 +1231,166 @@ using namespace crypto;
         if(ret)
             generalTestException::throwException("Overflow failed!",locString);
 	}
+	//Montgomery exponentiation test
+	void base10montgomeryExponentiationTest()
+	{
+        std::string locString = "c_cryptoTesting.cpp, base10montgomeryExponentiationTest()";
+
+        uint32_t src1[8];
+        uint32_t src2[8];
+        uint32_t modVal[8];
+        uint32_t dest1[8];
+        uint32_t dest2[8];
+        uint32_t temp[8];
+        struct montgomeryContext ctx;
+
+        //Even and zero moduli are rejected
+        memset(modVal,0,sizeof(uint32_t)*8);
+        if(base10MontgomeryInit(&ctx,modVal,8))
+            generalTestException::throwException("Zero modulus accepted!",locString);
+        modVal[0]=10;
+        if(base10MontgomeryInit(&ctx,modVal,8) || ctx.length!=0)
+            generalTestException::throwException("Even modulus accepted!",locString);
+
+        for(int i=0;i<40;++i)
+        {
+            //Modulus and base fit in the lower half
+            int modLen=1+rand()%4;
+            memset(src1,0,sizeof(uint32_t)*8);
+            memset(src2,0,sizeof(uint32_t)*8);
+            memset(modVal,0,sizeof(uint32_t)*8);
+            for(int j=0;j<4;++j)
+                src1[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            for(int j=0;j<1+i%8;++j)
+                src2[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            if(i%8==7)
+            {
+                //RSA public exponent
+                memset(src2,0,sizeof(uint32_t)*8);
+                src2[0]=65537;
+            }
+            for(int j=0;j<modLen;++j)
+                modVal[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            modVal[0]|=1;
+            if(modVal[modLen-1]==0) modVal[modLen-1]=1;
+
+            //Reference square and multiply
+            memset(dest1,0,sizeof(uint32_t)*8);
+            dest1[0]=1;
+            memcpy(temp,src1,sizeof(uint32_t)*8);
+            base10Modulo(temp,modVal,temp,8);
+            for(int j=0;j<32*8;++j)
+            {
+                if(src2[j/32]&(1<<(j%32)))
+                {
+                    base10Multiplication(dest1,temp,dest1,8);
+                    base10Modulo(dest1,modVal,dest1,8);
+                }
+                base10Multiplication(temp,temp,temp,8);
+                base10Modulo(temp,modVal,temp,8);
+            }
+
+            if(!base10MontgomeryInit(&ctx,modVal,8))
+                generalTestException::throwException("Odd modulus rejected!",locString);
+            if(ctx.length!=modLen)
+            {
+                base10MontgomeryFree(&ctx);
+                generalTestException::throwException("Context length wrong!",locString);
+            }
+
+            //Context is re-used
+            for(int j=0;j<2;++j)
+            {
+                memset(dest2,0,sizeof(uint32_t)*8);
+                if(!base10MontgomeryExponentiation(&ctx,src1,src2,dest2,8) || memcmp(dest1,dest2,sizeof(uint32_t)*8)!=0)
+                {
+                    base10MontgomeryFree(&ctx);
+                    generalTestException::throwException("Random comparison failed!",locString);
+                }
+            }
+
+            //Out of and back into Montgomery form
+            base10Modulo(src1,modVal,src1,8);
+            base10MontgomeryMultiplication(&ctx,src1,ctx.rSquared,temp);
+            memset(dest2,0,sizeof(uint32_t)*8);
+            dest2[0]=1;
+            base10MontgomeryMultiplication(&ctx,temp,dest2,temp);
+            base10MontgomeryFree(&ctx);
+            if(memcmp(src1,temp,sizeof(uint32_t)*modLen)!=0)
+                generalTestException::throwException("Montgomery multiplication failed!",locString);
+
+            //Modular exponentiation binds Montgomery
+            memset(dest1,0,sizeof(uint32_t)*8);
+            if(!base10ModuloExponentiation(src1,src2,modVal,dest2,8) || !base10MontgomeryInit(&ctx,modVal,8))
+                generalTestException::throwException("Modular exponentiation failed!",locString);
+            base10MontgomeryExponentiation(&ctx,src1,src2,dest1,8);
+            base10MontgomeryFree(&ctx);
+            if(memcmp(dest1,dest2,sizeof(uint32_t)*8)!=0)
+                generalTestException::throwException("Modular exponentiation mismatch!",locString);
+        }
+
+        //Freed context is invalid
+        if(ctx.length!=0 || ctx.modulus!=NULL || base10MontgomeryExponentiation(&ctx,src1,src2,dest1,8))
+            generalTestException::throwException("Free failed!",locString);
+	}
+	//Barrett reduction test
+	void base10BarrettReductionTest()
+	{
+        std::string locString = "c_cryptoTesting.cpp, base10BarrettReductionTest()";
+
+        uint32_t src1[16];
+        uint32_t modVal[16];
+        uint32_t dest1[16];
+        uint32_t dest2[16];
+        struct barrettContext ctx;
+
+        //Zero modulus is rejected
+        memset(modVal,0,sizeof(uint32_t)*16);
+        if(base10BarrettInit(&ctx,modVal,16) || ctx.length!=0)
+            generalTestException::throwException("Zero modulus accepted!",locString);
+        if(base10BarrettReduce(&ctx,src1,dest1,16))
+            generalTestException::throwException("Empty context reduced!",locString);
+
+        for(int i=0;i<60;++i)
+        {
+            //Odd and even moduli, arguments up to and past twice the modulus length
+            int modLen=1+rand()%8;
+            int srcLen=rand()%17;
+            memset(src1,0,sizeof(uint32_t)*16);
+            memset(modVal,0,sizeof(uint32_t)*16);
+            for(int j=0;j<modLen;++j)
+                modVal[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            for(int j=0;j<srcLen && j<16;++j)
+                src1[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            if(i%4==1) modVal[0]&=~((uint32_t)1);
+            if(i%6==2)
+            {
+                for(int j=0;j<16;++j) src1[j]=(uint32_t)-1;
+            }
+            if(i%10==3)
+            {
+                //Powers of 2^32 have the widest mu
+                memset(modVal,0,sizeof(uint32_t)*16);
+                modVal[modLen-1]=1;
+            }
+            if(modVal[modLen-1]==0) modVal[modLen-1]=1;
+
+            if(!base10BarrettInit(&ctx,modVal,16) || ctx.length!=modLen)
+                generalTestException::throwException("Modulus rejected!",locString);
+            int ret1=base10Modulo(src1,modVal,dest1,16);
+            int ret2=base10BarrettReduce(&ctx,src1,dest2,16);
+
+            //In place
+            base10BarrettReduce(&ctx,src1,src1,16);
+            base10BarrettFree(&ctx);
+            if(!ret1 || !ret2 || memcmp(dest1,dest2,sizeof(uint32_t)*16)!=0)
+                generalTestException::throwException("Barrett comparison failed!",locString);
+            if(memcmp(dest1,src1,sizeof(uint32_t)*16)!=0)
+                generalTestException::throwException("In place reduction failed!",locString);
+        }
+        if(ctx.modulus!=NULL || ctx.mu!=NULL || ctx.length!=0)
+            generalTestException::throwException("Context not released!",locString);
+	}
 	//Base 10 GCD test
 	void base10GCDTest()
 	{
@@ -954,6 +1501,129 @@ using namespace crypto;
 		src1[0]=1;
 		if(_baseType->compare(src1,dest1,4)!=0 || ret)
             generalTestException::throwException("(6 mod 8)^-1 failed!",locString);
+
+		//(17 mod 3120)^-1, even modulus
+		src1[0]=17;
+		src2[0]=3120;
+		ret=_baseType->modInverse(src1,src2,dest1,4);
+		src1[0]=2753;
+		if(_baseType->compare(src1,dest1,4)!=0 || !ret)
+            generalTestException::throwException("(17 mod 3120)^-1 failed!",locString);
+
+		//(65537 mod 2^96+2)^-1, even modulus
+		src1[0]=65537;
+		src2[3]=1;	src2[0]=2;
+		ret=_baseType->modInverse(src1,src2,dest1,4);
+		uint32_t prod[4];
+		if(!ret || !base10Multiplication(src1,dest1,prod,4) || !base10Modulo(prod,src2,prod,4))
+            generalTestException::throwException("(65537 mod 2^96+2)^-1 failed!",locString);
+		src1[0]=1;
+		if(_baseType->compare(src1,prod,4)!=0)
+            generalTestException::throwException("(65537 mod 2^96+2)^-1 incorrect!",locString);
+	}
+	//Base 10 binary GCD against Euclidean GCD
+	void base10BinaryGCDTest()
+	{
+		struct numberType* _baseType = typeCheckBase10();
+        std::string locString = "c_cryptoTesting.cpp, base10BinaryGCDTest()";
+
+		uint32_t src1[8];
+        uint32_t src2[8];
+        uint32_t dest1[8];
+        uint32_t dest2[8];
+
+		for(int i=0;i<64;i++)
+		{
+			memset(src1,0,sizeof(uint32_t)*8);
+			memset(src2,0,sizeof(uint32_t)*8);
+			for(int j=0;j<4;j++)
+			{
+				src1[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+				src2[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+			}
+
+			//Share a factor on some iterations
+			if(i%4==0)
+			{
+				src1[0]&=~((uint32_t)0xff);
+				src2[0]&=~((uint32_t)0x0f);
+			}
+
+			if(!_baseType->gcd(src1,src2,dest1,8) || !base10EuclidGCD(src1,src2,dest2,8))
+				generalTestException::throwException("GCD failed!",locString);
+			if(_baseType->compare(dest1,dest2,8)!=0)
+				generalTestException::throwException("Binary GCD mismatch!",locString);
+
+			if(base10EuclidModInverse(src1,src2,dest2,8))
+			{
+				if(!_baseType->modInverse(src1,src2,dest1,8))
+					generalTestException::throwException("Modular inverse failed!",locString);
+				if(_baseType->compare(dest1,dest2,8)!=0)
+					generalTestException::throwException("Binary modular inverse mismatch!",locString);
+			}
+		}
+	}
+	//Base 10 batched modular inverse against single inverses
+	void base10BatchModInverseTest()
+	{
+		struct numberType* _baseType = typeCheckBase10();
+        std::string locString = "c_cryptoTesting.cpp, base10BatchModInverseTest()";
+
+		uint32_t src1[16][8];
+		uint32_t dest[16][8];
+		uint32_t mod[8];
+		uint32_t ans[8];
+		const uint32_t* d1[16];
+		uint32_t* d2[16];
+
+		//Odd and even moduli, arguments wider than the modulus
+		for(int i=0;i<8;i++)
+		{
+			memset(mod,0,sizeof(uint32_t)*8);
+			for(int j=0;j<3;j++)
+				mod[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+			mod[0]|=1;
+			if(i%2) mod[0]^=3;
+			for(int cnt=0;cnt<16;cnt++)
+			{
+				memset(src1[cnt],0,sizeof(uint32_t)*8);
+				for(int j=0;j<5;j++)
+					src1[cnt][j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+				src1[cnt][0]|=1;
+				d1[cnt]=src1[cnt];
+				d2[cnt]=dest[cnt];
+			}
+			if(i%2)
+			{
+				//An even argument shares a factor with an even modulus
+				src1[5][0]^=1;
+				if(base10BatchModInverse(d1,mod,d2,16,8))
+					generalTestException::throwException("Even argument accepted!",locString);
+				src1[5][0]^=1;
+			}
+
+			//Every argument with an inverse
+			bool invertible=true;
+			for(int cnt=0;cnt<16;cnt++)
+				invertible=invertible && _baseType->modInverse(src1[cnt],mod,ans,8);
+			if(base10BatchModInverse(d1,mod,d2,16,8)!=(invertible ? 1 : 0))
+				generalTestException::throwException("Batch inverse failed!",locString);
+			for(int cnt=0;invertible && cnt<16;cnt++)
+			{
+				_baseType->modInverse(src1[cnt],mod,ans,8);
+				if(_baseType->compare(ans,dest[cnt],8)!=0)
+					generalTestException::throwException("Batch inverse mismatch!",locString);
+			}
+		}
+
+		//In place, with a single argument, 13*3655=1 mod 7919
+		memset(mod,0,sizeof(uint32_t)*8);
+		mod[0]=7919;
+		memset(src1[0],0,sizeof(uint32_t)*8);
+		src1[0][0]=13;
+		d2[0]=src1[0];
+		if(!base10BatchModInverse(d1,mod,d2,1,8) || src1[0][0]!=3655)
+			generalTestException::throwException("In place inverse failed!",locString);
 	}
 	//Base 10 Primality test
 	void base10PrimealityTest()
@@ -1014,6 +1684,722 @@ using namespace crypto;
 		if(primeTest(src1,10,4))
 			generalTestException::throwException("243407 is not prime!",locString);
 	}
+	//Base 10 prime sieve test
+	void base10PrimeSieveTest()
+	{
+        std::string locString = "c_cryptoTesting.cpp, base10PrimeSieveTest()";
+
+		uint32_t src1[8];
+		uint32_t dest[8];
+		struct primeSieve sieve;
+		memset(src1,0,sizeof(uint32_t)*8);
+
+		//Walk across the sieve bound, checking against trial division
+		uint32_t start=(uint32_t)crypto_primesieve_limit-999;
+		src1[0]=start;
+		if(!base10PrimeSieveInit(&sieve,src1,4))
+			generalTestException::throwException("Sieve init failed!",locString);
+		for(uint32_t n=start;n<start+3000;n+=2)
+		{
+			bool factor=false;
+			for(uint32_t p=3;p<(uint32_t)crypto_primesieve_limit && p<n && !factor;p+=2)
+				factor=(n%p==0);
+			if(base10PrimeSieveSurvivor(&sieve)==factor)
+			{
+				base10PrimeSieveFree(&sieve);
+				generalTestException::throwException("Sieve mismatch!",locString);
+			}
+			base10PrimeSieveAdvance(&sieve,2);
+		}
+		base10PrimeSieveFree(&sieve);
+
+		//Trial division agrees with Miller-Rabin for small values
+		for(uint32_t n=2;n<3000;n++)
+		{
+			src1[0]=n;
+			bool prime=true;
+			for(uint32_t p=2;p*p<=n && prime;p++)
+				prime=(n%p!=0);
+			if(prime!=(primeTest(src1,10,4)==1))
+				generalTestException::throwException("Small prime mismatch!",locString);
+		}
+
+		//Next prime of small values
+		src1[0]=0;
+		if(!base10NextPrime(src1,dest,crypto_primetest_millerrabin,10,4) || dest[0]!=2)
+			generalTestException::throwException("Next prime of 0 failed!",locString);
+		src1[0]=8;
+		if(!base10NextPrime(src1,dest,crypto_primetest_millerrabin,10,4) || dest[0]!=11)
+			generalTestException::throwException("Next prime of 8 failed!",locString);
+		src1[0]=13;
+		if(!base10NextPrime(src1,dest,crypto_primetest_millerrabin,10,4) || dest[0]!=13)
+			generalTestException::throwException("Next prime of 13 failed!",locString);
+
+		//2^127-1 follows 2^127-2
+		for(int i=0;i<4;i++) src1[i]=0xFFFFFFFF;
+		src1[3]=0x7FFFFFFF;
+		src1[0]--;
+		if(!base10NextPrime(src1,dest,crypto_primetest_millerrabin,10,8) || dest[0]!=0xFFFFFFFF || dest[3]!=0x7FFFFFFF || dest[4]!=0)
+			generalTestException::throwException("Next prime of 2^127-2 failed!",locString);
+
+		//Search past the end of the array
+		src1[0]=0xFFFFFFFF;
+		if(base10NextPrime(src1,dest,crypto_primetest_millerrabin,10,1))
+			generalTestException::throwException("Overflow failed!",locString);
+	}
+
+	//Base 10 Baillie-PSW test
+	void base10BPSWPrimeTest()
+	{
+        std::string locString = "c_cryptoTesting.cpp, base10BPSWPrimeTest()";
+
+		uint32_t src1[4];
+		memset(src1,0,sizeof(uint32_t)*4);
+
+		//Agrees with trial division across the 257^2 shortcut
+		for(uint32_t n=2;n<100000;n++)
+		{
+			src1[0]=n;
+			bool prime=true;
+			for(uint32_t p=2;p*p<=n && prime;p++)
+				prime=(n%p!=0);
+			if(prime!=(base10BPSWTest(src1,1)==1))
+				generalTestException::throwException("Small prime mismatch!",locString);
+		}
+
+		//Known primes, 2^31-1 has n+1 a power of 2
+		const uint64_t primes[]={2147483647ull,4294967291ull,2305843009213693951ull,18446744073709551557ull,1000003ull};
+		for(int i=0;i<5;i++)
+		{
+			src1[0]=(uint32_t)primes[i];
+			src1[1]=(uint32_t)(primes[i]>>32);
+			if(!base10BPSWTest(src1,2))
+				generalTestException::throwException("Prime rejected!",locString);
+			if(!base10ProbablePrime(src1,crypto_primetest_bpsw,0,4) || !base10ProbablePrime(src1,crypto_primetest_millerrabin,10,4))
+				generalTestException::throwException("Prime test mode failed!",locString);
+		}
+
+		//2^89-1 and 2^127-1, the full width of the array
+		src1[0]=0xFFFFFFFF;
+		src1[1]=0xFFFFFFFF;
+		src1[2]=0x01FFFFFF;
+		if(!base10BPSWTest(src1,3))
+			generalTestException::throwException("2^89-1 rejected!",locString);
+		src1[2]=0xFFFFFFFF;
+		src1[3]=0x7FFFFFFF;
+		if(!base10BPSWTest(src1,4))
+			generalTestException::throwException("2^127-1 rejected!",locString);
+		src1[0]-=2;
+		if(base10BPSWTest(src1,4))
+			generalTestException::throwException("2^127-3 accepted!",locString);
+
+		//Strong base 2 pseudoprimes, 1093^2 and 3511^2 are squares
+		const uint64_t baseTwo[]={280601ull,1194649ull,12327121ull,3215031751ull,3825123056546413051ull};
+		memset(src1,0,sizeof(uint32_t)*4);
+		for(int i=0;i<5;i++)
+		{
+			src1[0]=(uint32_t)baseTwo[i];
+			src1[1]=(uint32_t)(baseTwo[i]>>32);
+			if(base10BPSWTest(src1,4))
+				generalTestException::throwException("Base 2 pseudoprime accepted!",locString);
+		}
+		src1[0]=0xFC85B7E5;
+		src1[1]=0xE92817F9;
+		src1[2]=0x437A;
+		if(base10BPSWTest(src1,4))
+			generalTestException::throwException("Base 37 pseudoprime accepted!",locString);
+
+		//Strong Lucas pseudoprimes fall to the base 2 test
+		const uint32_t lucas[]={161027,2942081};
+		memset(src1,0,sizeof(uint32_t)*4);
+		for(int i=0;i<2;i++)
+		{
+			src1[0]=lucas[i];
+			if(base10BPSWTest(src1,4))
+				generalTestException::throwException("Lucas pseudoprime accepted!",locString);
+		}
+
+		//Next prime in Baillie-PSW mode
+		src1[0]=280600;
+		uint32_t dest[4];
+		if(!base10NextPrime(src1,dest,crypto_primetest_bpsw,0,4) || dest[0]!=280603)
+			generalTestException::throwException("Next prime failed!",locString);
+	}
+	//Base 10 fused modular operations test
+	void base10ModMultiplyTest()
+	{
+		struct numberType* _baseType = typeCheckBase10();
+        std::string locString = "c_cryptoTesting.cpp, base10ModMultiplyTest()";
+
+		uint32_t src1[16];
+		uint32_t src2[16];
+		uint32_t src3[16];
+		uint32_t mod[16];
+		uint32_t prod[16];
+		uint32_t ans[16];
+		uint32_t dest[16];
+
+		//Arguments wider and narrower than odd and even moduli
+		for(int i=0;i<20;i++)
+		{
+			memset(src1,0,sizeof(uint32_t)*16);
+			memset(src2,0,sizeof(uint32_t)*16);
+			memset(src3,0,sizeof(uint32_t)*16);
+			memset(mod,0,sizeof(uint32_t)*16);
+			for(int j=0;j<8;j++)
+			{
+				src1[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+				if(j<3+i%6) src2[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+				if(j<5) src3[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+				if(j<2+i%5) mod[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+			}
+			if(i%2) mod[0]&=~((uint32_t)1);
+			struct barrettContext ctx;
+			base10BarrettInit(&ctx,mod,16);
+
+			//(a*b)%m
+			_baseType->multiplication(src1,src2,prod,16);
+			_baseType->modulo(prod,mod,ans,16);
+			if(!base10ModMultiply(src1,src2,mod,dest,16) || memcmp(ans,dest,sizeof(uint32_t)*16)!=0)
+				generalTestException::throwException("Modular multiplication failed!",locString);
+			if(!base10BarrettMultiply(&ctx,src1,src2,dest,16) || memcmp(ans,dest,sizeof(uint32_t)*16)!=0)
+				generalTestException::throwException("Barrett multiplication failed!",locString);
+
+			//(a*a)%m
+			_baseType->square(src1,prod,16);
+			_baseType->modulo(prod,mod,ans,16);
+			memcpy(dest,src1,sizeof(uint32_t)*16);
+			if(!base10ModMultiply(dest,dest,mod,dest,16) || memcmp(ans,dest,sizeof(uint32_t)*16)!=0)
+				generalTestException::throwException("Modular square failed!",locString);
+			memcpy(dest,src1,sizeof(uint32_t)*16);
+			if(!base10BarrettMultiply(&ctx,dest,dest,dest,16) || memcmp(ans,dest,sizeof(uint32_t)*16)!=0)
+				generalTestException::throwException("Barrett square failed!",locString);
+
+			//(a*b+c)%m
+			_baseType->multiplication(src1,src2,prod,16);
+			_baseType->addition(prod,src3,prod,16);
+			_baseType->modulo(prod,mod,ans,16);
+			if(!base10ModMultiplyAdd(src1,src2,src3,mod,dest,16) || memcmp(ans,dest,sizeof(uint32_t)*16)!=0)
+				generalTestException::throwException("Modular multiply and add failed!",locString);
+			if(!base10BarrettMultiplyAdd(&ctx,src1,src2,src3,dest,16) || memcmp(ans,dest,sizeof(uint32_t)*16)!=0)
+				generalTestException::throwException("Barrett multiply and add failed!",locString);
+
+			//(a-b)%m, either way around
+			_baseType->modulo(src1,mod,prod,16);
+			_baseType->modulo(src3,mod,ans,16);
+			if(_baseType->compare(prod,ans,16)>=0)
+				_baseType->subtraction(prod,ans,ans,16);
+			else
+			{
+				_baseType->subtraction(mod,ans,ans,16);
+				_baseType->addition(prod,ans,ans,16);
+			}
+			if(!base10ModSubtract(src1,src3,mod,dest,16) || memcmp(ans,dest,sizeof(uint32_t)*16)!=0)
+				generalTestException::throwException("Modular subtraction failed!",locString);
+			if(!base10BarrettSubtract(&ctx,src1,src3,dest,16) || memcmp(ans,dest,sizeof(uint32_t)*16)!=0)
+				generalTestException::throwException("Barrett subtraction failed!",locString);
+			base10BarrettFree(&ctx);
+		}
+
+		//A zero modulus fails
+		memset(mod,0,sizeof(uint32_t)*16);
+		if(base10ModMultiply(src1,src2,mod,dest,16) || base10ModMultiplyAdd(src1,src2,src3,mod,dest,16) || base10ModSubtract(src1,src2,mod,dest,16))
+			generalTestException::throwException("Zero modulus accepted!",locString);
+	}
+	//Base 10 workspace test
+	void base10WorkspaceTest()
+	{
+		struct numberType* _baseType = typeCheckBase10();
+        std::string locString = "c_cryptoTesting.cpp, base10WorkspaceTest()";
+
+		uint32_t src1[16];
+        uint32_t src2[16];
+        uint32_t modVal[16];
+        uint32_t dest1[16];
+        uint32_t dest2[16];
+        uint32_t dest3[16];
+        uint32_t prime[16];
+
+		memset(src1,0,sizeof(uint32_t)*16);
+		memset(src2,0,sizeof(uint32_t)*16);
+		memset(modVal,0,sizeof(uint32_t)*16);
+		memset(prime,0,sizeof(uint32_t)*16);
+		for(int i=0;i<8;i++)
+		{
+			src1[i]=(uint32_t)rand()^((uint32_t)rand()<<16);
+			src2[i]=(uint32_t)rand()^((uint32_t)rand()<<16);
+			modVal[i]=(uint32_t)rand()^((uint32_t)rand()<<16);
+		}
+		modVal[0]|=1;
+		//2^127-1
+		for(int i=0;i<4;i++) prime[i]=0xFFFFFFFF;
+		prime[3]=0x7FFFFFFF;
+
+		//Caller supplied workspace, the kernels must not spill out of it
+		struct numberWorkspace ws;
+		if(!numberWorkspaceInit(&ws,base10WorkspaceSize(16)))
+			generalTestException::throwException("Workspace init failed!",locString);
+		struct numberWorkspace* oldWs=bindNumberWorkspace(&ws);
+		uint32_t allocs=numberWorkspaceAllocations();
+
+		int good=1;
+		good&=_baseType->moduloExponentiation(src1,src2,modVal,dest1,16);
+		modVal[0]&=~((uint32_t)1);
+		good&=_baseType->moduloExponentiation(src1,src2,modVal,dest2,16);
+		modVal[0]|=1;
+		good&=primeTest(prime,10,16);
+		good&=_baseType->gcd(src1,modVal,dest2,16);
+		good&=_baseType->multiplication(src1,src2,dest2,16);
+		good&=_baseType->square(src1,dest2,16);
+		good&=_baseType->divmod(src1,modVal,NULL,dest2,16);
+		_baseType->modInverse(src1,modVal,dest2,16);
+		good&=_baseType->leftShift(src1,33,dest2,16);
+
+		bindNumberWorkspace(oldWs);
+		if(!good)
+			generalTestException::throwException("Workspace operation failed!",locString);
+		if(numberWorkspaceAllocations()!=allocs)
+			generalTestException::throwException("Caller workspace spilled!",locString);
+		if(ws.used!=0 || ws.spilled!=0 || ws.peak>ws.size)
+			generalTestException::throwException("Caller workspace not released!",locString);
+		numberWorkspaceFree(&ws);
+
+		//Thread workspace, once reserved, neither grows nor spills
+		if(!numberWorkspaceReserve(base10WorkspaceSize(16)))
+			generalTestException::throwException("Workspace reserve failed!",locString);
+		allocs=numberWorkspaceAllocations();
+#ifdef C_CRYPTO_HEAP_COUNT
+		unsigned long heapCalls=_heapCalls;
+#endif
+		good&=_baseType->moduloExponentiation(src1,src2,modVal,dest2,16);
+		good&=primeTest(prime,10,16);
+		good&=_baseType->gcd(src1,modVal,dest3,16);
+		_baseType->modInverse(src1,modVal,dest3,16);
+#ifdef C_CRYPTO_HEAP_COUNT
+		//Other platforms skip the heap check, the workspace counter still applies
+		if(_heapCalls!=heapCalls)
+			generalTestException::throwException("Reserved workspace reached the heap!",locString);
+#endif
+		if(numberWorkspaceAllocations()!=allocs)
+			generalTestException::throwException("Thread workspace spilled!",locString);
+		if(memcmp(dest1,dest2,sizeof(uint32_t)*16)!=0 || !good)
+			generalTestException::throwException("Thread workspace mismatch!",locString);
+
+		//An empty workspace spills to the heap with the same result
+		numberWorkspaceInit(&ws,0);
+		oldWs=bindNumberWorkspace(&ws);
+		allocs=numberWorkspaceAllocations();
+		_baseType->moduloExponentiation(src1,src2,modVal,dest2,16);
+		bindNumberWorkspace(oldWs);
+		if(numberWorkspaceAllocations()==allocs || ws.spilled!=0)
+			generalTestException::throwException("Spill failed!",locString);
+		if(memcmp(dest1,dest2,sizeof(uint32_t)*16)!=0)
+			generalTestException::throwException("Spill mismatch!",locString);
+		numberWorkspaceFree(&ws);
+	}
+
+	//Limb pool test
+	void base10LimbPoolTest()
+	{
+        std::string locString = "c_cryptoTesting.cpp, base10LimbPoolTest()";
+
+		numberLimbPoolTrim();
+		struct numberLimbPoolStats start=numberLimbPoolStatistics();
+		if(start.cachedBytes!=0)
+			generalTestException::throwException("Trim left cached storage!",locString);
+
+		//Blocks are rounded to their size class
+		uint32_t cap=0;
+		uint32_t* block=numberLimbAlloc(300,&cap);
+		if(!block || cap!=512 || ((uintptr_t)block)%sizeof(uint64_t)!=0)
+			generalTestException::throwException("Allocation failed!",locString);
+		memset(block,0xAB,sizeof(uint32_t)*cap);
+		struct numberLimbPoolStats stats=numberLimbPoolStatistics();
+		if(stats.allocations!=start.allocations+1 || stats.heapAllocations!=start.heapAllocations+1)
+			generalTestException::throwException("Allocation not counted!",locString);
+		if(stats.bytes!=start.bytes+512*sizeof(uint32_t) || stats.peakBytes<stats.bytes)
+			generalTestException::throwException("Bytes not counted!",locString);
+
+		//A released block serves the next request of its class
+		numberLimbFree(block);
+		if(numberLimbPoolStatistics().cachedBytes!=512*sizeof(uint32_t) || numberLimbPoolStatistics().bytes!=start.bytes)
+			generalTestException::throwException("Release not counted!",locString);
+		uint32_t* again=numberLimbAlloc(400,&cap);
+		if(again!=block || cap!=512 || numberLimbPoolStatistics().heapAllocations!=stats.heapAllocations)
+			generalTestException::throwException("Block not re-used!",locString);
+		uint32_t* other=numberLimbAlloc(20,&cap);
+		if(other==again || cap!=256)
+			generalTestException::throwException("Size class wrong!",locString);
+		numberLimbFree(other);
+		numberLimbFree(again);
+
+		//Blocks past the largest class go straight back to the heap
+		block=numberLimbAlloc(70000,&cap);
+		if(!block || cap!=70000)
+			generalTestException::throwException("Large allocation failed!",locString);
+		block[69999]=1;
+		stats=numberLimbPoolStatistics();
+		numberLimbFree(block);
+		if(numberLimbPoolStatistics().cachedBytes!=stats.cachedBytes)
+			generalTestException::throwException("Large block cached!",locString);
+		numberLimbFree(NULL);
+
+		numberLimbPoolTrim();
+		if(numberLimbPoolStatistics().cachedBytes!=0 || numberLimbPoolStatistics().bytes!=start.bytes)
+			generalTestException::throwException("Trim failed!",locString);
+	}
+
+	//64-bit limb number type test
+	void base10_64TypeTest()
+	{
+        std::string locString = "c_cryptoTesting.cpp, base10_64TypeTest()";
+        struct numberType* _wideType = buildBaseTen64Type();
+        if(_wideType == NULL) generalTestException::throwException("64-bit type could not be built!",locString);
+
+        //Same layout, and so the same ID, as a base-10 number
+        if(_wideType->typeID != crypto::numberType::Base10) generalTestException::throwException("64-bit type ID wrong!",locString);
+		if(std::string(_wideType->name) != numberName::Base10_64) generalTestException::throwException("64-bit type name wrong!",locString);
+		if(_wideType == buildBaseTenType()) generalTestException::throwException("64-bit type is the base-10 type!",locString);
+
+        if(_wideType->compare == NULL || _wideType->addition == NULL || _wideType->subtraction == NULL ||
+           _wideType->rightShift == NULL || _wideType->leftShift == NULL || _wideType->multiplication == NULL ||
+           _wideType->square == NULL || _wideType->division == NULL || _wideType->modulo == NULL ||
+           _wideType->divmod == NULL || _wideType->exponentiation == NULL || _wideType->moduloExponentiation == NULL ||
+           _wideType->gcd == NULL || _wideType->modInverse == NULL)
+            generalTestException::throwException("64-bit type incomplete!",locString);
+
+        if(_wideType->multiplication != &base10_64Multiplication) generalTestException::throwException("64-bit multiplication not bound!",locString);
+        if(_wideType->moduloExponentiation != &base10_64ModuloExponentiation) generalTestException::throwException("64-bit modulo exponentiation not bound!",locString);
+	}
+	//64-bit limb kernel test
+	void base10_64KernelTest()
+	{
+		struct numberType* _baseType = typeCheckBase10();
+		struct numberType* _wideType = buildBaseTen64Type();
+        std::string locString = "c_cryptoTesting.cpp, base10_64KernelTest()";
+
+        uint32_t src1[40];
+        uint32_t src2[40];
+        uint32_t modVal[40];
+        uint32_t dest1[40];
+        uint32_t dest2[40];
+        uint32_t rem1[40];
+        uint32_t rem2[40];
+        int ret1;
+        int ret2;
+
+        //Second half forces several levels of Karatsuba recursion
+        uint16_t oldThreshold=base10KaratsubaThreshold();
+        for(int i=0;i<80;++i)
+        {
+            if(i==40) setBase10KaratsubaThreshold(4);
+
+            //Odd lengths leave half of the top 64-bit limb unused
+            int len=1+rand()%40;
+            int len1=rand()%(len+1);
+            int len2=1+rand()%len;
+            if(i%4==0) len1=len2=len;
+            memset(src1,0,sizeof(uint32_t)*40);
+            memset(src2,0,sizeof(uint32_t)*40);
+            memset(modVal,0,sizeof(uint32_t)*40);
+            for(int j=0;j<len1;++j)
+                src1[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            for(int j=0;j<len2;++j)
+            {
+                src2[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+                modVal[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            }
+            if(i%4==2)
+            {
+                for(int j=0;j<len1;++j) src1[j]=(uint32_t)-1;
+                for(int j=0;j<len2;++j) src2[j]=(uint32_t)-1;
+            }
+            if(modVal[len2-1]==0) modVal[len2-1]=1;
+
+            //Products, including overflow
+            ret1=_baseType->multiplication(src1,src2,dest1,len);
+            ret2=_wideType->multiplication(src1,src2,dest2,len);
+            if(memcmp(dest1,dest2,sizeof(uint32_t)*len)!=0 || ret1!=ret2)
+            {
+                setBase10KaratsubaThreshold(oldThreshold);
+                generalTestException::throwException("Multiplication comparison failed!",locString);
+            }
+            ret1=_baseType->square(src1,dest1,len);
+            ret2=_wideType->square(src1,dest2,len);
+            if(memcmp(dest1,dest2,sizeof(uint32_t)*len)!=0 || ret1!=ret2)
+            {
+                setBase10KaratsubaThreshold(oldThreshold);
+                generalTestException::throwException("Square comparison failed!",locString);
+            }
+
+            //Division with remainder
+            ret1=_baseType->divmod(src1,src2,dest1,rem1,len);
+            ret2=_wideType->divmod(src1,src2,dest2,rem2,len);
+            if(memcmp(dest1,dest2,sizeof(uint32_t)*len)!=0 || memcmp(rem1,rem2,sizeof(uint32_t)*len)!=0 || ret1!=ret2)
+            {
+                setBase10KaratsubaThreshold(oldThreshold);
+                generalTestException::throwException("Division comparison failed!",locString);
+            }
+
+            //Modulo exponentiation, odd and even moduli
+            if(i%2) modVal[0]|=1;
+            else modVal[0]&=~((uint32_t)1);
+            if(len<=16)
+            {
+                ret1=_baseType->moduloExponentiation(src1,src2,modVal,dest1,len);
+                ret2=_wideType->moduloExponentiation(src1,src2,modVal,dest2,len);
+                if(memcmp(dest1,dest2,sizeof(uint32_t)*len)!=0 || ret1!=ret2)
+                {
+                    setBase10KaratsubaThreshold(oldThreshold);
+                    generalTestException::throwException("Modulo exponentiation comparison failed!",locString);
+                }
+            }
+
+            //Small exponents
+            memset(src2,0,sizeof(uint32_t)*40);
+            src2[0]=rand()%20;
+            ret1=_baseType->exponentiation(src1,src2,dest1,len);
+            ret2=_wideType->exponentiation(src1,src2,dest2,len);
+            if(memcmp(dest1,dest2,sizeof(uint32_t)*len)!=0 || ret1!=ret2)
+            {
+                setBase10KaratsubaThreshold(oldThreshold);
+                generalTestException::throwException("Exponentiation comparison failed!",locString);
+            }
+        }
+        setBase10KaratsubaThreshold(oldThreshold);
+
+        //In place, as used by the integer operators
+        memset(src1,0,sizeof(uint32_t)*40);
+        src1[0]=0xFFFFFFFF;
+        src1[2]=7;
+        memcpy(dest1,src1,sizeof(uint32_t)*40);
+        _baseType->square(src1,src1,5);
+        _wideType->square(dest1,dest1,5);
+        if(memcmp(src1,dest1,sizeof(uint32_t)*5)!=0)
+            generalTestException::throwException("In place square failed!",locString);
+
+        //Divide by zero
+        memset(src2,0,sizeof(uint32_t)*40);
+        if(_wideType->divmod(src1,src2,dest1,rem1,5))
+            generalTestException::throwException("Divide by zero succeeded!",locString);
+	}
+	//64-bit limb Montgomery test
+	void base10_64MontgomeryTest()
+	{
+        std::string locString = "c_cryptoTesting.cpp, base10_64MontgomeryTest()";
+
+        uint32_t src1[9];
+        uint32_t src2[9];
+        uint32_t modVal[9];
+        uint32_t dest1[9];
+        uint32_t dest2[9];
+        uint32_t temp[9];
+        struct montgomeryContext ctx;
+        struct montgomeryContext64 ctx64;
+
+        //Even and zero moduli are rejected
+        memset(modVal,0,sizeof(uint32_t)*9);
+        if(base10_64MontgomeryInit(&ctx64,modVal,9))
+            generalTestException::throwException("Zero modulus accepted!",locString);
+        modVal[0]=10;
+        if(base10_64MontgomeryInit(&ctx64,modVal,9) || ctx64.length!=0)
+            generalTestException::throwException("Even modulus accepted!",locString);
+
+        for(int i=0;i<40;++i)
+        {
+            //Odd moduli lengths leave half of the top limb unused
+            int modLen=1+rand()%5;
+            memset(src1,0,sizeof(uint32_t)*9);
+            memset(src2,0,sizeof(uint32_t)*9);
+            memset(modVal,0,sizeof(uint32_t)*9);
+            for(int j=0;j<9;++j)
+                src1[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            for(int j=0;j<1+i%9;++j)
+                src2[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            if(i%8==7)
+            {
+                memset(src2,0,sizeof(uint32_t)*9);
+                src2[0]=65537;
+            }
+            for(int j=0;j<modLen;++j)
+                modVal[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            modVal[0]|=1;
+            if(modVal[modLen-1]==0) modVal[modLen-1]=1;
+
+            if(!base10MontgomeryInit(&ctx,modVal,9) || !base10_64MontgomeryInit(&ctx64,modVal,9))
+                generalTestException::throwException("Odd modulus rejected!",locString);
+            if(ctx64.length!=(modLen+1)/2)
+            {
+                base10MontgomeryFree(&ctx);
+                base10_64MontgomeryFree(&ctx64);
+                generalTestException::throwException("Unexpected context length!",locString);
+            }
+            int ret1=base10MontgomeryExponentiation(&ctx,src1,src2,dest1,9);
+            int ret2=base10_64MontgomeryExponentiation(&ctx64,src1,src2,dest2,9);
+
+            //The modulus must fit in the output
+            int fits=base10_64MontgomeryExponentiation(&ctx64,src1,src2,temp,modLen);
+            int tooShort=modLen>1 && base10_64MontgomeryExponentiation(&ctx64,src1,src2,temp,modLen-1);
+            base10MontgomeryFree(&ctx);
+            base10_64MontgomeryFree(&ctx64);
+            if(!ret1 || !ret2 || memcmp(dest1,dest2,sizeof(uint32_t)*9)!=0)
+                generalTestException::throwException("Montgomery comparison failed!",locString);
+            if(!fits || tooShort)
+                generalTestException::throwException("Output length check failed!",locString);
+        }
+        if(ctx64.modulus!=NULL || ctx64.length!=0)
+            generalTestException::throwException("Context not released!",locString);
+	}
+
+	//64-bit limb kernel tier test
+	void base10_64KernelTierTest()
+	{
+        std::string locString = "c_cryptoTesting.cpp, base10_64KernelTierTest()";
+
+        //The fastest tier is installed at startup
+        int hostTier=base10_64HostKernelTier();
+        if(hostTier!=crypto_kerneltier_portable && hostTier!=crypto_kerneltier_adx)
+            generalTestException::throwException("Unknown host tier!",locString);
+        if(base10_64KernelTier()!=hostTier)
+            generalTestException::throwException("Host tier not installed!",locString);
+        if(base10_64SetKernelTier(-1) || base10_64KernelTier()!=hostTier)
+            generalTestException::throwException("Unknown tier accepted!",locString);
+        if(!base10_64SetKernelTier(crypto_kerneltier_portable) || base10_64KernelTier()!=crypto_kerneltier_portable)
+        {
+            base10_64SetKernelTier(hostTier);
+            generalTestException::throwException("Portable tier rejected!",locString);
+        }
+        base10_64SetKernelTier(hostTier);
+        if(hostTier==crypto_kerneltier_portable) return;
+
+        uint32_t src1[64];
+        uint32_t src2[64];
+        uint32_t modVal[64];
+        uint32_t dest1[64];
+        uint32_t dest2[64];
+        int ret1;
+        int ret2;
+
+        //Differential test against the portable tier
+        for(int i=0;i<40;++i)
+        {
+            int len=1+rand()%64;
+            memset(src1,0,sizeof(uint32_t)*64);
+            memset(src2,0,sizeof(uint32_t)*64);
+            memset(modVal,0,sizeof(uint32_t)*64);
+            for(int j=0;j<(len+1)/2;++j)
+            {
+                src1[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+                src2[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+                modVal[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            }
+            if(i%4==2)
+            {
+                for(int j=0;j<(len+1)/2;++j)
+                    src1[j]=src2[j]=modVal[j]=(uint32_t)-1;
+            }
+            modVal[0]|=1;
+
+            base10_64SetKernelTier(crypto_kerneltier_portable);
+            ret1=base10_64Multiplication(src1,src2,dest1,len);
+            base10_64SetKernelTier(hostTier);
+            ret2=base10_64Multiplication(src1,src2,dest2,len);
+            if(memcmp(dest1,dest2,sizeof(uint32_t)*len)!=0 || ret1!=ret2)
+                generalTestException::throwException("Multiplication comparison failed!",locString);
+
+            base10_64SetKernelTier(crypto_kerneltier_portable);
+            ret1=base10_64Square(src1,dest1,len);
+            base10_64SetKernelTier(hostTier);
+            ret2=base10_64Square(src1,dest2,len);
+            if(memcmp(dest1,dest2,sizeof(uint32_t)*len)!=0 || ret1!=ret2)
+                generalTestException::throwException("Square comparison failed!",locString);
+
+            //Montgomery reduction
+            base10_64SetKernelTier(crypto_kerneltier_portable);
+            ret1=base10_64ModuloExponentiation(src1,src2,modVal,dest1,len);
+            base10_64SetKernelTier(hostTier);
+            ret2=base10_64ModuloExponentiation(src1,src2,modVal,dest2,len);
+            if(memcmp(dest1,dest2,sizeof(uint32_t)*len)!=0 || ret1!=ret2)
+                generalTestException::throwException("Modulo exponentiation comparison failed!",locString);
+        }
+	}
+
+	//64-bit limb batch test
+	void base10_64BatchTest()
+	{
+        std::string locString = "c_cryptoTesting.cpp, base10_64BatchTest()";
+
+        //The widest batch is installed at startup
+        int hostWidth=base10_64HostBatchWidth();
+        if(base10_64BatchWidth()!=hostWidth)
+            generalTestException::throwException("Host width not installed!",locString);
+        if(base10_64SetBatchWidth(3) || base10_64BatchWidth()!=hostWidth)
+            generalTestException::throwException("Unknown width accepted!",locString);
+
+        uint32_t src1[20][24];
+        uint32_t src2[20][24];
+        uint32_t modVal[20][24];
+        uint32_t dest1[20][24];
+        uint32_t dest2[20][24];
+        const uint32_t* arg1[20];
+        const uint32_t* arg2[20];
+        const uint32_t* arg3[20];
+        uint32_t* out[20];
+
+        for(int i=0;i<20;++i)
+        {
+            //Mixed moduli sizes, with even moduli and zero bases left to the scalar kernel
+            int modLen=1+rand()%12;
+            memset(src1[i],0,sizeof(uint32_t)*24);
+            memset(src2[i],0,sizeof(uint32_t)*24);
+            memset(modVal[i],0,sizeof(uint32_t)*24);
+            for(int j=0;j<modLen;++j)
+            {
+                src1[i][j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+                src2[i][j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+                modVal[i][j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            }
+            if(i%5==1)
+            {
+                memset(src2[i],0,sizeof(uint32_t)*24);
+                src2[i][0]=65537;
+            }
+            if(i%7!=3) modVal[i][0]|=1;
+            if(i==9) memset(src1[i],0,sizeof(uint32_t)*24);
+            if(modVal[i][modLen-1]==0) modVal[i][modLen-1]=1;
+            arg1[i]=src1[i];
+            arg2[i]=src2[i];
+            arg3[i]=modVal[i];
+            out[i]=dest2[i];
+            if(!base10_64ModuloExponentiation(src1[i],src2[i],modVal[i],dest1[i],24))
+                generalTestException::throwException("Scalar exponentiation failed!",locString);
+        }
+
+        //Every width must match the scalar kernel, including a short final set
+        int widths[2]={1,hostWidth};
+        for(int w=0;w<2;++w)
+        {
+            base10_64SetBatchWidth(widths[w]);
+            for(int count=20;count>=17;count-=3)
+            {
+                memset(dest2,0,sizeof(dest2));
+                if(!base10_64BatchModuloExponentiation(arg1,arg2,arg3,out,count,24))
+                {
+                    base10_64SetBatchWidth(hostWidth);
+                    generalTestException::throwException("Batch exponentiation failed!",locString);
+                }
+                for(int i=0;i<count;++i)
+                {
+                    if(memcmp(dest1[i],dest2[i],sizeof(uint32_t)*24)!=0)
+                    {
+                        base10_64SetBatchWidth(hostWidth);
+                        generalTestException::throwException("Batch comparison failed!",locString);
+                    }
+                }
+            }
+        }
+        base10_64SetBatchWidth(hostWidth);
+	}
 
 /*================================================================
 	C Test Suites
@@ -1031,13 +2417,32 @@ using namespace crypto;
         pushTest("Right Shift",&base10rightShiftTest);
         pushTest("Left Shift",&base10leftShiftTest);
         pushTest("Multiplication",&base10multiplicationTest);
+        pushTest("Full Multiplication",&base10fullMultiplicationTest);
+        pushTest("Karatsuba Multiplication",&base10karatsubaMultiplicationTest);
+        pushTest("Square",&base10squareTest);
+        pushTest("Sized Kernels",&base10SizedKernelTest);
         pushTest("Division",&base10divisionTest);
 		pushTest("Modulo",&base10moduloTest);
+		pushTest("Division with Remainder",&base10divmodTest);
 		pushTest("Exponentiation",&base10exponentiationTest);
 		pushTest("Modular Exponentiation",&base10modularExponentiationTest);
+		pushTest("Montgomery Exponentiation",&base10montgomeryExponentiationTest);
+		pushTest("Barrett Reduction",&base10BarrettReductionTest);
 		pushTest("GCD",&base10GCDTest);
 		pushTest("Modular Inverse",&base10ModularInverseTest);
+		pushTest("Binary GCD",&base10BinaryGCDTest);
+		pushTest("Batch Modular Inverse",&base10BatchModInverseTest);
+		pushTest("Fused Modular Operations",&base10ModMultiplyTest);
 		pushTest("Prime Testing",&base10PrimealityTest);
+		pushTest("Prime Sieve",&base10PrimeSieveTest);
+		pushTest("Baillie-PSW",&base10BPSWPrimeTest);
+		pushTest("Workspace",&base10WorkspaceTest);
+		pushTest("Limb Pool",&base10LimbPoolTest);
+		pushTest("64-bit Number Type",&base10_64TypeTest);
+		pushTest("64-bit Kernels",&base10_64KernelTest);
+		pushTest("64-bit Montgomery",&base10_64MontgomeryTest);
+		pushTest("64-bit Kernel Tiers",&base10_64KernelTierTest);
+		pushTest("64-bit Batch Exponentiation",&base10_64BatchTest);
     }
 
 #endif
@@ -0,0 +1,165 @@
+/**
+ * This file implements the benchmark suite.
+ * Timings are written to testout so they can
+ * be compared between builds, a benchmark only
+ * fails if the two versions disagree.
+ *
+ */
+
+///@cond INTERNAL
+
+#ifndef CRYPTO_BENCHMARK_CPP
+#define CRYPTO_BENCHMARK_CPP
+
+#include "../cryptoConstants.h"
+#include "cryptoBenchmark.h"
+#include <string>
+#include <vector>
+#include <chrono>
+
+using namespace test;
+using namespace os;
+using namespace crypto;
+
+    //Average microseconds of one call, op receives the call index
+    template<class OP>
+    static double benchmarkMicros(OP op, int iterations)
+    {
+        auto start=std::chrono::steady_clock::now();
+        for(int i=0;i<iterations;++i)
+            op(i);
+        return std::chrono::duration<double,std::micro>(std::chrono::steady_clock::now()-start).count()/iterations;
+    }
+    //Fill the low words of a length-long number
+    static void benchmarkRandom(uint32_t* dest, uint16_t words, uint16_t length)
+    {
+        memset(dest,0,sizeof(uint32_t)*length);
+        for(uint16_t j=0;j<words;j++)
+            dest[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+    }
+
+    //Binary GCD and inverse against the Euclidean versions
+    void base10GCDBenchmark()
+    {
+        std::string locString = "cryptoBenchmark.cpp, base10GCDBenchmark()";
+        const int samples=16;
+        srand(7);
+
+        for(uint16_t bits=1024;bits<=2048;bits*=2)
+        {
+            uint16_t words=bits/32;
+            uint16_t length=2*words;
+            std::vector<uint32_t> src1(samples*length);
+            std::vector<uint32_t> src2(samples*length);
+            std::vector<uint32_t> dest1(samples*length);
+            std::vector<uint32_t> dest2(samples*length);
+            for(int i=0;i<samples;i++)
+            {
+                benchmarkRandom(&src1[i*length],words,length);
+                benchmarkRandom(&src2[i*length],words,length);
+                src2[i*length]|=1;
+            }
+
+            double binary=benchmarkMicros([&](int i){base10GCD(&src1[i*length],&src2[i*length],&dest1[i*length],length);},samples);
+            double euclid=benchmarkMicros([&](int i){base10EuclidGCD(&src1[i*length],&src2[i*length],&dest2[i*length],length);},samples);
+            if(dest1!=dest2)
+                generalTestException::throwException("GCD mismatch!",locString);
+            testout<<bits<<"-bit gcd: "<<binary<<" us, Euclidean "<<euclid<<" us"<<std::endl;
+
+            std::vector<int> found1(samples);
+            std::vector<int> found2(samples);
+            binary=benchmarkMicros([&](int i){found1[i]=base10ModInverse(&src1[i*length],&src2[i*length],&dest1[i*length],length);},samples);
+            euclid=benchmarkMicros([&](int i){found2[i]=base10EuclidModInverse(&src1[i*length],&src2[i*length],&dest2[i*length],length);},samples);
+            for(int i=0;i<samples;i++)
+            {
+                if(found1[i]!=found2[i] || (found1[i] && memcmp(&dest1[i*length],&dest2[i*length],sizeof(uint32_t)*length)))
+                    generalTestException::throwException("Modular inverse mismatch!",locString);
+            }
+            testout<<bits<<"-bit inverse: "<<binary<<" us, Euclidean "<<euclid<<" us"<<std::endl;
+        }
+
+        //e against an even phi, as in RSA key generation
+        uint16_t length=128;
+        uint32_t e[128];
+        uint32_t phi[128];
+        uint32_t dest1[128];
+        uint32_t dest2[128];
+        memset(e,0,sizeof(e));
+        e[0]=65537;
+        do
+        {
+            benchmarkRandom(phi,64,length);
+            phi[0]&=~((uint32_t)1);
+        } while(!base10EuclidModInverse(e,phi,dest2,length));
+        double binary=benchmarkMicros([&](int){base10ModInverse(e,phi,dest1,length);},samples);
+        double euclid=benchmarkMicros([&](int){base10EuclidModInverse(e,phi,dest2,length);},samples);
+        if(memcmp(dest1,dest2,sizeof(dest1)))
+            generalTestException::throwException("Even modulus inverse mismatch!",locString);
+        testout<<"65537 mod 2048-bit even phi: "<<binary<<" us, Euclidean "<<euclid<<" us"<<std::endl;
+    }
+    //Sieved prime search against testing every odd candidate
+    void base10PrimeSieveBenchmark()
+    {
+        std::string locString = "cryptoBenchmark.cpp, base10PrimeSieveBenchmark()";
+        const int samples=3;
+
+        //Prime sizes of public1024 and public2048, stored as RSAKeyGenerator stores them
+        for(uint16_t bits=512;bits<=1024;bits*=2)
+        {
+            uint16_t words=bits/32;
+            uint16_t length=4*words;
+            std::vector<uint32_t> start(samples*length);
+            std::vector<uint32_t> dest1(samples*length);
+            std::vector<uint32_t> dest2(samples*length);
+            std::vector<uint32_t> two(length);
+            two[0]=2;
+            srand(11);
+            for(int i=0;i<samples;i++)
+            {
+                benchmarkRandom(&start[i*length],words,length);
+                start[i*length]|=1;
+                start[i*length+words-1]|=((uint32_t)1)<<31;
+            }
+
+            //Sieved walk, as in base10NextPrime
+            double sieved=benchmarkMicros([&](int i){base10NextPrime(&start[i*length],&dest1[i*length],crypto_primetest_millerrabin,algo::primeTestCycle,length);},samples);
+            //Every odd candidate through Miller-Rabin alone, the search before the sieve
+            double rounds=benchmarkMicros([&](int i)
+            {
+                uint32_t* targ=&dest2[i*length];
+                memcpy(targ,&start[i*length],sizeof(uint32_t)*length);
+                while(!base10MillerRabin(targ,algo::primeTestCycle,length))
+                    base10Addition(targ,&two[0],targ,length);
+            },samples);
+            if(dest1!=dest2)
+                generalTestException::throwException("Prime search mismatch!",locString);
+            testout<<bits<<"-bit prime: sieved "<<sieved/1000<<" ms, Miller-Rabin only "<<rounds/1000<<" ms"<<std::endl;
+        }
+    }
+
+/*================================================================
+	Benchmark Suites
+ ================================================================*/
+
+    //Base-10 Benchmark Suite
+    C_BaseTenBenchmarkSuite::C_BaseTenBenchmarkSuite():
+        testSuite("Base-10 Benchmarks")
+    {
+        pushTest("Binary GCD",&base10GCDBenchmark);
+        pushTest("Prime Sieve",&base10PrimeSieveBenchmark);
+    }
+
+/*================================================================
+	CryptoGatewayBenchmarkTest
+ ================================================================*/
+
+    //Constructor
+    CryptoGatewayBenchmarkTest::CryptoGatewayBenchmarkTest():
+        libraryTests("CryptoGatewayBenchmarks")
+    {
+        pushSuite(os::smart_ptr<testSuite>(new C_BaseTenBenchmarkSuite(),os::shared_type));
+    }
+
+#endif
+
+///@endcond
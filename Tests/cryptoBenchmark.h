@@ -0,0 +1,43 @@
+/**
+ * This header declares the benchmark suite,
+ * which times the base-10 kernels against
+ * the implementations they replaced.  Each
+ * benchmark also confirms that both versions
+ * agree.  Benchmarks are not part of
+ * test::CryptoGatewayLibraryTest, they run
+ * only when test::CryptoGatewayBenchmarkTest
+ * is bound to the unit test driver.
+ *
+ */
+
+///@cond INTERNAL
+
+#ifndef CRYPTO_BENCHMARK_H
+#define CRYPTO_BENCHMARK_H
+
+#include "UnitTest/UnitTest.h"
+#include "../CryptoGateway.h"
+#include "../cryptoCHeaders.h"
+
+namespace test
+{
+    //CryptoGateway Benchmarks, opt-in
+    class CryptoGatewayBenchmarkTest: public libraryTests
+    {
+    public:
+        CryptoGatewayBenchmarkTest();
+        virtual ~CryptoGatewayBenchmarkTest(){}
+    };
+
+    //Base-10 Benchmark Suite
+    class C_BaseTenBenchmarkSuite: public testSuite
+    {
+    public:
+        C_BaseTenBenchmarkSuite();
+        virtual ~C_BaseTenBenchmarkSuite(){}
+    };
+}
+
+#endif
+
+///@endcond
@@ -12,6 +12,8 @@
 
 #include "cryptoTest.h"
 #include "../cryptoNumber.h"
+#include "../cryptoFixedKernels.h"
+#include "../cryptoIntegerExpression.h"
 
 using namespace test;
 using namespace os;
@@ -53,6 +55,8 @@ using namespace crypto;
             generalTestException::throwException("hasLeftShift failed",locString);
         if(num.hasMultiplication())
             generalTestException::throwException("hasMultiplication failed",locString);
+        if(num.hasSquare())
+            generalTestException::throwException("hasSquare failed",locString);
         if(num.hasDivision())
             generalTestException::throwException("hasDivision failed",locString);
         if(num.hasModulo())
@@ -380,6 +384,118 @@ using namespace crypto;
         generalTestException::throwException("Expansion 3 values wrong",locString);
     }
 
+    //Storage and move test
+    void numberStorageTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, numberStorageTest()";
+
+        //Inline numbers keep their storage through reduce and expand
+        number num(number::inlineLimbs);
+        const uint32_t* inlineData=num.data();
+        num[5]=7;
+        num.reduce();
+        num.expand(number::inlineLimbs);
+        if(num.data()!=inlineData || num.size()!=number::inlineLimbs || num[5]!=7 || num[6]!=0)
+            generalTestException::throwException("Inline storage moved",locString);
+
+        //Assignment re-uses storage which is large enough
+        number wide(number::inlineLimbs+1);
+        wide[number::inlineLimbs]=3;
+        const uint32_t* heapData=wide.data();
+        wide=num;
+        if(wide.data()!=heapData || wide!=num)
+            generalTestException::throwException("Assignment re-allocated",locString);
+
+        //Moves take heap storage and leave 0
+        number big(number::inlineLimbs*2);
+        big[number::inlineLimbs*2-1]=9;
+        heapData=big.data();
+        number moved(std::move(big));
+        if(moved.data()!=heapData || moved[number::inlineLimbs*2-1]!=9 || big.size()!=1 || big[0]!=0)
+            generalTestException::throwException("Move constructor failed",locString);
+        num=std::move(moved);
+        if(num.data()!=heapData || num.size()!=number::inlineLimbs*2 || moved.size()!=1)
+            generalTestException::throwException("Move assignment failed",locString);
+
+        //Inline moves copy, the source stays valid
+        integer small(4);
+        small[3]=5;
+        integer target(std::move(small));
+        if(target[3]!=5 || target.size()!=4 || target.data()==small.data())
+            generalTestException::throwException("Inline move failed",locString);
+        target=integer::two();
+        if(target!=integer::two())
+            generalTestException::throwException("Integer move assignment failed",locString);
+
+        //Storage past the inline limit is re-used from the thread's pool
+        {number warm(number::inlineLimbs*2);}
+        struct numberLimbPoolStats stats=numberLimbPoolStatistics();
+        {
+            number pooled(number::inlineLimbs*2);
+            pooled.expand(number::inlineLimbs*2);
+            if(numberLimbPoolStatistics().bytes<stats.bytes+sizeof(uint32_t)*number::inlineLimbs*2)
+                generalTestException::throwException("Pool bytes not counted",locString);
+        }
+        if(numberLimbPoolStatistics().heapAllocations!=stats.heapAllocations)
+            generalTestException::throwException("Pooled storage not re-used",locString);
+        if(numberLimbPoolStatistics().allocations!=stats.allocations+1 || numberLimbPoolStatistics().bytes!=stats.bytes)
+            generalTestException::throwException("Pool statistics wrong",locString);
+    }
+
+    //Compatibility bytes test
+    void numberBytesTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, numberBytesTest()";
+
+        //Lengths on either side of a block of swaps
+        uint8_t buffer[4*20+2];
+        for(uint16_t len=1;len<=20;++len)
+        {
+            number num(len+2);
+            for(uint16_t i=0;i<len;++i)
+                num[i]=((uint32_t)rand()^((uint32_t)rand()<<16))|1;
+
+            size_t refLen;
+            os::smart_ptr<unsigned char> ref=num.getCompCharData(refLen);
+            if(refLen!=4*(size_t)len || num.byteLength()!=refLen)
+                generalTestException::throwException("Byte length wrong",locString);
+            for(uint16_t i=0;i<len;++i)
+            {
+                uint32_t swtc=os::to_comp_mode(num[i]);
+                if(memcmp(ref.get()+4*i,&swtc,4)!=0)
+                    generalTestException::throwException("Compatibility bytes wrong",locString);
+            }
+
+            //Unaligned output, nothing past the bytes written
+            memset(buffer,0xEE,sizeof(buffer));
+            if(num.writeBytes(buffer+1,refLen-1)!=0)
+                generalTestException::throwException("Short buffer accepted",locString);
+            if(num.writeBytes(buffer+1,sizeof(buffer)-1)!=refLen || memcmp(buffer+1,ref.get(),refLen)!=0)
+                generalTestException::throwException("Written bytes wrong",locString);
+            if(refLen+1<sizeof(buffer) && buffer[refLen+1]!=0xEE)
+                generalTestException::throwException("Wrote past the bytes",locString);
+
+            number back(1);
+            back.assignBytes(buffer+1,refLen);
+            num.reduce();
+            if(back!=num || back.size()!=len)
+                generalTestException::throwException("Bytes did not round trip",locString);
+        }
+
+        //A partial uint32_t is zero-extended, storage is re-used
+        number num(4);
+        const uint32_t* data=num.data();
+        uint32_t word=os::to_comp_mode((uint32_t)0x00ABCDEF);
+        num.assignBytes((const uint8_t*) &word,3);
+        uint32_t part=0;
+        memcpy(&part,&word,3);
+        if(num.size()!=1 || num[0]!=os::from_comp_mode(part) || num.data()!=data)
+            generalTestException::throwException("Partial uint32_t wrong",locString);
+        num.assignBytes(NULL,0);
+        if(num.size()!=1 || num[0]!=0)
+            generalTestException::throwException("Empty bytes wrong",locString);
+    }
+
     //OR Test
     void numberORTest()
     {
@@ -615,6 +731,8 @@ using namespace crypto;
             generalTestException::throwException("hasLeftShift failed",locString);
         if(!num.hasMultiplication())
             generalTestException::throwException("hasMultiplication failed",locString);
+        if(!num.hasSquare())
+            generalTestException::throwException("hasSquare failed",locString);
         if(!num.hasDivision())
             generalTestException::throwException("hasDivision failed",locString);
         if(!num.hasModulo())
@@ -941,6 +1059,243 @@ using namespace crypto;
                 generalTestException::throwException("Op= failed",locString);
         }
     }
+    //Integer square test
+    void integerSquareTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerSquareTest()";
+        integer int1;
+        const struct numberType* nt=int1.numberDefinition();
+
+        //Run compare tests, 20 iterations
+        for(int i=0;i<20;++i)
+        {
+            integer src1;
+            integer src2;
+            integer ans1;
+            integer ans2;
+            integer ans3;
+            generateIntegers(src1, src2);
+            ans1=src1;
+
+            //Preform 3 versions
+            nt->square(src1.data(),ans1.data(),src1.size());
+            src1.number::square(&ans2);
+            ans3=src1.square();
+
+            //ans1 is the ref value
+            if(ans1!=ans2)
+                generalTestException::throwException("OO function failed!",locString);
+            if(ans1!=ans3)
+                generalTestException::throwException("OO square failed!",locString);
+            if(ans1!=src1*src1)
+                generalTestException::throwException("Multiplication mismatch!",locString);
+        }
+    }
+    //Integer double-width multiplication test
+    void integerMultiplyFullTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerMultiplyFullTest()";
+
+        for(int i=0;i<20;++i)
+        {
+            //Every limb set, so the '*' operator would overflow
+            integer src1(4+i%9);
+            integer src2(3+i%6);
+            for(uint16_t j=0;j<src1.size();++j)
+                src1[j]=((uint32_t)rand()^((uint32_t)rand()<<16))|1;
+            for(uint16_t j=0;j<src2.size();++j)
+                src2[j]=((uint32_t)rand()^((uint32_t)rand()<<16))|1;
+
+            integer wide1(src1);
+            integer wide2(src2);
+            wide1.expand(src1.size()+src2.size());
+            wide2.expand(src1.size()+src2.size());
+            integer full=src1.multiplyFull(src2);
+            if(full.size()!=src1.size()+src2.size())
+                generalTestException::throwException("Wrong size!",locString);
+            if(full!=wide1*wide2 || src2.multiplyFull(src1)!=full)
+                generalTestException::throwException("Product mismatch!",locString);
+
+            wide1.expand(2*src1.size()+src2.size());
+            full=src1.multiplyFull(src1);
+            if(full.size()!=2*src1.size() || full!=wide1.square())
+                generalTestException::throwException("Square mismatch!",locString);
+        }
+
+        //The all-ones case carries into the top limb
+        integer ones(4);
+        for(int j=0;j<4;++j)
+            ones[j]=0xFFFFFFFF;
+        integer full=ones.multiplyFull(ones);
+        if(full[7]!=0xFFFFFFFF || full[6]!=0xFFFFFFFF || full[4]!=0xFFFFFFFE || full[0]!=1)
+            generalTestException::throwException("All-ones product wrong!",locString);
+    }
+    //Integer mixed size test
+    void integerMixedSizeTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerMixedSizeTest()";
+        const struct numberType* nt=integer().numberDefinition();
+
+        //Run compare tests, 20 iterations
+        for(int i=0;i<20;++i)
+        {
+            //A short value and a padded value
+            integer src1(4);
+            integer src2(32);
+            for(int j=0;j<4;++j)
+                src1[j]=rand();
+            for(int j=0;j<12;++j)
+                src2[j]=rand();
+            integer wide1=src1;
+            wide1.expand(32);
+
+            //Padded reference values
+            integer ans(32);
+            nt->addition(wide1.data(),src2.data(),ans.data(),32);
+            if(src1+src2!=ans || src2+src1!=ans)
+                generalTestException::throwException("Addition failed!",locString);
+            nt->subtraction(src2.data(),wide1.data(),ans.data(),32);
+            if(src2-src1!=ans)
+                generalTestException::throwException("Subtraction failed!",locString);
+            nt->multiplication(wide1.data(),src2.data(),ans.data(),32);
+            if(src1*src2!=ans || src2*src1!=ans)
+                generalTestException::throwException("Multiplication failed!",locString);
+            nt->square(src2.data(),ans.data(),32);
+            if(src2.square()!=ans)
+                generalTestException::throwException("Square failed!",locString);
+            nt->leftShift(src2.data(),100,ans.data(),32);
+            if((src2<<100u)!=ans)
+                generalTestException::throwException("Left shift failed!",locString);
+            nt->modulo(src2.data(),wide1.data(),ans.data(),32);
+            if(src2%src1!=ans)
+                generalTestException::throwException("Modulo failed!",locString);
+            if(src1.compare(&src2)!=-1 || src2.compare(&src1)!=1 || src1.compare(&wide1)!=0)
+                generalTestException::throwException("Compare failed!",locString);
+
+            //The short value grows in place
+            integer acc=src1;
+            acc+=src2;
+            acc-=src2;
+            if(acc!=src1 || acc.size()!=32)
+                generalTestException::throwException("Op= failed!",locString);
+        }
+    }
+    //Integer expression template test
+    void integerExpressionTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerExpressionTest()";
+
+        for(int i=0;i<20;++i)
+        {
+            integer src1(4);
+            integer src2(32);
+            integer src3(8);
+            for(int j=0;j<4;++j)
+                src1[j]=rand();
+            for(int j=0;j<12;++j)
+                src2[j]=rand();
+            for(int j=0;j<3;++j)
+                src3[j]=rand();
+
+            //Expressions match the operators, size included
+            integer ans=lazy(src2)+src1-src3;
+            if(ans!=src2+src1-src3 || ans.size()!=32)
+                generalTestException::throwException("Addition chain failed!",locString);
+            ans=lazy(src1)*src3+src2;
+            if(ans!=src1*src3+src2 || ans.size()!=32)
+                generalTestException::throwException("Multiply-add failed!",locString);
+            ans=src2-lazy(src3)*src1;
+            if(ans!=src2-src3*src1)
+                generalTestException::throwException("Integer on the left failed!",locString);
+            ans=(lazy(src2)<<100)+(lazy(src3)<<20);
+            if(ans!=(src2<<100u)+(src3<<20u))
+                generalTestException::throwException("Left shift failed!",locString);
+            ans=2u*lazy(src1)+1u;
+            if(ans!=src1+src1+integer::one() || ans.size()!=4)
+                generalTestException::throwException("Constant failed!",locString);
+
+            //(p-1)(q-1) from the full product
+            integer p(src1);
+            integer q(src3);
+            p[0]|=1;
+            q[0]|=1;
+            integer n=p.multiplyFull(q);
+            ans=lazy(n)-p-q+1u;
+            if(ans!=(p-integer::one()).multiplyFull(q-integer::one()))
+                generalTestException::throwException("Totient failed!",locString);
+        }
+
+        //Single limb constants
+        integer e=(lazy(1u)<<16u)+1u;
+        if(e.size()!=1 || e[0]!=65537)
+            generalTestException::throwException("Exponent failed!",locString);
+
+        //Underflow and overflow fail like the operators
+        integer small(4);
+        integer large(4);
+        small[0]=1;
+        large[1]=1;
+        integer fail=lazy(small)-large;
+        if(fail!=integer())
+            generalTestException::throwException("Underflow not caught!",locString);
+        integer ones(4);
+        for(int j=0;j<4;++j)
+            ones[j]=0xFFFFFFFF;
+        fail=lazy(ones)+1u;
+        integer product=lazy(ones)*ones;
+        if(fail!=integer() || product!=integer())
+            generalTestException::throwException("Overflow not caught!",locString);
+    }
+    //Integer fixed kernel test
+    void integerFixedKernelTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerFixedKernelTest()";
+        const struct numberType* nt=integer().numberDefinition();
+
+        //Every stored key size, full width so carries reach the top limb
+        for(uint16_t len=4;len<=128;len*=2)
+        {
+            for(int i=0;i<5;++i)
+            {
+                integer src1(len);
+                integer src2(len);
+                for(int j=0;j<len;++j)
+                {
+                    src1[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+                    src2[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+                }
+                src1[len-1]>>=1;
+                src2[len-1]>>=1;
+                if(src1<src2)
+                {
+                    integer tm=src1;
+                    src1=src2;
+                    src2=tm;
+                }
+
+                integer ans(len);
+                nt->addition(src1.data(),src2.data(),ans.data(),len);
+                if(src1+src2!=ans)
+                    generalTestException::throwException("Addition failed!",locString);
+                nt->subtraction(src1.data(),src2.data(),ans.data(),len);
+                if(src1-src2!=ans)
+                    generalTestException::throwException("Subtraction failed!",locString);
+                if(src1.compare(&src2)!=nt->compare(src1.data(),src2.data(),len) || src2.compare(&src1)!=nt->compare(src2.data(),src1.data(),len))
+                    generalTestException::throwException("Compare failed!",locString);
+                if(src1.compare(&src1)!=0 || fixedKernel<4>::compare(src1.data(),src2.data(),4)!=nt->compare(src1.data(),src2.data(),4))
+                    generalTestException::throwException("Low limb compare failed!",locString);
+            }
+
+            //Overflow and underflow are errors
+            integer full(len);
+            for(int j=0;j<len;++j)
+                full[j]=0xFFFFFFFF;
+            integer one(len);
+            one[0]=1;
+            if(full+one!=integer() || one-full!=integer())
+                generalTestException::throwException("Overflow failed!",locString);
+        }
+    }
     //Integer division test
     void integerDivisionTest()
     {
@@ -1037,6 +1392,45 @@ using namespace crypto;
                 generalTestException::throwException("Op= failed",locString);
         }
     }
+    //Integer division with remainder test
+    void integerDivModTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerDivModTest()";
+        integer int1;
+        const struct numberType* nt=int1.numberDefinition();
+
+        //Check if the integer target is valid
+        if(!int1.checkType())
+            generalTestException::throwException("Integer type check failed!",locString);
+
+        //Run compare tests, 20 iterations
+        for(int i=0;i<20;++i)
+        {
+            integer src1;
+            integer src2;
+            integer quot1;
+            integer rem1;
+            integer quot2;
+            integer rem2;
+            integer rem3;
+            generateIntegers(src1, src2);
+            quot1=src1;
+            rem1=src1;
+
+            //Preform 3 versions
+            nt->divmod(src1.data(),src2.data(),quot1.data(),rem1.data(),src1.size());
+            src1.number::divmod(&src2,&quot2,&rem2);
+            integer ans=src1.divmod(src2,rem3);
+
+            //Reference is the separate operators
+            if(quot1!=src1/src2 || rem1!=src1%src2)
+                generalTestException::throwException("Kernel failed!",locString);
+            if(quot1!=quot2 || rem1!=rem2)
+                generalTestException::throwException("OO function failed!",locString);
+            if(quot1!=ans || rem1!=rem3)
+                generalTestException::throwException("OO operator failed!",locString);
+        }
+    }
     //Integer exponentiation test
     void integerExponentiationTest()
     {
@@ -1141,6 +1535,186 @@ using namespace crypto;
                 generalTestException::throwException("Op= failed",locString);
         }
     }
+    //Montgomery reducer test
+    void integerMontgomeryReducerTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerMontgomeryReducerTest()";
+        integer int1;
+        integer int2;
+
+        //Even modulus is not valid
+        int1[0]=10;
+        montgomeryReducer even(int1);
+        if(even.valid())
+            generalTestException::throwException("Even modulus valid!",locString);
+
+        //Run compare tests, 20 iterations
+        for(int i=0;i<20;++i)
+        {
+            integer src1;
+            integer src2;
+            integer src3;
+            generateIntegers(src1, src2);
+            generateIntegers(src2,src3);
+            src3[0]|=1;
+
+            montgomeryReducer red(src3);
+            montgomeryReducer cpy(red);
+            if(!red.valid() || !cpy.valid() || red.modulus()!=src3)
+                generalTestException::throwException("Construction failed!",locString);
+
+            integer ans1=src1.moduloExponentiation(src2,src3);
+            if(ans1!=src1.moduloExponentiation(src2,red))
+                generalTestException::throwException("Reducer failed!",locString);
+            if(ans1!=cpy.moduloExponentiation(src1,src2))
+                generalTestException::throwException("Copied reducer failed!",locString);
+
+            //Re-use with a second base
+            ans1=src2.moduloExponentiation(src1,src3);
+            if(ans1!=src2.moduloExponentiation(src1,red))
+                generalTestException::throwException("Re-use failed!",locString);
+        }
+    }
+    //Barrett reducer test
+    void integerBarrettReducerTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerBarrettReducerTest()";
+
+        //Zero modulus is not valid
+        integer int1;
+        barrettReducer zero(int1);
+        if(zero.valid())
+            generalTestException::throwException("Zero modulus valid!",locString);
+
+        //Run compare tests, 20 iterations
+        for(int i=0;i<20;++i)
+        {
+            integer src1;
+            integer src2;
+            integer src3;
+            generateIntegers(src1, src2);
+            generateIntegers(src2,src3);
+            src1=src1*src2;
+            if(i%2) src3[0]&=~((uint32_t)1);
+
+            barrettReducer red(src3);
+            barrettReducer cpy(red);
+            if(!red.valid() || !cpy.valid() || red.modulus()!=src3)
+                generalTestException::throwException("Construction failed!",locString);
+
+            integer ans1=src1%src3;
+            if(ans1!=src1%red)
+                generalTestException::throwException("Reducer failed!",locString);
+            if(ans1!=cpy.reduce(src1))
+                generalTestException::throwException("Copied reducer failed!",locString);
+
+            //Re-use with a second argument
+            ans1=src2%src3;
+            src2%=red;
+            if(ans1!=src2)
+                generalTestException::throwException("Re-use failed!",locString);
+        }
+    }
+    //Number definition test
+    void integerDefinitionTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerDefinitionTest()";
+
+        if(integer::defaultDefinition()!=buildBaseTenType())
+            generalTestException::throwException("Unexpected default definition!",locString);
+
+        //Non base-10 definitions are rejected
+        integer num;
+        num.setDefinition(buildNullNumberType());
+        integer::setDefaultDefinition(buildNullNumberType());
+        if(num.numberDefinition()!=buildBaseTenType() || integer::defaultDefinition()!=buildBaseTenType())
+            generalTestException::throwException("Null definition accepted!",locString);
+
+        //64-bit limbs match base-10 results
+        for(int i=0;i<20;++i)
+        {
+            integer src1;
+            integer src2;
+            integer src3;
+            generateIntegers(src1, src2);
+            generateIntegers(src2,src3);
+            src3[0]|=1;
+
+            integer wide1(src1);
+            integer wide2(src2);
+            integer wide3(src3);
+            wide1.setDefinition(buildBaseTen64Type());
+            wide3.setDefinition(buildBaseTen64Type());
+            if(wide1.numberDefinition()!=buildBaseTen64Type() || wide1!=src1 || !wide1.checkType())
+                generalTestException::throwException("Re-bind failed!",locString);
+
+            if(wide1*wide2!=src1*src2)
+                generalTestException::throwException("Multiplication failed!",locString);
+            if(wide1.square()!=src1.square())
+                generalTestException::throwException("Square failed!",locString);
+            if(wide1/src3!=src1/src3 || wide1%src3!=src1%src3)
+                generalTestException::throwException("Division failed!",locString);
+
+            integer ans1=src1.moduloExponentiation(src2,src3);
+            if(wide1.moduloExponentiation(wide2,wide3)!=ans1)
+                generalTestException::throwException("Modulo exponentiation failed!",locString);
+            montgomeryReducer red(wide3);
+            if(!red.valid() || red.context()->length!=0 || red.context64()->length==0)
+                generalTestException::throwException("64-bit reducer not built!",locString);
+            if(src1.moduloExponentiation(src2,red)!=ans1)
+                generalTestException::throwException("64-bit reducer failed!",locString);
+        }
+
+        //Global selection
+        integer::setDefaultDefinition(buildBaseTen64Type());
+        integer wide;
+        integer wideSize(4);
+        bool good=(wide.numberDefinition()==buildBaseTen64Type() && wideSize.numberDefinition()==buildBaseTen64Type());
+        integer::setDefaultDefinition(buildBaseTenType());
+        if(!good)
+            generalTestException::throwException("Default definition not bound!",locString);
+        if(integer().numberDefinition()!=buildBaseTenType())
+            generalTestException::throwException("Default definition not restored!",locString);
+    }
+    //Batched modulo exponentiation test
+    void integerBatchModExpTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerBatchModExpTest()";
+
+        //Mixed sizes, the batch is widened to the largest
+        std::vector<integer> bases;
+        std::vector<integer> exps;
+        std::vector<integer> mods;
+        for(int i=0;i<12;++i)
+        {
+            integer src1;
+            integer src2;
+            integer src3;
+            generateIntegers(src1, src2);
+            generateIntegers(src2,src3);
+            if(i%4!=2) src3[0]|=1;
+            if(i%3==0) src1.expand(16);
+            bases.push_back(src1);
+            exps.push_back(src2);
+            mods.push_back(src3);
+        }
+
+        std::vector<integer> ret=integer::batchModuloExponentiation(bases,exps,mods);
+        if(ret.size()!=bases.size())
+            generalTestException::throwException("Wrong batch size!",locString);
+        for(size_t i=0;i<ret.size();++i)
+        {
+            if(ret[i]!=bases[i].moduloExponentiation(exps[i],mods[i]))
+                generalTestException::throwException("Batch comparison failed!",locString);
+        }
+
+        //Mismatched vectors are rejected
+        mods.pop_back();
+        if(integer::batchModuloExponentiation(bases,exps,mods).size()!=0)
+            generalTestException::throwException("Mismatched batch accepted!",locString);
+        if(integer::batchModuloExponentiation(std::vector<integer>(),std::vector<integer>(),std::vector<integer>()).size()!=0)
+            generalTestException::throwException("Empty batch failed!",locString);
+    }
     //Integer gcd test
     void integerGCDTest()
     {
@@ -1238,6 +1812,121 @@ using namespace crypto;
                 generalTestException::throwException("Op= failed",locString);
         }
     }
+    //Fused modular operations test
+    void integerFusedModTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerFusedModTest()";
+
+        for(int i=0;i<20;++i)
+        {
+            //Wide enough that the reference products do not truncate
+            integer a(16);
+            integer b(i%2 ? 4 : 8);
+            integer c(6);
+            integer m(i%3 ? 4 : 8);
+            for(int j=0;j<4;++j)
+            {
+                a[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+                b[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+                c[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+                m[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            }
+            a[7]=(uint32_t)rand();
+            barrettReducer red(m);
+
+            integer ans=(a*b)%m;
+            integer dest;
+            if(dest.mulMod(a,b,m)!=ans || dest.mulMod(a,b,red)!=ans)
+                generalTestException::throwException("Modular multiplication failed!",locString);
+            ans=a.square()%m;
+            if(dest.sqrMod(a,m)!=ans || dest.sqrMod(a,red)!=ans)
+                generalTestException::throwException("Modular square failed!",locString);
+            ans=(a*b+c)%m;
+            if(dest.mulAddMod(a,b,c,m)!=ans || dest.mulAddMod(a,b,c,red)!=ans)
+                generalTestException::throwException("Modular multiply and add failed!",locString);
+
+            //Subtraction wraps around the modulus
+            integer ra=a%m;
+            integer rc=c%m;
+            ans=ra>=rc ? ra-rc : ra+(m-rc);
+            if(dest.subMod(a,c,m)!=ans || dest.subMod(a,c,red)!=ans)
+                generalTestException::throwException("Modular subtraction failed!",locString);
+            ans=ans==integer() ? integer() : m-ans;
+            if(dest.subMod(c,a,m)!=ans || dest.subMod(c,a,red)!=ans)
+                generalTestException::throwException("Reversed subtraction failed!",locString);
+
+            //The destination may be an argument
+            ans=(a*a+a)%m;
+            dest=a;
+            dest.mulAddMod(dest,dest,dest,m);
+            if(dest!=ans)
+                generalTestException::throwException("Aliased multiply and add failed!",locString);
+            ans=(a*b)%m;
+            dest=m;
+            if(dest.mulMod(a,b,dest)!=ans)
+                generalTestException::throwException("Aliased modulus failed!",locString);
+        }
+
+        //Storage large enough is re-used
+        integer m(4);
+        m[0]=7919;
+        integer dest(number::inlineLimbs*2);
+        const uint32_t* data=dest.data();
+        dest.mulMod(integer::two(),integer::two(),m);
+        if(dest.data()!=data || dest[0]!=4)
+            generalTestException::throwException("Destination re-allocated!",locString);
+        if(dest.mulMod(integer::two(),integer::two(),integer())!=integer())
+            generalTestException::throwException("Zero modulus accepted!",locString);
+    }
+    //Integer batched mod inverse test
+    void integerBatchModInverseTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerBatchModInverseTest()";
+
+        //A prime modulus, so every non-zero entry has an inverse
+        integer mod(8);
+        for(int j=0;j<4;++j)
+            mod[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+        mod=mod.nextPrime();
+
+        std::vector<integer> nums;
+        std::vector<integer> ans;
+        for(int i=0;i<20;++i)
+        {
+            integer src(i%2 ? 4 : 8);
+            for(int j=0;j<4;++j)
+                src[j]=(uint32_t)rand()^((uint32_t)rand()<<16);
+            src[0]|=1;
+            nums.push_back(src);
+            ans.push_back(src.modInverse(mod));
+        }
+        std::vector<integer> inv(nums);
+        if(!integer::batchModInverse(inv,mod))
+            generalTestException::throwException("Batch inverse failed!",locString);
+        for(size_t i=0;i<nums.size();++i)
+        {
+            if(inv[i]!=ans[i] || inv[i].size()!=8)
+                generalTestException::throwException("Batch inverse mismatch!",locString);
+        }
+
+        //Entries without an inverse fall back to single inverses
+        inv=nums;
+        inv[7]=mod*integer::two();
+        if(integer::batchModInverse(inv,mod))
+            generalTestException::throwException("Multiple of the modulus inverted!",locString);
+        for(size_t i=0;i<nums.size();++i)
+        {
+            if(i!=7 && inv[i]!=ans[i])
+                generalTestException::throwException("Fallback mismatch!",locString);
+        }
+        if(inv[7]!=integer())
+            generalTestException::throwException("Fallback failed!",locString);
+
+        //Empty batches succeed
+        std::vector<integer> empty;
+        if(!integer::batchModInverse(empty,mod))
+            generalTestException::throwException("Empty batch failed!",locString);
+    }
     //Prime test
     void integerPrimeTest()
     {
@@ -1260,11 +1949,57 @@ using namespace crypto;
 
             //Preform 3 versions
             ans1=primeTest(src1.data(),crypto::algo::primeTestCycle,src1.size());
-            ans2=src1.prime();
+            ans2=src1.prime(crypto::algo::primeTestCycle,crypto::algo::primeTestMillerRabin);
 
             //ans1 is the ref value
             if(ans1!=ans2)
                 generalTestException::throwException("OO function failed!",locString);
+
+            //Default mode is Baillie-PSW
+            if(src1.prime()!=(base10BPSWTest(src1.data(),src1.size())==1))
+                generalTestException::throwException("Baillie-PSW mode failed!",locString);
+        }
+    }
+    //Integer next prime test
+    void integerNextPrimeTest()
+    {
+        std::string locString = "cryptoNumberTest.cpp, integerNextPrimeTest()";
+
+        //Run next prime tests, 10 iterations
+        for(int i=0;i<10;++i)
+        {
+            integer src1;
+            integer src2;
+            generateIntegers(src1, src2);
+
+            integer ans=src1.nextPrime();
+            if(ans<src1 || !ans.prime())
+                generalTestException::throwException("Next prime failed!",locString);
+
+            //Nothing in between is prime
+            for(integer trc=src1;trc<ans;++trc)
+            {
+                if(trc.prime())
+                    generalTestException::throwException("Prime skipped!",locString);
+            }
+
+            //Two interleaved searches cover the odd candidates
+            src1[0]|=1;
+            integer half1=src1.searchPrime(4,1000);
+            integer half2=(src1+integer::two()).searchPrime(4,1000);
+            integer first=half1<half2 ? half1 : half2;
+            if(first!=ans || !half1.prime() || !half2.prime())
+                generalTestException::throwException("Strided search failed!",locString);
+
+            //A resumed search reaches the same prime chunk by chunk
+            primeSearcher search(src1,4);
+            integer chunked;
+            for(int j=0;j<250 && chunked==integer();++j)
+                chunked=search.search(4);
+            if(chunked!=half1 || search.candidate()!=half1 || !search.valid())
+                generalTestException::throwException("Chunked search failed!",locString);
+            if((src1+integer::one()).searchPrime(2,100)!=integer() || src1.searchPrime(2,1)!=(src1==ans ? ans : integer()))
+                generalTestException::throwException("Empty range failed!",locString);
         }
     }
 
@@ -1283,6 +2018,8 @@ using namespace crypto;
         pushTest("To String",&numberToStringTest);
         pushTest("From String",&numberFromStringTest);
         pushTest("Size Manipulation",&numberSizeManipulation);
+        pushTest("Storage",&numberStorageTest);
+        pushTest("Compatibility Bytes",&numberBytesTest);
 
         pushTest("OR Operator",&numberORTest);
         pushTest("AND Operator",&numberANDTest);
@@ -1301,13 +2038,26 @@ using namespace crypto;
         pushTest("Right Shift",&integerRightShiftTest);
         pushTest("Left Shift",&integerLeftShiftTest);
         pushTest("Multiplication",&integerMultiplicationTest);
+        pushTest("Square",&integerSquareTest);
+        pushTest("Full Multiplication",&integerMultiplyFullTest);
+        pushTest("Mixed Sizes",&integerMixedSizeTest);
+        pushTest("Expression Templates",&integerExpressionTest);
+        pushTest("Fixed Kernels",&integerFixedKernelTest);
         pushTest("Division",&integerDivisionTest);
         pushTest("Modulo",&integerModuloTest);
+        pushTest("Division with Remainder",&integerDivModTest);
         pushTest("Exponentiation",&integerExponentiationTest);
         pushTest("Modulo Exponentiation",&integerModuloExponentiationTest);
+        pushTest("Montgomery Reducer",&integerMontgomeryReducerTest);
+        pushTest("Barrett Reducer",&integerBarrettReducerTest);
+        pushTest("Number Definition",&integerDefinitionTest);
+        pushTest("Batch Modulo Exponentiation",&integerBatchModExpTest);
         pushTest("GCD",&integerGCDTest);
         pushTest("Modulo Inverse",&integerModInverseTest);
+        pushTest("Batch Modulo Inverse",&integerBatchModInverseTest);
+        pushTest("Fused Modulo Operations",&integerFusedModTest);
         pushTest("Prime",&integerPrimeTest);
+        pushTest("Next Prime",&integerNextPrimeTest);
     }
 
 #endif
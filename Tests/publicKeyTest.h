@@ -291,12 +291,174 @@ namespace test
         }
         virtual ~publicKeySuite(){}
     };
+    //RSA number definition test
+    class RSANumberDefinitionTest:public singleTest
+    {
+        uint16_t publicLen;
+    public:
+        RSANumberDefinitionTest(uint16_t pl):singleTest("64-bit Limb Test: "+std::to_string((long long unsigned int)pl*32)){publicLen=pl;}
+        virtual ~RSANumberDefinitionTest(){}
+
+        void test()
+        {
+			std::string locString = "publicKeyTest.h, RSANumberDefinitionTest::test()";
+
+            try
+            {
+                os::smart_ptr<crypto::publicRSA> pk1=getStaticKeys<crypto::publicRSA>(publicLen,0);
+                if(pk1->numberDefinition()!=crypto::integer::defaultDefinition())
+                    throw os::smart_ptr<std::exception>(new generalTestException("Unexpected default definition",locString),os::shared_type);
+
+                crypto::integer n1(publicLen);
+                for(uint16_t i=0;i<publicLen-1;++i)
+                    n1[i]=rand();
+                crypto::integer en1=n1;
+                crypto::integer en2=n1;
+
+                //Same cipher text with either set of kernels
+                en1=*os::cast<crypto::integer,crypto::number>(pk1->encode(&en1));
+                pk1->setNumberDefinition(buildBaseTen64Type());
+                if(pk1->numberDefinition()!=buildBaseTen64Type())
+                    throw os::smart_ptr<std::exception>(new generalTestException("Definition not bound",locString),os::shared_type);
+                en2=*os::cast<crypto::integer,crypto::number>(pk1->encode(&en2));
+                if(en1!=en2)
+                    throw os::smart_ptr<std::exception>(new generalTestException("64-bit encode mismatch",locString),os::shared_type);
+                en2=*os::cast<crypto::integer,crypto::number>(pk1->decode(&en2));
+                if(en2!=n1)
+                    throw os::smart_ptr<std::exception>(new generalTestException("64-bit decode failed",locString),os::shared_type);
+
+                //NULL follows the integer default again
+                pk1->setNumberDefinition(NULL);
+                en1=*os::cast<crypto::integer,crypto::number>(pk1->decode(&en1));
+                if(en1!=n1 || pk1->numberDefinition()!=crypto::integer::defaultDefinition())
+                    throw os::smart_ptr<std::exception>(new generalTestException("Default decode failed",locString),os::shared_type);
+            }
+            catch(crypto::errorPointer ep){throw os::smart_ptr<std::exception>(new generalTestException(ep->what(),locString),os::shared_type);}
+            catch(os::smart_ptr<std::exception> e){throw e;}
+            catch(...){throw os::smart_ptr<std::exception>(new unknownException(locString),os::shared_type);}
+        }
+    };
+
+    //Batch encode test
+    class RSABatchEncodeTest:public singleTest
+    {
+        uint16_t publicLen;
+    public:
+        RSABatchEncodeTest(uint16_t pl):singleTest("Batch Encode Test: "+std::to_string((long long unsigned int)pl*32)){publicLen=pl;}
+        virtual ~RSABatchEncodeTest(){}
+
+        void test()
+        {
+			std::string locString = "publicKeyTest.h, RSABatchEncodeTest::test()";
+
+            try
+            {
+                os::smart_ptr<crypto::publicRSA> pk1=getStaticKeys<crypto::publicRSA>(publicLen,0);
+                os::smart_ptr<crypto::publicRSA> pk2=getStaticKeys<crypto::publicRSA>(publicLen,1);
+
+                //Enough codes to fill a set of lanes and leave a short one
+                std::vector<os::smart_ptr<crypto::number> > codes;
+                std::vector<os::smart_ptr<crypto::number> > keys;
+                for(int i=0;i<11;++i)
+                {
+                    os::smart_ptr<crypto::number> n1(new crypto::integer(publicLen),os::shared_type);
+                    for(uint16_t j=0;j<publicLen-1;++j)
+                        (*n1)[j]=rand();
+                    codes.push_back(n1);
+                    keys.push_back(i%2 ? pk2->getN() : pk1->getN());
+                }
+
+                std::vector<os::smart_ptr<crypto::number> > enc=crypto::publicRSA::batchEncode(codes,keys,publicLen);
+                if(enc.size()!=codes.size())
+                    throw os::smart_ptr<std::exception>(new generalTestException("Wrong batch size",locString),os::shared_type);
+                for(size_t i=0;i<codes.size();++i)
+                {
+                    os::smart_ptr<crypto::publicRSA> pk=i%2 ? pk2 : pk1;
+                    if(*enc[i]!=*pk->encode(codes[i]))
+                        throw os::smart_ptr<std::exception>(new generalTestException("Batch encode mismatch",locString),os::shared_type);
+                    if(*pk->decode(enc[i])!=*codes[i])
+                        throw os::smart_ptr<std::exception>(new generalTestException("Batch decode failed",locString),os::shared_type);
+                }
+
+                //Against a single key
+                enc=pk1->batchEncode(codes);
+                for(size_t i=0;i<codes.size();++i)
+                {
+                    if(*pk1->decode(enc[i])!=*codes[i])
+                        throw os::smart_ptr<std::exception>(new generalTestException("Key batch decode failed",locString),os::shared_type);
+                }
+
+                //Mismatched key count
+                keys.pop_back();
+                bool caught=false;
+                try{crypto::publicRSA::batchEncode(codes,keys,publicLen);}
+                catch(crypto::errorPointer ep){caught=true;}
+                if(!caught)
+                    throw os::smart_ptr<std::exception>(new generalTestException("Mismatched keys accepted",locString),os::shared_type);
+            }
+            catch(crypto::errorPointer ep){throw os::smart_ptr<std::exception>(new generalTestException(ep->what(),locString),os::shared_type);}
+            catch(os::smart_ptr<std::exception> e){throw e;}
+            catch(...){throw os::smart_ptr<std::exception>(new unknownException(locString),os::shared_type);}
+        }
+    };
+
+    //Threaded key generation test
+    class RSAGenerationThreadsTest:public singleTest
+    {
+        uint16_t threads;
+    public:
+        RSAGenerationThreadsTest(uint16_t th):singleTest("Generation Threads: "+std::to_string((long long unsigned int)th)){threads=th;}
+        virtual ~RSAGenerationThreadsTest(){}
+
+        void test()
+        {
+			std::string locString = "publicKeyTest.h, RSAGenerationThreadsTest::test()";
+
+            try
+            {
+                crypto::publicRSA key(crypto::size::public512);
+                while(key.generating()) os::sleep(50);
+                if(key.keyGenerationThreads()<1)
+                    throw os::smart_ptr<std::exception>(new generalTestException("No default threads",locString),os::shared_type);
+
+                key.setKeyGenerationThreads(threads);
+                if(key.keyGenerationThreads()!=threads)
+                    throw os::smart_ptr<std::exception>(new generalTestException("Thread count not set",locString),os::shared_type);
+                os::smart_ptr<crypto::number> oldN=key.getN();
+                key.generateNewKeys();
+                while(key.generating()) os::sleep(50);
+                if(!key.getN() || *key.getN()==*oldN)
+                    throw os::smart_ptr<std::exception>(new generalTestException("Keys not regenerated",locString),os::shared_type);
+
+                //The new pair must round trip
+                for(int i=0;i<5;++i)
+                {
+                    os::smart_ptr<crypto::number> code(new crypto::integer(crypto::size::public512),os::shared_type);
+                    for(uint16_t j=0;j<crypto::size::public512-1;++j)
+                        (*code)[j]=rand();
+                    if(*key.decode(key.encode(code))!=*code)
+                        throw os::smart_ptr<std::exception>(new generalTestException("Round trip failed",locString),os::shared_type);
+                }
+            }
+            catch(crypto::errorPointer ep){throw os::smart_ptr<std::exception>(new generalTestException(ep->what(),locString),os::shared_type);}
+            catch(os::smart_ptr<std::exception> e){throw e;}
+            catch(...){throw os::smart_ptr<std::exception>(new unknownException(locString),os::shared_type);}
+        }
+    };
+
     //Public key test suite
     class RSASuite:public publicKeySuite<crypto::publicRSA,crypto::integer>
     {
     public:
         RSASuite():publicKeySuite<crypto::publicRSA,crypto::integer>("RSA")
-        {}
+        {
+            pushTest(os::smart_ptr<singleTest>(new RSANumberDefinitionTest(crypto::size::public512),os::shared_type));
+            pushTest(os::smart_ptr<singleTest>(new RSANumberDefinitionTest(crypto::size::public2048),os::shared_type));
+            pushTest(os::smart_ptr<singleTest>(new RSABatchEncodeTest(crypto::size::public512),os::shared_type));
+            pushTest(os::smart_ptr<singleTest>(new RSABatchEncodeTest(crypto::size::public2048),os::shared_type));
+            pushTest(os::smart_ptr<singleTest>(new RSAGenerationThreadsTest(1),os::shared_type));
+            pushTest(os::smart_ptr<singleTest>(new RSAGenerationThreadsTest(4),os::shared_type));
+        }
         virtual ~RSASuite(){}
     };
 }
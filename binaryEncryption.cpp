@@ -183,9 +183,14 @@ namespace crypto {
 			output.write((char*)head,11);
 			if(!output.good()) throw errorPointer(new fileOpenError(),os::shared_type);
 
+			//One buffer holds the public key, then the random key
+			unsigned int arrayLen=publicKeyLock->size()*4;
+			if(_publicLockType==file::DOUBLE_LOCK) arrayLen=publicKeyLock->size()*8;
+			size_t arrSize=publicKeyLock->getN()->byteLength();
+			os::smart_ptr<unsigned char> randkey(new unsigned char[arrSize>arrayLen ? arrSize : arrayLen],os::shared_type_array);
+
 			//Output hash of public key
-			size_t arrSize;
-			os::smart_ptr<unsigned char> randkey=publicKeyLock->getN()->getCompCharData(arrSize);
+			publicKeyLock->getN()->writeBytes(randkey.get(),arrSize);
 			hash hsh=_streamAlgorithm->hashData(randkey.get(),arrSize);
 			//Output public key if encrypting with private key
 			if(_publicLockType==file::PUBLIC_UNLOCK)
@@ -196,10 +201,6 @@ namespace crypto {
 
 			//Generate key, and hash
 			srand((unsigned)time(NULL));
-			unsigned int arrayLen=publicKeyLock->size()*4;
-			if(_publicLockType==file::DOUBLE_LOCK) arrayLen=publicKeyLock->size()*8;
-			randkey=os::smart_ptr<unsigned char>(new unsigned char[arrayLen],os::shared_type_array);
-
 			memset(randkey.get(),0,arrayLen);
 			for(uint16_t i=0;i<(publicKeyLock->size()-1)*4;++i)
 				randkey[i]=rand();
@@ -279,15 +280,18 @@ namespace crypto {
 			output.write((char*)head,11);
 			if(!output.good()) throw errorPointer(new fileOpenError(),os::shared_type);
 
+			//One buffer holds the public key, then the random key
+			size_t arrSize=pubKey->byteLength();
+			size_t arrayLen=pkframe->keySize()*4;
+			os::smart_ptr<unsigned char> randkey(new unsigned char[arrSize>arrayLen ? arrSize : arrayLen],os::shared_type_array);
+
 			//Output hash of public key
-			size_t arrSize;
-			os::smart_ptr<unsigned char> randkey=pubKey->getCompCharData(arrSize);
+			pubKey->writeBytes(randkey.get(),arrSize);
 			hash hsh=_streamAlgorithm->hashData(randkey.get(),arrSize);
 			output.write((char*)hsh.data(),hsh.size());
 
 			//Generate key, and hash
 			srand((unsigned)time(NULL));
-			randkey=os::smart_ptr<unsigned char>(new unsigned char[pkframe->keySize()*4],os::shared_type_array);
 			memset(randkey.get(),0,pkframe->keySize()*4);
 			for(uint16_t i=0;i<(pkframe->keySize()-1)*4;++i)
 				randkey[i]=rand();
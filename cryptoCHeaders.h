@@ -2,6 +2,7 @@
 #define CRYPTO_C_HEADERS_H
 
 #include "C_Algorithms/c_BaseTen.h"
+#include "C_Algorithms/c_BaseTen64.h"
 #include "C_Algorithms/c_numberDefinitions.h"
 
 #endif
\ No newline at end of file
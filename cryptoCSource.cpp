@@ -11,5 +11,6 @@
 
 #include "C_Algorithms/c_numberDefinitions.c"
 #include "C_Algorithms/c_BaseTen.c"
+#include "C_Algorithms/c_BaseTen64.c"
 
 #endif
\ No newline at end of file
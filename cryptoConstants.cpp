@@ -33,12 +33,24 @@ namespace crypto
 		/** @brief Base-10 number type string ID
 		 */
 		const std::string Base10=std::string(crypto_numbername_base10);
+		/** @brief Base-10 64-bit limb number type string ID
+		 */
+		const std::string Base10_64=std::string(crypto_numbername_base10_64);
 	}
     namespace algo
     {
 		/** @brief Number of test cycle for prime test
 		 */
         const uint16_t primeTestCycle=20;
+		/** @brief Miller-Rabin prime test ID
+		 */
+        const uint16_t primeTestMillerRabin=crypto_primetest_millerrabin;
+		/** @brief Baillie-PSW prime test ID
+		 */
+        const uint16_t primeTestBPSW=crypto_primetest_bpsw;
+		/** @brief Prime test used by default
+		 */
+        const uint16_t primeTestMode=primeTestBPSW;
 
 		/** @brief NULL hash algorithm ID
 		 */
@@ -26,10 +26,14 @@ namespace crypto
 	{
 		extern const std::string Default;
 		extern const std::string Base10;
+		extern const std::string Base10_64;
 	}
     namespace algo
     {
         extern const uint16_t primeTestCycle;
+        extern const uint16_t primeTestMillerRabin;
+        extern const uint16_t primeTestBPSW;
+        extern const uint16_t primeTestMode;
 
         extern const uint16_t hashNULL;
         extern const uint16_t hashXOR;
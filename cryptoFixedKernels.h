@@ -0,0 +1,106 @@
+/**
+ * Base-10 kernels specialized at compile
+ * time for the limb counts of the fixed
+ * key sizes.  Each limb loop is unrolled
+ * by template recursion, so the compiler
+ * sees straight-line code for every size
+ * in crypto::size.
+ *
+ */
+
+#ifndef CRYPTO_FIXED_KERNELS_H
+#define CRYPTO_FIXED_KERNELS_H
+
+#include <stdint.h>
+
+namespace crypto
+{
+	///@cond INTERNAL
+
+	/** @brief Unrolled limb loop
+	 *
+	 * Processes limb I, then recurses to
+	 * limb I+1.  The specialization for I==N
+	 * ends the recursion.
+	 */
+	template<uint16_t I, uint16_t N>
+	struct fixedLimbLoop
+	{
+		//Carry chain addition, returns the carry
+		static inline uint64_t addition(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint64_t carry)
+		{
+			uint64_t tm=(uint64_t) src1[I]+(uint64_t) src2[I]+carry;
+			dest[I]=(uint32_t) tm;
+			return fixedLimbLoop<I+1,N>::addition(src1,src2,dest,tm>>32);
+		}
+		//Borrow chain subtraction, returns the borrow
+		static inline uint64_t subtraction(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint64_t borrow)
+		{
+			uint64_t tm=(uint64_t) src1[I]-(uint64_t) src2[I]-borrow;
+			dest[I]=(uint32_t) tm;
+			return fixedLimbLoop<I+1,N>::subtraction(src1,src2,dest,(tm>>32)&1);
+		}
+		//Compare from the most significant limb down
+		static inline int compare(const uint32_t* src1, const uint32_t* src2)
+		{
+			if(src1[N-1-I]!=src2[N-1-I])
+				return src1[N-1-I]>src2[N-1-I] ? 1 : -1;
+			return fixedLimbLoop<I+1,N>::compare(src1,src2);
+		}
+	};
+	template<uint16_t N>
+	struct fixedLimbLoop<N,N>
+	{
+		static inline uint64_t addition(const uint32_t*, const uint32_t*, uint32_t*, uint64_t carry) {return carry;}
+		static inline uint64_t subtraction(const uint32_t*, const uint32_t*, uint32_t*, uint64_t borrow) {return borrow;}
+		static inline int compare(const uint32_t*, const uint32_t*) {return 0;}
+	};
+
+	///@endcond
+
+	/** @brief Fixed-size base-10 kernels
+	 *
+	 * Matches base10Addition, base10Subtraction
+	 * and standardCompare for arrays of exactly
+	 * N uint32_t.  The trailing length argument
+	 * of each kernel is unused, it is always N.
+	 */
+	template<uint16_t N>
+	struct fixedKernel
+	{
+		/** @brief Addition
+		 *
+		 * @param [in] src1 Argument 1
+		 * @param [in] src2 Argument 2
+		 * @param [out] dest Output
+		 * @return 1 if success, 0 on overflow
+		 */
+		static int addition(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t)
+		{
+			return !fixedLimbLoop<0,N>::addition(src1,src2,dest,0);
+		}
+		/** @brief Subtraction
+		 *
+		 * @param [in] src1 Argument 1
+		 * @param [in] src2 Argument 2
+		 * @param [out] dest Output
+		 * @return 1 if success, 0 if src2>src1
+		 */
+		static int subtraction(const uint32_t* src1, const uint32_t* src2, uint32_t* dest, uint16_t)
+		{
+			return !fixedLimbLoop<0,N>::subtraction(src1,src2,dest,0);
+		}
+		/** @brief Compare
+		 *
+		 * @param [in] src1 Argument 1
+		 * @param [in] src2 Argument 2
+		 * @return 1 if src1>src2, -1 if src1<src2, 0 if equal
+		 */
+		static int compare(const uint32_t* src1, const uint32_t* src2, uint16_t)
+		{
+			return fixedLimbLoop<0,N>::compare(src1,src2);
+		}
+	};
+}
+
+#endif
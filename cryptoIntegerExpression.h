@@ -0,0 +1,227 @@
+/**
+ * Opt-in expression templates over
+ * crypto::integer.  Wrapping an operand
+ * in crypto::lazy makes +, -, * and <<
+ * build an expression instead of an integer.
+ * The whole expression is evaluated into a
+ * single result buffer when it is converted
+ * to an integer, with the right-hand operand
+ * of each node staged in the thread workspace.
+ *
+ * Results match the integer operators: each
+ * node is computed at the larger size of its
+ * operands.  An overflow or a negative
+ * difference in any node makes the whole
+ * expression evaluate to integer().
+ *
+ */
+
+#ifndef CRYPTO_INTEGER_EXPRESSION_H
+#define CRYPTO_INTEGER_EXPRESSION_H
+
+#include "cryptoNumber.h"
+#include "cryptoLogging.h"
+#include <string.h>
+
+namespace crypto
+{
+	/** @brief Integer expression base
+	 *
+	 * Curiously recurring base of every node in an
+	 * integer expression.  E must provide size(),
+	 * the limb count of the node's result, and
+	 * evaluate(), which writes that result.
+	 */
+	template<class E>
+	struct integerExpression
+	{
+		/** @brief Derived node
+		 * @return Reference to the node as E
+		 */
+		inline const E& self() const {return static_cast<const E&>(*this);}
+
+		/** @brief Evaluate the expression
+		 *
+		 * Builds one integer of the expression's
+		 * size and evaluates every node into it.
+		 * Leaves hold references to their integers,
+		 * so an expression should be converted within
+		 * the statement which builds it.
+		 *
+		 * @return Result, integer() on failure
+		 */
+		operator integer() const
+		{
+			integer ret(self().size());
+			if(!self().evaluate(ret.data(),ret.size()))
+			{
+				cryptoerr<<"Expression error!"<<std::endl;
+				return integer();
+			}
+			return ret;
+		}
+	};
+
+	///@cond INTERNAL
+
+	/** @brief Integer leaf
+	 *
+	 * References an integer operand.
+	 */
+	class integerTerm: public integerExpression<integerTerm>
+	{
+		const integer& _value;
+	public:
+		explicit integerTerm(const integer& value):_value(value){}
+		inline uint16_t size() const {return _value.size();}
+		//Copy the operand, zero extended to length
+		inline int evaluate(uint32_t* dest, uint16_t length) const
+		{
+			memcpy(dest,_value.data(),sizeof(uint32_t)*_value.size());
+			memset(dest+_value.size(),0,sizeof(uint32_t)*(length-_value.size()));
+			return 1;
+		}
+	};
+
+	/** @brief Constant leaf
+	 *
+	 * Single limb operand, the size of integer::one().
+	 */
+	class integerConstant: public integerExpression<integerConstant>
+	{
+		uint32_t _value;
+	public:
+		explicit integerConstant(uint32_t value):_value(value){}
+		inline uint16_t size() const {return 1;}
+		//Write the constant, zero extended to length
+		inline int evaluate(uint32_t* dest, uint16_t length) const
+		{
+			dest[0]=_value;
+			memset(dest+1,0,sizeof(uint32_t)*(length-1));
+			return 1;
+		}
+	};
+
+	//Node operations, dest holds the left operand and the result
+	struct integerAddition
+	{
+		static inline int apply(uint32_t* dest, const uint32_t* src, uint16_t length)
+			{return base10Addition(dest,src,dest,length);}
+	};
+	struct integerSubtraction
+	{
+		static inline int apply(uint32_t* dest, const uint32_t* src, uint16_t length)
+			{return base10Subtraction(dest,src,dest,length);}
+	};
+	struct integerMultiplication
+	{
+		static inline int apply(uint32_t* dest, const uint32_t* src, uint16_t length)
+			{return base10SizedMultiplication(dest,length,src,length,dest,length);}
+	};
+
+	/** @brief Binary node
+	 *
+	 * The left operand is evaluated in place in
+	 * the destination, the right operand in
+	 * workspace scratch.
+	 */
+	template<class L, class R, class OP>
+	class integerBinary: public integerExpression<integerBinary<L,R,OP> >
+	{
+		L _lhs;
+		R _rhs;
+		uint16_t _size;
+	public:
+		integerBinary(const L& lhs, const R& rhs):
+			_lhs(lhs),_rhs(rhs)
+		{
+			_size=_lhs.size()>_rhs.size() ? _lhs.size() : _rhs.size();
+		}
+		inline uint16_t size() const {return _size;}
+		//Evaluate at this node's size, then zero extend
+		int evaluate(uint32_t* dest, uint16_t length) const
+		{
+			uint32_t* scratch=numberWorkspacePush(_size);
+			int good=scratch && _lhs.evaluate(dest,_size);
+			if(good) good=_rhs.evaluate(scratch,_size);
+			if(good) good=OP::apply(dest,scratch,_size);
+			numberWorkspacePop(scratch);
+			memset(dest+_size,0,sizeof(uint32_t)*(length-_size));
+			return good;
+		}
+	};
+
+	/** @brief Left shift node
+	 *
+	 * Shifts in place, keeping the operand's size.
+	 */
+	template<class E>
+	class integerLeftShift: public integerExpression<integerLeftShift<E> >
+	{
+		E _operand;
+		uint16_t _bits;
+	public:
+		integerLeftShift(const E& operand, uint16_t bits):
+			_operand(operand),_bits(bits){}
+		inline uint16_t size() const {return _operand.size();}
+		//Evaluate at the operand's size, then zero extend
+		int evaluate(uint32_t* dest, uint16_t length) const
+		{
+			uint16_t len=_operand.size();
+			int good=_operand.evaluate(dest,len);
+			if(good) good=standardLeftShift(dest,_bits,dest,len);
+			memset(dest+len,0,sizeof(uint32_t)*(length-len));
+			return good;
+		}
+	};
+
+	//Binds an operator for every pairing of expression, integer and constant
+	#define CRYPTO_INTEGER_EXPRESSION_OPERATOR(OPERATOR,OPERATION) \
+	template<class L, class R> \
+	inline integerBinary<L,R,OPERATION> OPERATOR(const integerExpression<L>& lhs, const integerExpression<R>& rhs) \
+		{return integerBinary<L,R,OPERATION>(lhs.self(),rhs.self());} \
+	template<class L> \
+	inline integerBinary<L,integerTerm,OPERATION> OPERATOR(const integerExpression<L>& lhs, const integer& rhs) \
+		{return integerBinary<L,integerTerm,OPERATION>(lhs.self(),integerTerm(rhs));} \
+	template<class R> \
+	inline integerBinary<integerTerm,R,OPERATION> OPERATOR(const integer& lhs, const integerExpression<R>& rhs) \
+		{return integerBinary<integerTerm,R,OPERATION>(integerTerm(lhs),rhs.self());} \
+	template<class L> \
+	inline integerBinary<L,integerConstant,OPERATION> OPERATOR(const integerExpression<L>& lhs, uint32_t rhs) \
+		{return integerBinary<L,integerConstant,OPERATION>(lhs.self(),integerConstant(rhs));} \
+	template<class R> \
+	inline integerBinary<integerConstant,R,OPERATION> OPERATOR(uint32_t lhs, const integerExpression<R>& rhs) \
+		{return integerBinary<integerConstant,R,OPERATION>(integerConstant(lhs),rhs.self());}
+
+	CRYPTO_INTEGER_EXPRESSION_OPERATOR(operator+,integerAddition)
+	CRYPTO_INTEGER_EXPRESSION_OPERATOR(operator-,integerSubtraction)
+	CRYPTO_INTEGER_EXPRESSION_OPERATOR(operator*,integerMultiplication)
+
+	#undef CRYPTO_INTEGER_EXPRESSION_OPERATOR
+
+	//Left shift of an expression
+	template<class E>
+	inline integerLeftShift<E> operator<<(const integerExpression<E>& lhs, unsigned bits)
+		{return integerLeftShift<E>(lhs.self(),(uint16_t) bits);}
+
+	///@endcond
+
+	/** @brief Start an expression
+	 *
+	 * Arithmetic on the returned term builds an
+	 * expression rather than an integer.  For example,
+	 * lazy(n)-p-q+1u evaluates to (p-1)*(q-1) in the
+	 * buffer of the result.
+	 *
+	 * @param [in] value Operand, referenced until evaluation
+	 * @return Expression leaf
+	 */
+	inline integerTerm lazy(const integer& value) {return integerTerm(value);}
+	/** @brief Start an expression from a constant
+	 * @param [in] value Single limb operand
+	 * @return Expression leaf
+	 */
+	inline integerConstant lazy(uint32_t value) {return integerConstant(value);}
+}
+
+#endif
@@ -12,7 +12,13 @@
 
 #include "cryptoLogging.h"
 #include "cryptoNumber.h"
+#include "cryptoFixedKernels.h"
 #include "osMechanics/osMechanics.h"
+#include <atomic>
+#include <utility>
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #include <immintrin.h>
+#endif
 
 using namespace crypto;
 
@@ -25,7 +31,7 @@ using namespace crypto;
     {
         _numDef=numDef;
         _size = 1;
-        _data = new uint32_t[1];
+        allocate(1);
         _data[0]=0;
     }
     //Size constructor
@@ -35,7 +41,7 @@ using namespace crypto;
         _size=size;
         if(_size<1)_size=0;
 
-        _data = new uint32_t[_size];
+        allocate(_size);
         memset(_data,0,sizeof(uint32_t)*_size);
     }
     //Construct with data
@@ -45,7 +51,7 @@ using namespace crypto;
         _size=size;
         if(_size<1)_size=0;
 
-        _data = new uint32_t[_size];
+        allocate(_size);
         if(size<1)
             memset(_data,0,sizeof(uint32_t)*_size);
         else
@@ -56,24 +62,87 @@ using namespace crypto;
     {
         _numDef=num._numDef;
         _size=num._size;
-        _data = new uint32_t[_size];
+        allocate(_size);
         memcpy(_data, num._data, sizeof(uint32_t)*_size);
+    }
+    //Move constructor
+    number::number(number&& num) noexcept
+    {
+        _numDef=num._numDef;
+        _size=num._size;
+        if(num._data!=num._inline)
+        {
+            _data=num._data;
+            _capacity=num._capacity;
+            num._data=num._inline;
+            num._capacity=inlineLimbs;
+            num._size=1;
+            num._data[0]=0;
+        }
+        else
+        {
+            allocate(_size);
+            memcpy(_data, num._data, sizeof(uint32_t)*_size);
+        }
     }
 	//Copy number into self
 	number& number::operator=(const number& num)
 	{
 		if(&num!=this)
 		{
-			delete [] _data;
+			//Existing storage is re-used when it is large enough
+			if(num._size>_capacity)
+			{
+				release();
+				allocate(num._size);
+			}
 			_numDef=num._numDef;
 			_size=num._size;
-			_data = new uint32_t[_size];
 			memcpy(_data, num._data, sizeof(uint32_t)*_size);
 		}
 		return *this;
 	}
+	//Move number into self
+	number& number::operator=(number&& num) noexcept
+	{
+		if(&num==this) return *this;
+		if(num._data==num._inline) return *this=num;
+
+		release();
+		_numDef=num._numDef;
+		_size=num._size;
+		_data=num._data;
+		_capacity=num._capacity;
+		num._data=num._inline;
+		num._capacity=inlineLimbs;
+		num._size=1;
+		num._data[0]=0;
+		return *this;
+	}
     //Destructor
-    number::~number(){delete [] _data;}
+    number::~number(){release();}
+    //Point _data at storage for size uint32_t
+    void number::allocate(uint16_t size)
+    {
+        if(size<=inlineLimbs)
+        {
+            _data=_inline;
+            _capacity=inlineLimbs;
+        }
+        else
+        {
+            uint32_t cap;
+            _data=numberLimbAlloc(size,&cap);
+            _capacity=cap>0xFFFF ? 0xFFFF : (uint16_t) cap;
+        }
+    }
+    //Return pooled storage
+    void number::release()
+    {
+        if(_data!=_inline) numberLimbFree(_data);
+        _data=_inline;
+        _capacity=inlineLimbs;
+    }
 
 //Size manipulation----------------------------------------------
 
@@ -84,12 +153,6 @@ using namespace crypto;
         for(targ_size=_size-1;targ_size>0 && _data[targ_size]==0;targ_size--){}
 
         targ_size++;
-        if(targ_size==_size) return;
-
-        uint32_t* temp = new uint32_t[targ_size];
-        memcpy(temp, _data, sizeof(uint32_t)*targ_size);
-        delete [] _data;
-        _data =temp;
         _size = targ_size;
     }
     //Expand the size of a number
@@ -104,11 +167,16 @@ using namespace crypto;
         if(size==_size) return;
 
         //Preform expansion
-        uint32_t* temp = new uint32_t[size];
-        memset(temp,0,sizeof(uint32_t)*size);
-        memcpy(temp, _data, sizeof(uint32_t)*_size);
-        delete [] _data;
-        _data =temp;
+        if(size>_capacity)
+        {
+            uint32_t cap;
+            uint32_t* temp = numberLimbAlloc(size,&cap);
+            memcpy(temp, _data, sizeof(uint32_t)*_size);
+            release();
+            _data=temp;
+            _capacity=cap>0xFFFF ? 0xFFFF : (uint16_t) cap;
+        }
+        memset(_data+_size,0,sizeof(uint32_t)*(size-_size));
         _size = size;
     }
 
@@ -131,21 +199,124 @@ using namespace crypto;
 	//Return a compatibility version of the raw byte data
 	os::smart_ptr<unsigned char> number::getCompCharData(size_t& arr_len) const
 	{
-		uint32_t targ_size = _size;
-        for(targ_size=_size-1;targ_size>0 && _data[targ_size]==0;targ_size--){}
+		arr_len=byteLength();
+		os::smart_ptr<unsigned char> ret(new unsigned char[arr_len],os::shared_type_array);
+		writeBytes(ret.get(),arr_len);
+		return ret;
+	}
 
-        targ_size++;
+	//Layout of os::to_comp_mode on this host, found once
+	enum compLayout {compLayoutNative,compLayoutSwapped,compLayoutOther};
+	static int compModeLayout()
+	{
+		static const uint32_t probe=os::to_comp_mode((uint32_t) 0x01020304);
+		if(probe==0x01020304) return compLayoutNative;
+		if(probe==0x04030201) return compLayoutSwapped;
+		return compLayoutOther;
+	}
 
-		arr_len=targ_size*4;
-		os::smart_ptr<unsigned char> ret(new unsigned char[arr_len],os::shared_type_array);
-		memset(ret.get(), 0, arr_len);
-		for(unsigned int i=0;i<targ_size;++i)
+	//Reverse the bytes of each uint32_t, the arrays may be unaligned
+	static void swapWordBytes(const uint8_t* src, uint8_t* dest, size_t count)
+	{
+		for(size_t i=0;i<count;++i)
+		{
+			uint32_t tm;
+			memcpy(&tm,src+4*i,4);
+			tm=(tm>>24)|((tm>>8)&0xFF00)|((tm<<8)&0xFF0000)|(tm<<24);
+			memcpy(dest+4*i,&tm,4);
+		}
+	}
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+	//Four uint32_t per shuffle
+	__attribute__((target("ssse3"))) static void swapWordBytesSSSE3(const uint8_t* src, uint8_t* dest, size_t count)
+	{
+		const __m128i mask=_mm_set_epi8(12,13,14,15,8,9,10,11,4,5,6,7,0,1,2,3);
+		size_t i=0;
+		for(;i+4<=count;i+=4)
+			_mm_storeu_si128((__m128i*) (dest+4*i),_mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (src+4*i)),mask));
+		swapWordBytes(src+4*i,dest+4*i,count-i);
+	}
+	static bool hostSSSE3()
+	{
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("ssse3");
+	}
+#endif
+	//Convert count uint32_t between host and compatibility layout
+	static void convertCompWords(const uint8_t* src, uint8_t* dest, size_t count, bool toComp)
+	{
+		int layout=compModeLayout();
+		if(layout==compLayoutNative)
+			memcpy(dest,src,4*count);
+		else if(layout==compLayoutSwapped)
 		{
-			uint32_t swtc=os::to_comp_mode(_data[i]);
-			memcpy(ret.get()+i*4,&swtc,4);
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+			static const bool ssse3=hostSSSE3();
+			if(ssse3)
+			{
+				swapWordBytesSSSE3(src,dest,count);
+				return;
+			}
+#endif
+			swapWordBytes(src,dest,count);
 		}
+		else
+		{
+			for(size_t i=0;i<count;++i)
+			{
+				uint32_t tm;
+				memcpy(&tm,src+4*i,4);
+				tm=toComp ? os::to_comp_mode(tm) : os::from_comp_mode(tm);
+				memcpy(dest+4*i,&tm,4);
+			}
+		}
+	}
 
-		return ret;
+	//Significant uint32_t in compatibility bytes
+	size_t number::byteLength() const
+	{
+		uint16_t targ_size=_size;
+		while(targ_size>1 && _data[targ_size-1]==0) targ_size--;
+		if(targ_size==0) targ_size=1;
+		return 4*(size_t) targ_size;
+	}
+	//Write compatibility bytes into a caller buffer
+	size_t number::writeBytes(uint8_t* out, size_t cap) const
+	{
+		size_t len=byteLength();
+		if(cap<len) return 0;
+		if(_size==0) memset(out,0,len);
+		else convertCompWords((const uint8_t*) _data,out,len/4,true);
+		return len;
+	}
+	//Set from compatibility bytes
+	void number::assignBytes(const uint8_t* in, size_t len)
+	{
+		size_t targ_size=(len+3)/4;
+		if(targ_size==0) targ_size=1;
+		if(targ_size>0xFFFF)
+		{
+			cryptoerr<<"Byte array is too large for a number!"<<std::endl;
+			return;
+		}
+
+		if(targ_size>_capacity)
+		{
+			release();
+			allocate((uint16_t) targ_size);
+		}
+		_size=(uint16_t) targ_size;
+		if(len>=4) convertCompWords(in,(uint8_t*) _data,len/4,false);
+
+		//A partial uint32_t is zero-extended before conversion
+		if(len%4)
+		{
+			uint32_t tm=0;
+			memcpy(&tm,in+4*(len/4),len%4);
+			_data[len/4]=os::from_comp_mode(tm);
+		}
+		else if(len==0)
+			_data[0]=0;
 	}
 
 //To and from string---------------------------------------------
@@ -167,7 +338,7 @@ using namespace crypto;
     {
         //Reset everything
         _size=1;
-        delete [] _data;
+        release();
         uint16_t totLen=1;
         int groupLen=0;
 
@@ -181,7 +352,6 @@ using namespace crypto;
                 if(groupLen>8)
                 {
                     cryptoerr<<"Illegal number construction string!"<<std::endl;
-                    _data=new uint32_t[_size];
                     memset(_data,0,sizeof(uint32_t)*_size);
                     return;
                 }
@@ -196,7 +366,6 @@ using namespace crypto;
             else
             {
                 cryptoerr<<"Illegal number construction string!"<<std::endl;
-                _data=new uint32_t[_size];
                 memset(_data,0,sizeof(uint32_t)*_size);
                 return;
             }
@@ -204,7 +373,7 @@ using namespace crypto;
 
         //Build target array
         _size=totLen;
-        _data=new uint32_t[_size];
+        allocate(_size);
         memset(_data,0,sizeof(uint32_t)*_size);
         int strTrace = 0;
         for(uint16_t trc=_size;trc>0 && strTrace<str.length();trc--)
@@ -362,6 +531,55 @@ using namespace crypto;
 
 //Action Functions-----------------------------------------------
 
+    //Zero-extend an operand from the kernel workspace, only when it is short, NULL on failure
+    static const uint32_t* widenOperand(const uint32_t* src, uint16_t size, uint16_t targ_size)
+    {
+        if(size>=targ_size) return src;
+        uint32_t* ret=numberWorkspacePush(targ_size);
+        if(!ret) return NULL;
+        memcpy(ret,src,sizeof(uint32_t)*size);
+        memset(ret+size,0,sizeof(uint32_t)*(targ_size-size));
+        return ret;
+    }
+    //Return a widened operand to the kernel workspace
+    static void releaseOperand(const uint32_t* wide, const uint32_t* src)
+    {
+        if(wide!=src) numberWorkspacePop((uint32_t*) wide);
+    }
+
+    //Kernels unrolled for one key size
+    struct fixedKernelTable
+    {
+        operatorFunction addition;
+        operatorFunction subtraction;
+        compareFunction compare;
+    };
+    //Key sizes, stored doubled, from size::public128 to size::public2048
+    static const fixedKernelTable _fixedKernels[]=
+    {
+        {&fixedKernel<4>::addition,&fixedKernel<4>::subtraction,&fixedKernel<4>::compare},
+        {&fixedKernel<8>::addition,&fixedKernel<8>::subtraction,&fixedKernel<8>::compare},
+        {&fixedKernel<16>::addition,&fixedKernel<16>::subtraction,&fixedKernel<16>::compare},
+        {&fixedKernel<32>::addition,&fixedKernel<32>::subtraction,&fixedKernel<32>::compare},
+        {&fixedKernel<64>::addition,&fixedKernel<64>::subtraction,&fixedKernel<64>::compare},
+        {&fixedKernel<128>::addition,&fixedKernel<128>::subtraction,&fixedKernel<128>::compare}
+    };
+    //Fixed kernels for a base-10 layout of this length, NULL for other lengths
+    static const fixedKernelTable* fixedKernels(const struct numberType* def, uint16_t length)
+    {
+        if(def->typeID!=crypto_numbertype_base10) return NULL;
+        switch(length)
+        {
+            case 4: return &_fixedKernels[0];
+            case 8: return &_fixedKernels[1];
+            case 16: return &_fixedKernels[2];
+            case 32: return &_fixedKernels[3];
+            case 64: return &_fixedKernels[4];
+            case 128: return &_fixedKernels[5];
+            default: return NULL;
+        }
+    }
+
     //Raw compare
     int number::compare(const number* n2) const
     {
@@ -375,28 +593,27 @@ using namespace crypto;
             return ((long) this) - ((long) n2);
         }
 
-        //See if sizes need to be rectified
+        //Key-sized operands use the unrolled kernels
+        const fixedKernelTable* fixed=NULL;
+        if(_size==n2->_size && (fixed=fixedKernels(_numDef,_size)))
+            return fixed->compare(_data,n2->_data,_size);
+
+        //Compare significant limbs only
+        if(_numDef->sizedCompare)
+            return _numDef->sizedCompare(_data,_size,n2->_data,n2->_size);
         if(_size==n2->_size)
             return _numDef->compare(_data,n2->_data,_size);
 
         //Rectify sizes
-        const number* tn1=this;
-        const number* tn2=n2;
-        number temp;
-        if(tn1->_size>tn2->_size)
-        {
-            temp=number(tn2->_data,tn2->_size);
-            temp.expand(_size);
-            tn2=&temp;
-        }
-        else
-        {
-            temp=number(_data,_size);
-            temp.expand(tn2->_size);
-            tn1=&temp;
-        }
-
-        return _numDef->compare(tn1->_data,tn2->_data,_size);
+        uint16_t targ_size=_size>n2->_size ? _size : n2->_size;
+        const uint32_t* d1=widenOperand(_data,_size,targ_size);
+        const uint32_t* d2=widenOperand(n2->_data,n2->_size,targ_size);
+        int ret=0;
+        if(d1 && d2) ret=_numDef->compare(d1,d2,targ_size);
+        else cryptoerr<<"Compare error!"<<std::endl;
+        releaseOperand(d2,n2->_data);
+        releaseOperand(d1,_data);
+        return ret;
     }
     //Addition function
     void number::addition(const number* n2, number* result) const
@@ -415,30 +632,24 @@ using namespace crypto;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
         result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
 
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
-        if(targ_size>n2->_size)
+        //Equal key-sized operands use the unrolled kernels, then kernels which
+        //take each operand's size skip the zero padding, else operands are widened
+        bool good=true;
+        const fixedKernelTable* fixed=NULL;
+        if(_size==targ_size && n2->_size==targ_size && (fixed=fixedKernels(_numDef,targ_size)))
+            good = fixed->addition(_data,n2->_data,result->_data,targ_size);
+        else if(_numDef->sizedAddition)
+            good = _numDef->sizedAddition(_data,_size,n2->_data,n2->_size,result->_data,targ_size);
+        else
         {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
+            const uint32_t* d1=widenOperand(_data,_size,targ_size);
+            const uint32_t* d2=widenOperand(n2->_data,n2->_size,targ_size);
+            good = d1 && d2 && _numDef->addition(d1,d2,result->_data,targ_size);
+            releaseOperand(d2,n2->_data);
+            releaseOperand(d1,_data);
         }
 
-        bool good=true;
-        good = _numDef->addition(d1,d2,result->_data,targ_size);
-
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
-
         if(!good)
         {
             cryptoerr<<"Addition error!"<<std::endl;
@@ -464,30 +675,24 @@ using namespace crypto;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
         result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
 
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
-        if(targ_size>n2->_size)
+        //Equal key-sized operands use the unrolled kernels, then kernels which
+        //take each operand's size skip the zero padding, else operands are widened
+        bool good=true;
+        const fixedKernelTable* fixed=NULL;
+        if(_size==targ_size && n2->_size==targ_size && (fixed=fixedKernels(_numDef,targ_size)))
+            good = fixed->subtraction(_data,n2->_data,result->_data,targ_size);
+        else if(_numDef->sizedSubtraction)
+            good = _numDef->sizedSubtraction(_data,_size,n2->_data,n2->_size,result->_data,targ_size);
+        else
         {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
+            const uint32_t* d1=widenOperand(_data,_size,targ_size);
+            const uint32_t* d2=widenOperand(n2->_data,n2->_size,targ_size);
+            good = d1 && d2 && _numDef->subtraction(d1,d2,result->_data,targ_size);
+            releaseOperand(d2,n2->_data);
+            releaseOperand(d1,_data);
         }
 
-        bool good=true;
-        good = _numDef->subtraction(d1,d2,result->_data,targ_size);
-
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
-
         if(!good)
         {
             cryptoerr<<"Subtraction error!"<<std::endl;
@@ -511,21 +716,18 @@ using namespace crypto;
         int targ_size=_size;
         if(result->_size>targ_size) targ_size=result->_size;
         result->expand(targ_size);
-        uint32_t* d1=_data;
 
-        //Build temp hold values
-        if(targ_size>_size)
+        //Kernels which take each operand's size skip the zero padding
+        bool good=true;
+        if(_numDef->sizedRightShift)
+            good = _numDef->sizedRightShift(_data,_size,n2,result->_data,targ_size);
+        else
         {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
+            const uint32_t* d1=widenOperand(_data,_size,targ_size);
+            good = d1 && _numDef->rightShift(d1,n2,result->_data,targ_size);
+            releaseOperand(d1,_data);
         }
 
-        bool good = _numDef->rightShift(d1,n2,result->_data,targ_size);
-
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-
         if(!good)
         {
             cryptoerr<<"Right shift error!"<<std::endl;
@@ -549,21 +751,18 @@ using namespace crypto;
         int targ_size=_size;
         if(result->_size>targ_size) targ_size=result->_size;
         result->expand(targ_size);
-        uint32_t* d1=_data;
 
-        //Build temp hold values
-        if(targ_size>_size)
+        //Kernels which take each operand's size skip the zero padding
+        bool good=true;
+        if(_numDef->sizedLeftShift)
+            good = _numDef->sizedLeftShift(_data,_size,n2,result->_data,targ_size);
+        else
         {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
+            const uint32_t* d1=widenOperand(_data,_size,targ_size);
+            good = d1 && _numDef->leftShift(d1,n2,result->_data,targ_size);
+            releaseOperand(d1,_data);
         }
 
-        bool good = _numDef->leftShift(d1,n2,result->_data,targ_size);
-
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-
         if(!good)
         {
             cryptoerr<<"Left shift error!"<<std::endl;
@@ -589,33 +788,56 @@ using namespace crypto;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
         result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
 
-        //Build temp hold values
-        if(targ_size>_size)
+        //Kernels which take each operand's size skip the zero padding
+        bool good=true;
+        if(_numDef->sizedMultiplication)
+            good = _numDef->sizedMultiplication(_data,_size,n2->_data,n2->_size,result->_data,targ_size);
+        else
         {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
+            const uint32_t* d1=widenOperand(_data,_size,targ_size);
+            const uint32_t* d2=widenOperand(n2->_data,n2->_size,targ_size);
+            good = d1 && d2 && _numDef->multiplication(d1,d2,result->_data,targ_size);
+            releaseOperand(d2,n2->_data);
+            releaseOperand(d1,_data);
         }
-        if(targ_size>n2->_size)
+
+        if(!good)
         {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
+            cryptoerr<<"Multiplication error!"<<std::endl;
+            *result=integer();
+        }
+    }
+    //Square
+    void number::square(number* result) const
+    {
+        //Check if our function is even defined
+        if(!hasSquare())
+        {
+            cryptoerr<<"Called square when no square function exists!"<<std::endl;
+            *result=integer();
+            return;
         }
 
-        bool good=true;
-        good = _numDef->multiplication(d1,d2,result->_data,targ_size);
+        //Resize and return result
+        int targ_size=_size;
+        if(result->_size>targ_size) targ_size=result->_size;
+        result->expand(targ_size);
 
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
+        //Kernels which take each operand's size skip the zero padding
+        bool good=true;
+        if(_numDef->sizedSquare)
+            good = _numDef->sizedSquare(_data,_size,result->_data,targ_size);
+        else
+        {
+            const uint32_t* d1=widenOperand(_data,_size,targ_size);
+            good = d1 && _numDef->square(d1,result->_data,targ_size);
+            releaseOperand(d1,_data);
+        }
 
         if(!good)
         {
-            cryptoerr<<"Exponentiation error!"<<std::endl;
+            cryptoerr<<"Square error!"<<std::endl;
             *result=integer();
         }
     }
@@ -636,34 +858,55 @@ using namespace crypto;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
         result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
 
-        //Build temp hold values
-        if(targ_size>_size)
+        //Pad short operands from the kernel workspace
+        const uint32_t* d1=widenOperand(_data,_size,targ_size);
+        const uint32_t* d2=widenOperand(n2->_data,n2->_size,targ_size);
+        bool good = d1 && d2 && _numDef->division(d1,d2,result->_data,targ_size);
+        releaseOperand(d2,n2->_data);
+        releaseOperand(d1,_data);
+
+        if(!good)
         {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
+            cryptoerr<<"Division error!"<<std::endl;
+            *result=integer();
         }
-        if(targ_size>n2->_size)
+
+        return;
+    }
+    //Division with remainder
+    void number::divmod(const number* n2, number* quotient, number* remainder) const
+    {
+        //Check if our function is even defined
+        if(!hasDivMod()||n2==NULL)
         {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
+            if(!hasDivMod()) cryptoerr<<"Called divmod when no divmod function exists!"<<std::endl;
+            else cryptoerr<<"Called divmod with NULL n2!"<<std::endl;
+            *quotient=integer();
+            *remainder=integer();
+            return;
         }
 
-        bool good=true;
-        good = _numDef->division(d1,d2,result->_data,targ_size);
-
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
+        //Resize and return result
+        int targ_size=_size;
+        if(n2->_size>targ_size) targ_size=n2->_size;
+        if(quotient->_size>targ_size) targ_size=quotient->_size;
+        if(remainder->_size>targ_size) targ_size=remainder->_size;
+        quotient->expand(targ_size);
+        remainder->expand(targ_size);
+
+        //Pad short operands from the kernel workspace
+        const uint32_t* d1=widenOperand(_data,_size,targ_size);
+        const uint32_t* d2=widenOperand(n2->_data,n2->_size,targ_size);
+        bool good = d1 && d2 && _numDef->divmod(d1,d2,quotient->_data,remainder->_data,targ_size);
+        releaseOperand(d2,n2->_data);
+        releaseOperand(d1,_data);
 
         if(!good)
         {
             cryptoerr<<"Division error!"<<std::endl;
-            *result=integer();
+            *quotient=integer();
+            *remainder=integer();
         }
 
         return;
@@ -685,29 +928,13 @@ using namespace crypto;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
         result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
 
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
-        if(targ_size>n2->_size)
-        {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
-        }
-
-        bool good=true;
-        good = _numDef->modulo(d1,d2,result->_data,targ_size);
-
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
+        //Pad short operands from the kernel workspace
+        const uint32_t* d1=widenOperand(_data,_size,targ_size);
+        const uint32_t* d2=widenOperand(n2->_data,n2->_size,targ_size);
+        bool good = d1 && d2 && _numDef->modulo(d1,d2,result->_data,targ_size);
+        releaseOperand(d2,n2->_data);
+        releaseOperand(d1,_data);
 
         if(!good)
         {
@@ -734,29 +961,13 @@ using namespace crypto;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
         result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
-
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
-        if(targ_size>n2->_size)
-        {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
-        }
 
-        bool good=true;
-        good = _numDef->exponentiation(d1,d2,result->_data,targ_size);
-
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
+        //Pad short operands from the kernel workspace
+        const uint32_t* d1=widenOperand(_data,_size,targ_size);
+        const uint32_t* d2=widenOperand(n2->_data,n2->_size,targ_size);
+        bool good = d1 && d2 && _numDef->exponentiation(d1,d2,result->_data,targ_size);
+        releaseOperand(d2,n2->_data);
+        releaseOperand(d1,_data);
 
         if(!good)
         {
@@ -784,37 +995,15 @@ using namespace crypto;
         if(n3->_size>targ_size) targ_size=n3->_size;
         if(result->_size>targ_size) targ_size=result->_size;
         result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
-        uint32_t* d3=n3->_data;
 
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
-        if(targ_size>n2->_size)
-        {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
-        }
-        if(targ_size>n3->_size)
-        {
-            d3=new uint32_t[targ_size];
-            memset(d3,0,sizeof(uint32_t)*targ_size);
-            memcpy(d3, n3->_data, sizeof(uint32_t)*n3->_size);
-        }
-
-        bool good=true;
-        good = _numDef->moduloExponentiation(d1,d2,d3,result->_data,targ_size);
-
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
-        if(targ_size>n3->_size) delete [] d3;
+        //Pad short operands from the kernel workspace
+        const uint32_t* d1=widenOperand(_data,_size,targ_size);
+        const uint32_t* d2=widenOperand(n2->_data,n2->_size,targ_size);
+        const uint32_t* d3=widenOperand(n3->_data,n3->_size,targ_size);
+        bool good = d1 && d2 && d3 && _numDef->moduloExponentiation(d1,d2,d3,result->_data,targ_size);
+        releaseOperand(d3,n3->_data);
+        releaseOperand(d2,n2->_data);
+        releaseOperand(d1,_data);
 
         if(!good)
         {
@@ -841,29 +1030,13 @@ using namespace crypto;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
         result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
-
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
-        if(targ_size>n2->_size)
-        {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
-        }
 
-        bool good=true;
-        good = _numDef->gcd(d1,d2,result->_data,targ_size);
-
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
+        //Pad short operands from the kernel workspace
+        const uint32_t* d1=widenOperand(_data,_size,targ_size);
+        const uint32_t* d2=widenOperand(n2->_data,n2->_size,targ_size);
+        bool good = d1 && d2 && _numDef->gcd(d1,d2,result->_data,targ_size);
+        releaseOperand(d2,n2->_data);
+        releaseOperand(d1,_data);
 
         if(!good)
         {
@@ -890,29 +1063,13 @@ using namespace crypto;
         if(n2->_size>targ_size) targ_size=n2->_size;
         if(result->_size>targ_size) targ_size=result->_size;
         result->expand(targ_size);
-        uint32_t* d1=_data;
-        uint32_t* d2=n2->_data;
 
-        //Build temp hold values
-        if(targ_size>_size)
-        {
-            d1=new uint32_t[targ_size];
-            memset(d1,0,sizeof(uint32_t)*targ_size);
-            memcpy(d1, _data, sizeof(uint32_t)*_size);
-        }
-        if(targ_size>n2->_size)
-        {
-            d2=new uint32_t[targ_size];
-            memset(d2,0,sizeof(uint32_t)*targ_size);
-            memcpy(d2, n2->_data, sizeof(uint32_t)*n2->_size);
-        }
-
-        bool good=true;
-        good = _numDef->modInverse(d1,d2,result->_data,targ_size);
-
-        //Delete temp hold values (if we need to)
-        if(targ_size>_size) delete [] d1;
-        if(targ_size>n2->_size) delete [] d2;
+        //Pad short operands from the kernel workspace
+        const uint32_t* d1=widenOperand(_data,_size,targ_size);
+        const uint32_t* d2=widenOperand(n2->_data,n2->_size,targ_size);
+        bool good = d1 && d2 && _numDef->modInverse(d1,d2,result->_data,targ_size);
+        releaseOperand(d2,n2->_data);
+        releaseOperand(d1,_data);
 
         if(!good)
         {
@@ -985,14 +1142,31 @@ using namespace crypto;
         ret[0]=2;
         return ret;
     }
+    //Default definition, NULL is buildBaseTenType()
+    static std::atomic<struct numberType*> _defaultIntegerDefinition(NULL);
+
     //Basic integer constructor
-    integer::integer():number(buildBaseTenType()){}
+    integer::integer():number(defaultDefinition()){}
     //Size constructor
-    integer::integer(uint16_t size):number(size,buildBaseTenType()){}
+    integer::integer(uint16_t size):number(size,defaultDefinition()){}
     //Data constructor
-    integer::integer(const uint32_t* d, uint16_t size):number(d,size,buildBaseTenType()){}
+    integer::integer(const uint32_t* d, uint16_t size):number(d,size,defaultDefinition()){}
     //Copy constructor
     integer::integer(const integer& num):number(num){}
+    //Move constructor
+    integer::integer(integer&& num) noexcept:number(std::move(num)){}
+    //Copy operator
+    integer& integer::operator=(const integer& num)
+    {
+        number::operator=(num);
+        return *this;
+    }
+    //Move operator
+    integer& integer::operator=(integer&& num) noexcept
+    {
+        number::operator=(std::move(num));
+        return *this;
+    }
 
     //Checks type
     bool integer::checkType() const
@@ -1006,14 +1180,43 @@ using namespace crypto;
         if(!hasRightShift()) return false;
         if(!hasLeftShift()) return false;
         if(!hasMultiplication()) return false;
+        if(!hasSquare()) return false;
         if(!hasDivision()) return false;
         if(!hasModulo()) return false;
+        if(!hasDivMod()) return false;
         if(!hasExponentiation()) return false;
         if(!hasModuloExponentiation()) return false;
         if(!hasGCD()) return false;
         if(!hasModInverse()) return false;
         return true;
     }
+    //Default definition
+    struct numberType* integer::defaultDefinition()
+    {
+        struct numberType* ret=_defaultIntegerDefinition.load();
+        if(!ret) return buildBaseTenType();
+        return ret;
+    }
+    //Set default definition
+    void integer::setDefaultDefinition(struct numberType* numDef)
+    {
+        if(!numDef || numDef->typeID!=numberType::Base10)
+        {
+            cryptoerr<<"Default integer definition must be of the Base-10 type!"<<std::endl;
+            return;
+        }
+        _defaultIntegerDefinition.store(numDef);
+    }
+    //Re-bind definition
+    void integer::setDefinition(struct numberType* numDef)
+    {
+        if(!numDef || numDef->typeID!=numberType::Base10)
+        {
+            cryptoerr<<"Integer definition must be of the Base-10 type!"<<std::endl;
+            return;
+        }
+        _numDef=numDef;
+    }
 
 //Operators--------------------------------------------------------
 
@@ -1088,6 +1291,50 @@ using namespace crypto;
         multiplication(&n,this);
         return *this;
     }
+    integer integer::square() const
+    {
+        integer ret(_size);
+        number::square(&ret);
+        return ret;
+    }
+    //Double-width multiplication
+    integer integer::multiplyFull(const integer& n) const
+    {
+        if(!hasMultiplication())
+        {
+            cryptoerr<<"Called multiplication when no multiplication function exists!"<<std::endl;
+            return integer();
+        }
+        uint32_t targ_size=(uint32_t) _size+n._size;
+        if(targ_size>0xFFFF)
+        {
+            cryptoerr<<"Full product is too large!"<<std::endl;
+            return integer();
+        }
+
+        //The result holds every limb of the product, so the kernels cannot overflow
+        integer ret((uint16_t) targ_size);
+        bool good=true;
+        if(&n==this && _numDef->sizedSquare)
+            good = _numDef->sizedSquare(_data,_size,ret._data,targ_size);
+        else if(_numDef->sizedMultiplication)
+            good = _numDef->sizedMultiplication(_data,_size,n._data,n._size,ret._data,targ_size);
+        else
+        {
+            const uint32_t* d1=widenOperand(_data,_size,targ_size);
+            const uint32_t* d2=widenOperand(n._data,n._size,targ_size);
+            good = d1 && d2 && _numDef->multiplication(d1,d2,ret._data,targ_size);
+            releaseOperand(d2,n._data);
+            releaseOperand(d1,_data);
+        }
+
+        if(!good)
+        {
+            cryptoerr<<"Multiplication error!"<<std::endl;
+            return integer();
+        }
+        return ret;
+    }
     //Division operators
     integer integer::operator/(const integer& n) const
     {
@@ -1112,6 +1359,189 @@ using namespace crypto;
         modulo(&n,this);
         return *this;
     }
+    integer integer::operator%(const barrettReducer& red) const
+    {
+        return red.reduce(*this);
+    }
+    integer& integer::operator%=(const barrettReducer& red)
+    {
+        *this=red.reduce(*this);
+        return *this;
+    }
+    //Division with remainder
+    integer integer::divmod(const integer& n, integer& remainder) const
+    {
+        integer ret(_size);
+        number::divmod(&n,&ret,&remainder);
+        return ret;
+    }
+
+    //Operands of a fused modular kernel, zero-extended to the size of the destination
+    struct fusedOperands
+    {
+        const integer* src[4];
+        const uint32_t* data[4];
+        uint16_t size;
+
+        //The destination is grown first, so it may also be an operand
+        fusedOperands(integer& dest, const integer* a, const integer* b, const integer* c, const integer* m)
+        {
+            src[0]=a;
+            src[1]=b;
+            src[2]=c;
+            src[3]=m;
+            size=dest.size();
+            for(int i=0;i<4;++i)
+            {
+                if(src[i] && src[i]->size()>size) size=src[i]->size();
+            }
+            dest.expand(size);
+            for(int i=0;i<4;++i)
+            {
+                data[i]=NULL;
+                if(!src[i]) continue;
+                for(int j=0;j<i && !data[i];++j)
+                {
+                    if(src[j]==src[i]) data[i]=data[j];
+                }
+                if(!data[i]) data[i]=widenOperand(src[i]->data(),src[i]->size(),size);
+            }
+        }
+        //Every operand was widened
+        bool good() const
+        {
+            for(int i=0;i<4;++i)
+            {
+                if(src[i] && !data[i]) return false;
+            }
+            return true;
+        }
+        //Returned in reverse, a repeated operand only once
+        ~fusedOperands()
+        {
+            for(int i=3;i>=0;--i)
+            {
+                if(!src[i]) continue;
+                bool repeat=false;
+                for(int j=0;j<i;++j)
+                {
+                    if(src[j]==src[i]) repeat=true;
+                }
+                if(!repeat) releaseOperand(data[i],src[i]->data());
+            }
+        }
+    };
+    //Modular multiplication
+    integer& integer::mulMod(const integer& a, const integer& b, const integer& m)
+    {
+        int ret;
+        {
+            fusedOperands ops(*this,&a,&b,NULL,&m);
+            ret=ops.good() && base10ModMultiply(ops.data[0],ops.data[1],ops.data[3],_data,ops.size);
+        }
+        if(!ret)
+        {
+            cryptoerr<<"Modular multiplication error!"<<std::endl;
+            *this=integer();
+        }
+        return *this;
+    }
+    integer& integer::mulMod(const integer& a, const integer& b, const barrettReducer& red)
+    {
+        if(!red.valid())
+        {
+            cryptoerr<<"Called Barrett multiplication with a zero modulus!"<<std::endl;
+            return *this=integer();
+        }
+        int ret;
+        {
+            fusedOperands ops(*this,&a,&b,NULL,&red.modulus());
+            ret=ops.good() && base10BarrettMultiply(red.context(),ops.data[0],ops.data[1],_data,ops.size);
+        }
+        if(!ret)
+        {
+            cryptoerr<<"Barrett multiplication error!"<<std::endl;
+            *this=integer();
+        }
+        return *this;
+    }
+    //Modular square
+    integer& integer::sqrMod(const integer& a, const integer& m)
+    {
+        return mulMod(a,a,m);
+    }
+    integer& integer::sqrMod(const integer& a, const barrettReducer& red)
+    {
+        return mulMod(a,a,red);
+    }
+    //Modular multiply and add
+    integer& integer::mulAddMod(const integer& a, const integer& b, const integer& c, const integer& m)
+    {
+        int ret;
+        {
+            fusedOperands ops(*this,&a,&b,&c,&m);
+            ret=ops.good() && base10ModMultiplyAdd(ops.data[0],ops.data[1],ops.data[2],ops.data[3],_data,ops.size);
+        }
+        if(!ret)
+        {
+            cryptoerr<<"Modular multiply and add error!"<<std::endl;
+            *this=integer();
+        }
+        return *this;
+    }
+    integer& integer::mulAddMod(const integer& a, const integer& b, const integer& c, const barrettReducer& red)
+    {
+        if(!red.valid())
+        {
+            cryptoerr<<"Called Barrett multiply and add with a zero modulus!"<<std::endl;
+            return *this=integer();
+        }
+        int ret;
+        {
+            fusedOperands ops(*this,&a,&b,&c,&red.modulus());
+            ret=ops.good() && base10BarrettMultiplyAdd(red.context(),ops.data[0],ops.data[1],ops.data[2],_data,ops.size);
+        }
+        if(!ret)
+        {
+            cryptoerr<<"Barrett multiply and add error!"<<std::endl;
+            *this=integer();
+        }
+        return *this;
+    }
+    //Modular subtraction
+    integer& integer::subMod(const integer& a, const integer& b, const integer& m)
+    {
+        int ret;
+        {
+            fusedOperands ops(*this,&a,&b,NULL,&m);
+            ret=ops.good() && base10ModSubtract(ops.data[0],ops.data[1],ops.data[3],_data,ops.size);
+        }
+        if(!ret)
+        {
+            cryptoerr<<"Modular subtraction error!"<<std::endl;
+            *this=integer();
+        }
+        return *this;
+    }
+    integer& integer::subMod(const integer& a, const integer& b, const barrettReducer& red)
+    {
+        if(!red.valid())
+        {
+            cryptoerr<<"Called Barrett subtraction with a zero modulus!"<<std::endl;
+            return *this=integer();
+        }
+        int ret;
+        {
+            fusedOperands ops(*this,&a,&b,NULL,&red.modulus());
+            ret=ops.good() && base10BarrettSubtract(red.context(),ops.data[0],ops.data[1],_data,ops.size);
+        }
+        if(!ret)
+        {
+            cryptoerr<<"Barrett subtraction error!"<<std::endl;
+            *this=integer();
+        }
+        return *this;
+    }
     //Exponentiation operators
     integer integer::exponentiation(const integer& n) const
     {
@@ -1136,6 +1566,64 @@ using namespace crypto;
         number::moduloExponentiation(&n,&mod,this);
         return *this;
     }
+    integer integer::moduloExponentiation(const integer& n, const montgomeryReducer& red) const
+    {
+        return red.moduloExponentiation(*this,n);
+    }
+    //Batched modulo exponentiation
+    std::vector<integer> integer::batchModuloExponentiation(const std::vector<integer>& bases, const std::vector<integer>& exps, const std::vector<integer>& mods)
+    {
+        std::vector<integer> ret;
+        if(bases.size()!=exps.size() || bases.size()!=mods.size())
+        {
+            cryptoerr<<"Batch mod exponentiation requires as many exponents and moduli as bases!"<<std::endl;
+            return ret;
+        }
+
+        //Zero-extend every argument to the widest one
+        uint16_t targ_size=1;
+        for(size_t i=0;i<bases.size();++i)
+        {
+            if(bases[i].size()>targ_size) targ_size=bases[i].size();
+            if(exps[i].size()>targ_size) targ_size=exps[i].size();
+            if(mods[i].size()>targ_size) targ_size=mods[i].size();
+        }
+        std::vector<integer> b(bases);
+        std::vector<integer> e(exps);
+        std::vector<integer> m(mods);
+        std::vector<const uint32_t*> d1(bases.size());
+        std::vector<const uint32_t*> d2(bases.size());
+        std::vector<const uint32_t*> d3(bases.size());
+        std::vector<uint32_t*> dest(bases.size());
+        ret.reserve(bases.size());
+        for(size_t i=0;i<bases.size();++i)
+        {
+            b[i].expand(targ_size);
+            e[i].expand(targ_size);
+            m[i].expand(targ_size);
+            ret.push_back(integer(targ_size));
+        }
+        for(size_t i=0;i<bases.size();++i)
+        {
+            d1[i]=b[i].data();
+            d2[i]=e[i].data();
+            d3[i]=m[i].data();
+            dest[i]=ret[i].data();
+        }
+
+        //The kernel counts entries in a uint16_t
+        for(size_t i=0;i<bases.size();i+=0xFFFF)
+        {
+            uint16_t count=(uint16_t) (bases.size()-i>0xFFFF ? 0xFFFF : bases.size()-i);
+            if(base10_64BatchModuloExponentiation(&d1[i],&d2[i],&d3[i],&dest[i],count,targ_size))
+                continue;
+
+            //Re-run the chunk one at a time so each failure is reported
+            for(size_t j=i;j<i+count;++j)
+                ret[j]=bases[j].moduloExponentiation(exps[j],mods[j]);
+        }
+        return ret;
+    }
     //GCD
     integer integer::gcd(const integer& n) const
     {
@@ -1160,10 +1648,237 @@ using namespace crypto;
         number::modInverse(&n,this);
         return *this;
     }
+    //Batched mod inverse
+    bool integer::batchModInverse(std::vector<integer>& nums, const integer& m)
+    {
+        if(nums.empty()) return true;
+
+        //Zero-extend every argument to the widest one
+        uint16_t targ_size=m.size();
+        for(size_t i=0;i<nums.size();++i)
+        {
+            if(nums[i].size()>targ_size) targ_size=nums[i].size();
+        }
+        integer mod(m);
+        mod.expand(targ_size);
+        std::vector<const uint32_t*> d1(nums.size());
+        std::vector<uint32_t*> dest(nums.size());
+        std::vector<integer> ret(nums);
+        for(size_t i=0;i<nums.size();++i)
+        {
+            ret[i].expand(targ_size);
+            d1[i]=ret[i].data();
+            dest[i]=ret[i].data();
+        }
+
+        if(base10BatchModInverse(&d1[0],mod.data(),&dest[0],(uint32_t) nums.size(),targ_size))
+        {
+            nums.swap(ret);
+            return true;
+        }
+
+        //Invert one at a time so each failure is reported
+        for(size_t i=0;i<nums.size();++i)
+            nums[i]=nums[i].modInverse(m);
+        return false;
+    }
     //Prime testing
-    bool integer::prime(uint16_t testVal) const
+    bool integer::prime(uint16_t testVal, uint16_t mode) const
+    {
+        return base10ProbablePrime(_data,mode,testVal,_size);
+    }
+    //Next prime
+    integer integer::nextPrime(uint16_t testVal, uint16_t mode) const
+    {
+        integer ret(*this);
+        if(!base10NextPrime(_data,ret._data,mode,testVal,_size))
+        {
+            cryptoerr<<"Next prime overflowed!"<<std::endl;
+            return integer();
+        }
+        return ret;
+    }
+    //Strided prime search
+    integer integer::searchPrime(uint32_t step, uint32_t count, uint16_t testVal, uint16_t mode) const
+    {
+        integer ret(*this);
+        if(!base10PrimeSearch(_data,step,count,ret._data,mode,testVal,_size))
+            return integer();
+        return ret;
+    }
+
+/*================================================================
+	Montgomery Reducer
+ ================================================================*/
+
+    //Construct from modulus
+    montgomeryReducer::montgomeryReducer(const integer& mod):
+        _modulus(mod)
+    {
+        buildContext();
+    }
+    //Copy constructor
+    montgomeryReducer::montgomeryReducer(const montgomeryReducer& red):
+        _modulus(red._modulus)
+    {
+        buildContext();
+    }
+    //Equality constructor
+    montgomeryReducer& montgomeryReducer::operator=(const montgomeryReducer& red)
+    {
+        if(this==&red) return *this;
+        freeContext();
+        _modulus=red._modulus;
+        buildContext();
+        return *this;
+    }
+    //Destructor
+    montgomeryReducer::~montgomeryReducer()
+    {
+        freeContext();
+    }
+    //Build the context for the modulus definition
+    void montgomeryReducer::buildContext()
+    {
+        memset(&_context,0,sizeof(struct montgomeryContext));
+        memset(&_context64,0,sizeof(struct montgomeryContext64));
+        if(_modulus.numberDefinition()==buildBaseTen64Type())
+            base10_64MontgomeryInit(&_context64,_modulus.data(),_modulus.size());
+        else
+            base10MontgomeryInit(&_context,_modulus.data(),_modulus.size());
+    }
+    //Release both contexts
+    void montgomeryReducer::freeContext()
+    {
+        base10MontgomeryFree(&_context);
+        base10_64MontgomeryFree(&_context64);
+    }
+    //Modulo exponentiation
+    integer montgomeryReducer::moduloExponentiation(const integer& base, const integer& exp) const
+    {
+        if(!valid())
+        {
+            cryptoerr<<"Called Montgomery exponentiation with an even or zero modulus!"<<std::endl;
+            return integer();
+        }
+
+        //Zero-extend arguments to the same size
+        uint16_t targ_size=_modulus.size();
+        if(base.size()>targ_size) targ_size=base.size();
+        if(exp.size()>targ_size) targ_size=exp.size();
+        integer b(base);
+        integer e(exp);
+        integer ret(targ_size);
+        b.expand(targ_size);
+        e.expand(targ_size);
+
+        int good;
+        if(_context64.length>0)
+            good=base10_64MontgomeryExponentiation(&_context64,b.data(),e.data(),ret.data(),targ_size);
+        else
+            good=base10MontgomeryExponentiation(&_context,b.data(),e.data(),ret.data(),targ_size);
+        if(!good)
+        {
+            cryptoerr<<"Mod exponentiation error!"<<std::endl;
+            return integer();
+        }
+        return ret;
+    }
+
+/*================================================================
+	Barrett Reducer
+ ================================================================*/
+
+    //Construct from modulus
+    barrettReducer::barrettReducer(const integer& mod):
+        _modulus(mod)
+    {
+        base10BarrettInit(&_context,_modulus.data(),_modulus.size());
+    }
+    //Copy constructor
+    barrettReducer::barrettReducer(const barrettReducer& red):
+        _modulus(red._modulus)
+    {
+        base10BarrettInit(&_context,_modulus.data(),_modulus.size());
+    }
+    //Equality constructor
+    barrettReducer& barrettReducer::operator=(const barrettReducer& red)
+    {
+        if(this==&red) return *this;
+        base10BarrettFree(&_context);
+        _modulus=red._modulus;
+        base10BarrettInit(&_context,_modulus.data(),_modulus.size());
+        return *this;
+    }
+    //Destructor
+    barrettReducer::~barrettReducer()
+    {
+        base10BarrettFree(&_context);
+    }
+    //Reduce by the modulus
+    integer barrettReducer::reduce(const integer& src) const
+    {
+        if(!valid())
+        {
+            cryptoerr<<"Called Barrett reduction with a zero modulus!"<<std::endl;
+            return integer();
+        }
+
+        //Zero-extend the argument to the modulus size
+        uint16_t targ_size=_modulus.size();
+        if(src.size()>targ_size) targ_size=src.size();
+        integer s(src);
+        integer ret(targ_size);
+        s.expand(targ_size);
+
+        if(!base10BarrettReduce(&_context,s.data(),ret.data(),targ_size))
+        {
+            cryptoerr<<"Barrett reduction error!"<<std::endl;
+            return integer();
+        }
+        return ret;
+    }
+
+/*================================================================
+	Prime Searcher
+ ================================================================*/
+
+    //Construct from a starting candidate
+    primeSearcher::primeSearcher(const integer& start, uint32_t step):
+        _candidate(start),
+        _step(step)
+    {
+        base10PrimeSieveInit(&_sieve,_candidate.data(),_candidate.size());
+    }
+    //Copy constructor
+    primeSearcher::primeSearcher(const primeSearcher& search):
+        _candidate(search._candidate),
+        _step(search._step)
+    {
+        base10PrimeSieveInit(&_sieve,_candidate.data(),_candidate.size());
+    }
+    //Equality constructor
+    primeSearcher& primeSearcher::operator=(const primeSearcher& search)
+    {
+        if(this==&search) return *this;
+        base10PrimeSieveFree(&_sieve);
+        _candidate=search._candidate;
+        _step=search._step;
+        base10PrimeSieveInit(&_sieve,_candidate.data(),_candidate.size());
+        return *this;
+    }
+    //Destructor
+    primeSearcher::~primeSearcher()
+    {
+        base10PrimeSieveFree(&_sieve);
+    }
+    //Test the next chunk
+    integer primeSearcher::search(uint32_t count, uint16_t testVal, uint16_t mode)
     {
-        return primeTest(_data,testVal,_size);
+        if(!valid()) return integer();
+        if(!base10PrimeSieveSearch(&_sieve,_candidate.data(),_step,count,mode,testVal,_candidate.size()))
+            return integer();
+        return _candidate;
     }
 
 #endif
@@ -15,11 +15,14 @@
 #include "cryptoConstants.h"
 #include "cryptoCHeaders.h"
 #include <string>
+#include <vector>
 
 namespace crypto
 {
 	///@cond INTERNAL
     class number;
+    class montgomeryReducer;
+    class barrettReducer;
 	///@endcond
 
 	/** @brief Output stream operator
@@ -58,13 +61,45 @@ namespace crypto
 		/** @brief Data array
 		 */
         uint32_t* _data;
+		/** @brief Number of uint32_t _data can hold
+		 */
+        uint16_t _capacity;
+		/** @brief Inline storage
+		 *
+		 * _data points here until the number
+		 * needs more than inlineLimbs uint32_t,
+		 * so key-sized numbers never touch the heap.
+		 */
+        uint32_t _inline[128];
 
+		/** @brief Point _data at storage for size uint32_t
+		 *
+		 * Uses the inline storage when it is large
+		 * enough, otherwise the thread's limb pool
+		 * (see numberLimbAlloc).  The contents are
+		 * not preserved.
+		 *
+		 * @param [in] size Number of uint32_t required
+		 * @return void
+		 */
+        void allocate(uint16_t size);
+		/** @brief Return pooled storage
+		 * @return void
+		 */
+        void release();
 		/** @brief Compares two numbers
 		 * @param [in] n2 Number to be compared against
 		 * @return 0 if equal, 1 if greater than, -1 if less than
 		 */
         int _compare(const number& n2) const;
     public:
+		/** @brief Inline storage size
+		 *
+		 * 128 uint32_t, a 4096-bit number or a
+		 * 2048-bit key stored at double width.
+		 */
+        static const uint16_t inlineLimbs=128;
+
 		/** @brief Construct with number definition
 		 * @param [in] numDef Definition of number, by default buildNullNumberType()
 		 */
@@ -84,11 +119,24 @@ namespace crypto
 		 * @param [in] num Number used to construct this
 		 */
         number(const number& num);
+		/** @brief Move constructor
+		 *
+		 * Takes the heap storage of num, if it
+		 * has any, and leaves num as 0.
+		 *
+		 * @param [in/out] num Number used to construct this
+		 */
+        number(number&& num) noexcept;
 		/** @brief Equality constructor
 		 * @param [in] num Number used to re-build this
 		 * @return Reference to this
 		 */
 		number& operator=(const number& num);
+		/** @brief Move equality constructor
+		 * @param [in/out] num Number used to re-build this
+		 * @return Reference to this
+		 */
+		number& operator=(number&& num) noexcept;
 		/** @brief Virtual destructor
          *
          * Destructor must be virtual, if an object
@@ -99,10 +147,18 @@ namespace crypto
         virtual ~number();
 
         /** @brief Eliminate high-order zeros
+		 *
+		 * Storage is kept, so a later expand
+		 * back to the old size does not allocate.
+		 *
 		 * @return void
 		 */
         void reduce();
 		/** @brief Expand number size
+		 *
+		 * Only allocates when the size exceeds
+		 * the current storage.
+		 *
 		 * @param [in] size Size of the number to be constructed
 		 * @return void
 		 */
@@ -129,6 +185,35 @@ namespace crypto
 		 * return Byte array
 		 */
 		os::smart_ptr<unsigned char> getCompCharData(size_t& arr_len) const;
+		/** @brief Size of the compatibility byte array
+		 * @return Bytes written by writeBytes
+		 */
+		size_t byteLength() const;
+		/** @brief Write compatibility bytes into a buffer
+		 *
+		 * Writes the same bytes as getCompCharData
+		 * directly into out, with no intermediate
+		 * buffer.  When the compatibility layout is
+		 * a byte swap, whole blocks of uint32_t are
+		 * swapped at once.
+		 *
+		 * @param [out] out Buffer to write into
+		 * @param [in] cap Size of out in bytes
+		 * @return Bytes written, 0 if cap is smaller than byteLength()
+		 */
+		size_t writeBytes(uint8_t* out, size_t cap) const;
+		/** @brief Set from compatibility bytes
+		 *
+		 * Reverses writeBytes.  A trailing partial
+		 * uint32_t is zero-extended.  Storage is
+		 * re-used when it is large enough.  in may
+		 * not point into this number.
+		 *
+		 * @param [in] in Compatibility bytes
+		 * @param [in] len Number of bytes in in
+		 * @return void
+		 */
+		void assignBytes(const uint8_t* in, size_t len);
 
         /** @brief Build hex string from number
 		 * @return Hex string
@@ -247,6 +332,17 @@ namespace crypto
 		 * @return void
 		 */
 		void multiplication(const number* n2, number* result) const;
+        /** @brief Square function
+		 *
+		 * Preforms this*this=result.  Note
+		 * that this function will only preform
+		 * the square if the number definition
+		 * defines a square function.
+		 *
+		 * @param [out] result Result of square
+		 * @return void
+		 */
+		void square(number* result) const;
         /** @brief Division function
 		 *
 		 * Preforms this/n2=result.  Note
@@ -271,6 +367,20 @@ namespace crypto
 		 * @return void
 		 */
 		void modulo(const number* n2, number* result) const;
+		/** @brief Division with remainder function
+		 *
+		 * Preforms this/n2=quotient and
+		 * this%n2=remainder in a single pass.
+		 * Note that this function will only preform
+		 * the division if the number definition
+		 * defines a divmod function.
+		 *
+		 * @param [in] n2 Number to be divided by
+		 * @param [out] quotient Result of division
+		 * @param [out] remainder Result of modulo
+		 * @return void
+		 */
+		void divmod(const number* n2, number* quotient, number* remainder) const;
         /** @brief Exponentiation function
 		 *
 		 * Preforms this^n2=result.  Note
@@ -430,6 +540,10 @@ namespace crypto
 		 * @return crypto::number::_numDef->multiplication
 		 */
         inline bool hasMultiplication() const {return _numDef->multiplication;}
+		/** @brief Check for the 'square' function
+		 * @return crypto::number::_numDef->square
+		 */
+        inline bool hasSquare() const {return _numDef->square;}
 		/** @brief Check for the 'division' function
 		 * @return crypto::number::_numDef->division
 		 */
@@ -438,6 +552,10 @@ namespace crypto
 		 * @return crypto::number::_numDef->modulo
 		 */
         inline bool hasModulo() const {return _numDef->modulo;}
+		/** @brief Check for the 'divmod' function
+		 * @return crypto::number::_numDef->divmod
+		 */
+        inline bool hasDivMod() const {return _numDef->divmod;}
 		/** @brief Check for the 'exponentiation' function
 		 * @return crypto::number::_numDef->exponentiation
 		 */
@@ -526,6 +644,20 @@ namespace crypto
 		 * @param [in] num Integer used to construct this
 		 */
         integer(const integer& num);
+		/** @brief Move constructor
+		 * @param [in/out] num Integer used to construct this
+		 */
+        integer(integer&& num) noexcept;
+		/** @brief Equality constructor
+		 * @param [in] num Integer used to re-build this
+		 * @return Reference to this
+		 */
+        integer& operator=(const integer& num);
+		/** @brief Move equality constructor
+		 * @param [in/out] num Integer used to re-build this
+		 * @return Reference to this
+		 */
+        integer& operator=(integer&& num) noexcept;
         /** @brief Virtual destructor
          *
          * Destructor must be virtual, if an object
@@ -544,6 +676,38 @@ namespace crypto
 		 * @return true if valid type, else, false
 		 */
         bool checkType() const;
+        /** @brief Default integer definition
+		 *
+		 * Integers constructed without a definition
+		 * bind this one.  buildBaseTenType() unless
+		 * changed with crypto::integer::setDefaultDefinition.
+		 *
+		 * @return Base-10 number definition
+		 */
+        static struct numberType* defaultDefinition();
+        /** @brief Set the default integer definition
+		 *
+		 * Selects the kernels bound by every integer
+		 * constructed afterwards, for example
+		 * buildBaseTen64Type().  Existing integers keep
+		 * their definition.  Definitions which do
+		 * not have the base-10 type ID are rejected.
+		 *
+		 * @param [in] numDef Base-10 number definition
+		 * @return void
+		 */
+        static void setDefaultDefinition(struct numberType* numDef);
+        /** @brief Re-bind the definition of this integer
+		 *
+		 * The data is unchanged, only the kernels
+		 * used by later operations on this integer
+		 * change.  Definitions which do not have the
+		 * base-10 type ID are rejected.
+		 *
+		 * @param [in] numDef Base-10 number definition
+		 * @return void
+		 */
+        void setDefinition(struct numberType* numDef);
 
         /** @brief Allows integer to be cast as a number
 		 * @return number(*this)
@@ -608,6 +772,27 @@ namespace crypto
 		 * @reutrn this = this * n
 		 */
         integer& operator*=(const integer& n);
+		/** @brief Integer square function
+		 *
+		 * Cheaper than multiplying the
+		 * integer by itself.
+		 *
+		 * @return this * this
+		 */
+        integer square() const;
+		/** @brief Double-width multiplication
+		 *
+		 * Unlike the '*' operator, which keeps the
+		 * size of the larger operand and fails on
+		 * overflow, the result has exactly
+		 * size()+n.size() uint32_t, enough for any
+		 * product.  Operands can then stay at their
+		 * own size instead of being expanded first.
+		 *
+		 * @param [in] n Integer to be multiplied
+		 * @return this * n, size()+n.size() uint32_t wide
+		 */
+        integer multiplyFull(const integer& n) const;
 
 		/** @brief Integer division operator
 		 * @param [in] n Integer to be divided by
@@ -630,6 +815,100 @@ namespace crypto
 		 * @reutrn this = this % n
 		 */
         integer& operator%=(const integer& n);
+		/** @brief Integer modulo operator with a pre-built reducer
+		 *
+		 * Re-uses the Barrett context held by the
+		 * reducer instead of long division.
+		 *
+		 * @param [in] red Barrett reducer for the modulo space
+		 * @reutrn this % red.modulus()
+		 */
+        integer operator%(const barrettReducer& red) const;
+		/** @brief Integer modulo equals operator with a pre-built reducer
+		 * @param [in] red Barrett reducer for the modulo space
+		 * @reutrn this = this % red.modulus()
+		 */
+        integer& operator%=(const barrettReducer& red);
+		/** @brief Integer division with remainder
+		 *
+		 * Calculates the quotient and remainder
+		 * together, which is cheaper than calling
+		 * both the '/' and '%' operators.
+		 *
+		 * @param [in] n Integer to be divided by
+		 * @param [out] remainder this % n
+		 * @return this / n
+		 */
+        integer divmod(const integer& n, integer& remainder) const;
+
+		/** @brief Modular multiplication
+		 *
+		 * Sets this to (a*b)%m with one kernel call.
+		 * The full product only lives in the kernel
+		 * workspace, and this keeps its storage when
+		 * it is large enough.  this may be any of
+		 * the arguments.
+		 *
+		 * @param [in] a Argument 1
+		 * @param [in] b Argument 2
+		 * @param [in] m Integer defining modulo space
+		 * @return Reference to this
+		 */
+        integer& mulMod(const integer& a, const integer& b, const integer& m);
+		/** @brief Modular multiplication with a pre-built reducer
+		 * @param [in] a Argument 1
+		 * @param [in] b Argument 2
+		 * @param [in] red Barrett reducer for the modulo space
+		 * @return Reference to this
+		 */
+        integer& mulMod(const integer& a, const integer& b, const barrettReducer& red);
+		/** @brief Modular square
+		 * @param [in] a Argument
+		 * @param [in] m Integer defining modulo space
+		 * @return Reference to this, set to (a*a)%m
+		 */
+        integer& sqrMod(const integer& a, const integer& m);
+		/** @brief Modular square with a pre-built reducer
+		 * @param [in] a Argument
+		 * @param [in] red Barrett reducer for the modulo space
+		 * @return Reference to this, set to (a*a)%red.modulus()
+		 */
+        integer& sqrMod(const integer& a, const barrettReducer& red);
+		/** @brief Modular multiply and add
+		 * @param [in] a Argument 1
+		 * @param [in] b Argument 2
+		 * @param [in] c Argument 3
+		 * @param [in] m Integer defining modulo space
+		 * @return Reference to this, set to (a*b+c)%m
+		 */
+        integer& mulAddMod(const integer& a, const integer& b, const integer& c, const integer& m);
+		/** @brief Modular multiply and add with a pre-built reducer
+		 * @param [in] a Argument 1
+		 * @param [in] b Argument 2
+		 * @param [in] c Argument 3
+		 * @param [in] red Barrett reducer for the modulo space
+		 * @return Reference to this, set to (a*b+c)%red.modulus()
+		 */
+        integer& mulAddMod(const integer& a, const integer& b, const integer& c, const barrettReducer& red);
+		/** @brief Modular subtraction
+		 *
+		 * Unlike the '-' operator, the result
+		 * wraps around the modulus instead of
+		 * failing when b>a.
+		 *
+		 * @param [in] a Argument 1
+		 * @param [in] b Argument 2
+		 * @param [in] m Integer defining modulo space
+		 * @return Reference to this, set to (a-b)%m
+		 */
+        integer& subMod(const integer& a, const integer& b, const integer& m);
+		/** @brief Modular subtraction with a pre-built reducer
+		 * @param [in] a Argument 1
+		 * @param [in] b Argument 2
+		 * @param [in] red Barrett reducer for the modulo space
+		 * @return Reference to this, set to (a-b)%red.modulus()
+		 */
+        integer& subMod(const integer& a, const integer& b, const barrettReducer& red);
 
 		/** @brief Integer exponentiation function
 		 * @param [in] n Integer to be raised to
@@ -653,6 +932,32 @@ namespace crypto
 		 * @return this = this^n % mod
 		 */
         integer& moduloExponentiationEquals(const integer& n, const integer& mod);
+		/** @brief Integer modulo-exponentiation with a pre-built reducer
+		 *
+		 * Re-uses the Montgomery context held by
+		 * the reducer, avoiding the per-call set-up
+		 * cost when the same modulus is used repeatedly.
+		 *
+		 * @param [in] n Integer to be raised to
+		 * @param [in] red Montgomery reducer for the modulo space
+		 * @return this^n % red.modulus()
+		 */
+        integer moduloExponentiation(const integer& n, const montgomeryReducer& red) const;
+		/** @brief Batched modulo-exponentiation
+		 *
+		 * Computes bases[i]^exps[i] % mods[i] for
+		 * every i.  The entries are independent and
+		 * may use different moduli, on hosts with
+		 * AVX-512 IFMA eight of them are computed at
+		 * once (see base10_64BatchModuloExponentiation).
+		 * Results match crypto::integer::moduloExponentiation.
+		 *
+		 * @param [in] bases Integers to be raised
+		 * @param [in] exps Integers to be raised to
+		 * @param [in] mods Integers representing modulo spaces
+		 * @return bases[i]^exps[i] % mods[i], empty if the vector sizes differ
+		 */
+        static std::vector<integer> batchModuloExponentiation(const std::vector<integer>& bases, const std::vector<integer>& exps, const std::vector<integer>& mods);
 		/** @brief Integer GCD function
 		 * @param [in] n Integer to be compared against
 		 * @return GCD of this and n
@@ -673,6 +978,22 @@ namespace crypto
 		 * @return this = (this^-1) % n
 		 */
         integer& modInverseEquals(const integer& n);
+		/** @brief Batched modular inverse
+		 *
+		 * Replaces every entry of nums with its
+		 * inverse modulo m.  The product of every
+		 * entry is inverted once, so n inverses cost
+		 * one inverse and 3(n-1) modular products
+		 * (see base10BatchModInverse).  If some entry
+		 * has no inverse, each entry is inverted on
+		 * its own and the failures are reported as by
+		 * crypto::integer::modInverse.
+		 *
+		 * @param [in/out] nums Integers to be inverted
+		 * @param [in] m Integer representing modulo space
+		 * @return true if every entry had an inverse, else, false
+		 */
+        static bool batchModInverse(std::vector<integer>& nums, const integer& m);
 
 		/** @brief Test if this integer is prime
 		 *
@@ -682,9 +1003,246 @@ namespace crypto
 		 * large numbers.
 		 *
 		 * @param [in] testVal Number of test cycles, crytpo::algo::primeTestCycle by default
+		 * @param [in] mode Prime test, crypto::algo::primeTestMode by default
 		 * @return true if prime, else, false
 		 */
-        bool prime(uint16_t testVal=algo::primeTestCycle) const;
+        bool prime(uint16_t testVal=algo::primeTestCycle, uint16_t mode=algo::primeTestMode) const;
+		/** @brief Find the next prime
+		 *
+		 * Searches upwards from this integer for
+		 * the first probable prime.  Candidates
+		 * with a factor below crypto_primesieve_limit
+		 * are rejected by a sieve before the
+		 * prime test is run.
+		 *
+		 * @param [in] testVal Number of test cycles, crytpo::algo::primeTestCycle by default
+		 * @param [in] mode Prime test, crypto::algo::primeTestMode by default
+		 * @return Smallest probable prime >= this, 0 on overflow
+		 */
+        integer nextPrime(uint16_t testVal=algo::primeTestCycle, uint16_t mode=algo::primeTestMode) const;
+		/** @brief Search a strided range for a prime
+		 *
+		 * Tests count candidates, this, this+step,
+		 * this+2*step and so on, and returns the
+		 * first probable prime.  Several searches
+		 * which start at different offsets with the
+		 * same step cover a range between them.
+		 *
+		 * @param [in] step Distance between candidates
+		 * @param [in] count Number of candidates to test
+		 * @param [in] testVal Number of test cycles, crytpo::algo::primeTestCycle by default
+		 * @param [in] mode Prime test, crypto::algo::primeTestMode by default
+		 * @return Probable prime, 0 if the range holds none
+		 */
+        integer searchPrime(uint32_t step, uint32_t count, uint16_t testVal=algo::primeTestCycle, uint16_t mode=algo::primeTestMode) const;
+    };
+
+    /** @brief Montgomery reduction context
+	 *
+	 * Binds the pre-computed values used for
+	 * Montgomery multiplication against a single
+	 * odd modulus.  Building the context is
+	 * relatively expensive, so it should be
+	 * constructed once and re-used for every
+	 * exponentiation against that modulus.
+	 */
+    class montgomeryReducer
+    {
+		/** @brief Modulus of this reducer
+		 */
+        integer _modulus;
+		/** @brief Pre-computed Montgomery values
+		 */
+        struct montgomeryContext _context;
+		/** @brief Pre-computed 64-bit limb Montgomery values
+		 *
+		 * Used instead of crypto::montgomeryReducer::_context
+		 * when the modulus is bound to buildBaseTen64Type().
+		 */
+        struct montgomeryContext64 _context64;
+		/** @brief Build the context matching the modulus definition
+		 * @return void
+		 */
+        void buildContext();
+		/** @brief Release both contexts
+		 * @return void
+		 */
+        void freeContext();
+    public:
+		/** @brief Construct from a modulus
+		 *
+		 * If the modulus is even or zero, the
+		 * reducer is constructed but is not valid.
+		 * A modulus bound to buildBaseTen64Type()
+		 * builds a 64-bit limb context.
+		 *
+		 * @param [in] mod Modulus to build the context for
+		 */
+        montgomeryReducer(const integer& mod);
+		/** @brief Copy constructor
+		 * @param [in] red Reducer used to construct this
+		 */
+        montgomeryReducer(const montgomeryReducer& red);
+		/** @brief Equality constructor
+		 * @param [in] red Reducer used to re-build this
+		 * @return Reference to this
+		 */
+        montgomeryReducer& operator=(const montgomeryReducer& red);
+		/** @brief Virtual destructor
+		 *
+		 * Releases the Montgomery context.
+		 */
+        virtual ~montgomeryReducer();
+
+		/** @brief Check if the reducer is valid
+		 * @return true if the modulus is odd and non-zero, else, false
+		 */
+        inline bool valid() const {return _context.length>0 || _context64.length>0;}
+		/** @brief Access the modulus
+		 * @return crypto::montgomeryReducer::_modulus
+		 */
+        inline const integer& modulus() const {return _modulus;}
+		/** @brief Access the Montgomery context
+		 * @return crypto::montgomeryReducer::_context
+		 */
+        inline const struct montgomeryContext* context() const {return &_context;}
+		/** @brief Access the 64-bit limb Montgomery context
+		 * @return crypto::montgomeryReducer::_context64
+		 */
+        inline const struct montgomeryContext64* context64() const {return &_context64;}
+
+		/** @brief Modulo-exponentiation
+		 * @param [in] base Integer to be raised
+		 * @param [in] exp Integer to be raised to
+		 * @return base^exp % modulus()
+		 */
+        integer moduloExponentiation(const integer& base, const integer& exp) const;
+    };
+
+    /** @brief Barrett reduction context
+	 *
+	 * Binds the pre-computed values used for
+	 * Barrett reduction against a single
+	 * modulus, which unlike Montgomery may be
+	 * even.  Building the context costs one long
+	 * division, so it should be constructed once
+	 * and re-used for every reduction by that modulus.
+	 */
+    class barrettReducer
+    {
+		/** @brief Modulus of this reducer
+		 */
+        integer _modulus;
+		/** @brief Pre-computed Barrett values
+		 */
+        struct barrettContext _context;
+    public:
+		/** @brief Construct from a modulus
+		 *
+		 * If the modulus is zero, the reducer
+		 * is constructed but is not valid.
+		 *
+		 * @param [in] mod Modulus to build the context for
+		 */
+        barrettReducer(const integer& mod);
+		/** @brief Copy constructor
+		 * @param [in] red Reducer used to construct this
+		 */
+        barrettReducer(const barrettReducer& red);
+		/** @brief Equality constructor
+		 * @param [in] red Reducer used to re-build this
+		 * @return Reference to this
+		 */
+        barrettReducer& operator=(const barrettReducer& red);
+		/** @brief Virtual destructor
+		 *
+		 * Releases the Barrett context.
+		 */
+        virtual ~barrettReducer();
+
+		/** @brief Check if the reducer is valid
+		 * @return true if the modulus is non-zero, else, false
+		 */
+        inline bool valid() const {return _context.length>0;}
+		/** @brief Access the modulus
+		 * @return crypto::barrettReducer::_modulus
+		 */
+        inline const integer& modulus() const {return _modulus;}
+		/** @brief Access the Barrett context
+		 * @return crypto::barrettReducer::_context
+		 */
+        inline const struct barrettContext* context() const {return &_context;}
+
+		/** @brief Reduce by the modulus
+		 * @param [in] src Integer to be reduced
+		 * @return src % modulus()
+		 */
+        integer reduce(const integer& src) const;
+    };
+
+    /** @brief Resumable prime search
+	 *
+	 * Walks start, start+step, start+2*step and
+	 * so on for a probable prime, a chunk at a
+	 * time.  The small-prime sieve is built once,
+	 * when the search is constructed, and its
+	 * residues are carried from chunk to chunk.
+	 */
+    class primeSearcher
+    {
+		/** @brief Next candidate to be tested
+		 */
+        integer _candidate;
+		/** @brief Distance between candidates
+		 */
+        uint32_t _step;
+		/** @brief Residues of the candidate
+		 */
+        struct primeSieve _sieve;
+    public:
+		/** @brief Construct from a starting candidate
+		 *
+		 * @param [in] start First candidate
+		 * @param [in] step Distance between candidates
+		 */
+        primeSearcher(const integer& start, uint32_t step);
+		/** @brief Copy constructor
+		 * @param [in] search Search used to construct this
+		 */
+        primeSearcher(const primeSearcher& search);
+		/** @brief Equality constructor
+		 * @param [in] search Search used to re-build this
+		 * @return Reference to this
+		 */
+        primeSearcher& operator=(const primeSearcher& search);
+		/** @brief Virtual destructor
+		 *
+		 * Releases the sieve.
+		 */
+        virtual ~primeSearcher();
+
+		/** @brief Check if the search can continue
+		 * @return false once the candidates overflow, else, true
+		 */
+        inline bool valid() const {return _sieve.residues!=NULL;}
+		/** @brief Access the current candidate
+		 * @return crypto::primeSearcher::_candidate
+		 */
+        inline const integer& candidate() const {return _candidate;}
+
+		/** @brief Test the next chunk of candidates
+		 *
+		 * Tests up to count candidates from the
+		 * current one.  The search stops on the
+		 * probable prime it returns, so calling
+		 * again returns the same prime.
+		 *
+		 * @param [in] count Number of candidates to test
+		 * @param [in] testVal Number of test cycles, crytpo::algo::primeTestCycle by default
+		 * @param [in] mode Prime test, crypto::algo::primeTestMode by default
+		 * @return Probable prime, 0 if the chunk holds none
+		 */
+        integer search(uint32_t count, uint16_t testVal=algo::primeTestCycle, uint16_t mode=algo::primeTestMode);
     };
 }
 
@@ -12,7 +12,13 @@
 
 #include "cryptoPublicKey.h"
 #include "cryptoError.h"
+#include "cryptoIntegerExpression.h"
 #include "binaryEncryption.h"
+#include <atomic>
+#include <utility>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 using namespace crypto;
 
@@ -238,13 +244,9 @@ using namespace crypto;
     //Static copy/convert
     os::smart_ptr<number> publicKey::copyConvert(const unsigned char* arr,size_t len,uint16_t size)
     {
-        uint32_t* dumpArray=new uint32_t[len/4+1];
-        memset(dumpArray,0,4*(len/4+1));
-        memcpy(dumpArray,arr,len);
-        for(unsigned int i=0;i<len/4+1;++i)
-            dumpArray[i]=os::from_comp_mode(dumpArray[i]);
-        os::smart_ptr<number> ret=publicKey::copyConvert(dumpArray,len/4+1,size);
-        delete [] dumpArray;
+        os::smart_ptr<number> ret(new number(),os::shared_type);
+        if(arr) ret->assignBytes(arr,len);
+        ret->expand(size*2);
         return ret;
     }
 
@@ -657,6 +659,14 @@ using namespace crypto;
 
 //Encoding and decoding---------------------------------------
 
+    //Write a number over the caller's buffer, which must hold all of it
+    static void writeCode(const number& enc, unsigned char* code, size_t codeLength)
+    {
+        memset(code,0,codeLength);
+        if(!enc.writeBytes(code,codeLength))
+            throw errorPointer(new publicKeySizeWrong(), os::shared_type);
+    }
+
     //Static encode (based on number)
     os::smart_ptr<number> publicKey::encode(os::smart_ptr<number> code, os::smart_ptr<number> publicN, uint16_t size)
     {
@@ -668,21 +678,13 @@ using namespace crypto;
 	void publicKey::encode(unsigned char* code, size_t codeLength, os::smart_ptr<number> publicN, uint16_t size)
 	{
 		os::smart_ptr<number> enc=publicKey::encode(publicKey::copyConvert(code,codeLength,size),publicN,size);
-		size_t tLen;
-		auto tdat=enc->getCompCharData(tLen);
-		memset(code,0,codeLength);
-		if(tLen>codeLength) memcpy(code,tdat.get(),codeLength);
-		else memcpy(code,tdat.get(),tLen);
+		writeCode(*enc,code,codeLength);
 	}
 	//Static raw encode
     void publicKey::encode(unsigned char* code, size_t codeLength, unsigned const char* publicN, size_t nLength, uint16_t size)
     {
         os::smart_ptr<number> enc=publicKey::encode(publicKey::copyConvert(code,codeLength,size),publicKey::copyConvert(code,codeLength,size),size);
-        size_t tLen;
-		auto tdat=enc->getCompCharData(tLen);
-		memset(code,0,codeLength);
-		if(tLen>codeLength) memcpy(code,tdat.get(),codeLength);
-		else memcpy(code,tdat.get(),tLen);
+        writeCode(*enc,code,codeLength);
     }
 	//Default encode
 	os::smart_ptr<number> publicKey::encode(os::smart_ptr<number> code, os::smart_ptr<number> publicN) const
@@ -716,21 +718,13 @@ using namespace crypto;
 	void publicKey::decode(unsigned char* code, size_t codeLength) const
 	{
 		os::smart_ptr<number> enc=decode(copyConvert(code,codeLength));
-		size_t tLen;
-		auto tdat=enc->getCompCharData(tLen);
-		memset(code,0,codeLength);
-		if(tLen>codeLength) memcpy(code,tdat.get(),codeLength);
-		else memcpy(code,tdat.get(),tLen);
+		writeCode(*enc,code,codeLength);
 	}
 	//Old decode raw data
 	void publicKey::decode(unsigned char* code, size_t codeLength,size_t hist)
 	{
 		os::smart_ptr<number> enc=decode(copyConvert(code,codeLength),hist);
-		size_t tLen;
-		auto tdat=enc->getCompCharData(tLen);
-		memset(code,0,codeLength);
-		if(tLen>codeLength) memcpy(code,tdat.get(),codeLength);
-		else memcpy(code,tdat.get(),tLen);
+		writeCode(*enc,code,codeLength);
 	}
 
 /*------------------------------------------------------------
@@ -739,14 +733,18 @@ using namespace crypto;
 
     //Default constructor
     publicRSA::publicRSA(uint16_t sz):
-        publicKey(algo::publicRSA,sz)
+        publicKey(algo::publicRSA,sz),
+        _numDef(NULL),
+        _keyGenThreads(0)
     {
         initE();
         generateNewKeys();
     }
     //Copy constructor
     publicRSA::publicRSA(publicRSA& ky):
-        publicKey(ky)
+        publicKey(ky),
+        _numDef(ky._numDef),
+        _keyGenThreads(ky._keyGenThreads.load())
     {
         initE();
         n=copyConvert(ky.n);
@@ -768,7 +766,9 @@ using namespace crypto;
     }
     //N, D constructor
     publicRSA::publicRSA(os::smart_ptr<integer> _n,os::smart_ptr<integer> _d,uint16_t sz,uint64_t tms):
-        publicKey(os::cast<number,integer>(_n),os::cast<number,integer>(_d),algo::publicRSA,sz,tms)
+        publicKey(os::cast<number,integer>(_n),os::cast<number,integer>(_d),algo::publicRSA,sz,tms),
+        _numDef(NULL),
+        _keyGenThreads(0)
     {
         initE();
         n=copyConvert(os::cast<number,integer>(_n));
@@ -777,7 +777,9 @@ using namespace crypto;
     }
 	//N and D from arrays
 	publicRSA::publicRSA(uint32_t* _n,uint32_t* _d,uint16_t sz,uint64_t tms):
-        publicKey(algo::publicRSA,sz)
+        publicKey(algo::publicRSA,sz),
+        _numDef(NULL),
+        _keyGenThreads(0)
 	{
 		initE();
 		n=copyConvert(_n,sz);
@@ -787,14 +789,18 @@ using namespace crypto;
 	}
     //Load a public key from a file
     publicRSA::publicRSA(std::string fileName,std::string password,os::smart_ptr<streamPackageFrame> stream_algo):
-        publicKey(algo::publicRSA,fileName,password,stream_algo)
+        publicKey(algo::publicRSA,fileName,password,stream_algo),
+        _numDef(NULL),
+        _keyGenThreads(0)
     {
         initE();
         loadFile();
     }
     //Load a public key from a file
     publicRSA::publicRSA(std::string fileName,unsigned char* key,size_t keyLen,os::smart_ptr<streamPackageFrame> stream_algo):
-        publicKey(algo::publicRSA,fileName,key,keyLen,stream_algo)
+        publicKey(algo::publicRSA,fileName,key,keyLen,stream_algo),
+        _numDef(NULL),
+        _keyGenThreads(0)
     {
         initE();
         loadFile();
@@ -802,7 +808,67 @@ using namespace crypto;
     //Init the "e" variable
     void publicRSA::initE()
     {
-        e=(integer::one()<<(unsigned)16)+integer::one();
+        e=publicExponent();
+    }
+    //Shared public exponent
+    const integer& publicRSA::publicExponent()
+    {
+        static const integer exponent((lazy(1u)<<16u)+1u);
+        return exponent;
+    }
+    //Select the kernels for this key
+    void publicRSA::setNumberDefinition(struct numberType* numDef)
+    {
+        if(numDef && numDef->typeID!=numberType::Base10)
+        {
+            cryptoerr<<"RSA number definition must be of the Base-10 type!"<<std::endl;
+            return;
+        }
+        reducerLock.acquire();
+        _numDef=numDef;
+        reducerLock.release();
+    }
+    //Kernels for this key
+    struct numberType* publicRSA::numberDefinition() const
+    {
+        reducerLock.acquire();
+        struct numberType* ret=_numDef;
+        reducerLock.release();
+        if(!ret) return integer::defaultDefinition();
+        return ret;
+    }
+    //Set the key generation threads
+    void publicRSA::setKeyGenerationThreads(uint16_t threads)
+    {
+        _keyGenThreads=threads;
+    }
+    //Key generation threads
+    uint16_t publicRSA::keyGenerationThreads() const
+    {
+        uint16_t ret=_keyGenThreads;
+        if(ret) return ret;
+        ret=(uint16_t) std::thread::hardware_concurrency();
+        if(ret<1) ret=1;
+        return ret;
+    }
+    //Reducer for the current key
+    os::smart_ptr<montgomeryReducer> publicRSA::currentReducer() const
+    {
+        struct numberType* numDef=numberDefinition();
+        reducerLock.acquire();
+        os::smart_ptr<montgomeryReducer> ret=_reducer;
+        reducerLock.release();
+        if(ret && ret->modulus()==*n && ret->modulus().numberDefinition()==numDef)
+            return ret;
+
+        //Build outside the lock, other decoders keep the old reducer meanwhile
+        integer mod(*os::cast<integer,number>(n));
+        mod.setDefinition(numDef);
+        ret=os::smart_ptr<montgomeryReducer>(new montgomeryReducer(mod),os::shared_type);
+        reducerLock.acquire();
+        _reducer=ret;
+        reducerLock.release();
+        return ret;
     }
 
     //Static copy/convert
@@ -826,13 +892,9 @@ using namespace crypto;
     //Static copy/convert
     os::smart_ptr<number> publicRSA::copyConvert(const unsigned char* arr,size_t len,uint16_t size)
     {
-        uint32_t* dumpArray=new uint32_t[len/4+1];
-        memset(dumpArray,0,4*(len/4+1));
-        memcpy(dumpArray,arr,len);
-        for(unsigned int i=0;i<len/4+1;++i)
-            dumpArray[i]=os::from_comp_mode(dumpArray[i]);
-        os::smart_ptr<number> ret=publicRSA::copyConvert(dumpArray,len/4+1,size);
-        delete [] dumpArray;
+        os::smart_ptr<number> ret(new integer(),os::shared_type);
+        if(arr) ret->assignBytes(arr,len);
+        ret->expand(size*2);
         return ret;
     }
 
@@ -854,35 +916,33 @@ using namespace crypto;
             throw errorPointer(new publicKeySizeWrong(), os::shared_type);
         if(code->typeID()!=numberType::Base10 || publicN->typeID()!=numberType::Base10)
             throw errorPointer(new illegalAlgorithmBind("Base10"),os::shared_type);
-        integer e((integer::one()<<(unsigned)16)+integer::one());
-        return os::smart_ptr<number> (new integer(os::cast<integer,number>(code)->moduloExponentiation(e, *os::cast<integer,number>(publicN))),os::shared_type);
+        return os::smart_ptr<number> (new integer(os::cast<integer,number>(code)->moduloExponentiation(publicExponent(), *os::cast<integer,number>(publicN))),os::shared_type);
 	}
     //Static hybrid encode
 	void publicRSA::encode(unsigned char* code, size_t codeLength, os::smart_ptr<number> publicN, uint16_t size)
 	{
 		os::smart_ptr<number> enc=publicRSA::encode(publicRSA::copyConvert(code,codeLength,size),publicN,size);
-		size_t tLen;
-		auto tdat=enc->getCompCharData(tLen);
-		memset(code,0,codeLength);
-		if(tLen>codeLength) memcpy(code,tdat.get(),codeLength);
-		else memcpy(code,tdat.get(),tLen);
+		writeCode(*enc,code,codeLength);
 	}
 	//Static raw encode
     void publicRSA::encode(unsigned char* code, size_t codeLength, unsigned const char* publicN, size_t nLength, uint16_t size)
     {
         os::smart_ptr<number> enc=publicRSA::encode(publicRSA::copyConvert(code,codeLength,size),publicRSA::copyConvert(code,codeLength,size),size);
-        size_t tLen;
-		auto tdat=enc->getCompCharData(tLen);
-		memset(code,0,codeLength);
-		if(tLen>codeLength) memcpy(code,tdat.get(),codeLength);
-		else memcpy(code,tdat.get(),tLen);
+        writeCode(*enc,code,codeLength);
     }
 
     //Encode key
     os::smart_ptr<number> publicRSA::encode(os::smart_ptr<number> code, os::smart_ptr<number> publicN) const
     {
-        if(!publicN) publicN=n;
-        return publicRSA::encode(code,publicN,size());
+        if(publicN && publicN.get()!=n.get())
+            return publicRSA::encode(code,publicN,size());
+
+        //Encoding against our own key re-uses the reducer
+        if(*code > *n)
+            throw errorPointer(new publicKeySizeWrong(), os::shared_type);
+        if(code->typeID()!=numberType::Base10 || n->typeID()!=numberType::Base10)
+            throw errorPointer(new illegalAlgorithmBind("Base10"),os::shared_type);
+        return os::smart_ptr<number>(new integer(os::cast<integer,number>(code)->moduloExponentiation(e, *currentReducer())),os::shared_type);
     }
     //Hybrid encode
 	void publicRSA::encode(unsigned char* code, size_t codeLength, os::smart_ptr<number> publicN) const
@@ -894,13 +954,49 @@ using namespace crypto;
     void publicRSA::encode(unsigned char* code, size_t codeLength, unsigned const char* publicN, size_t nLength) const
     {publicRSA::encode(code,codeLength,publicN,nLength,size());}
 
+    //Static batch encode
+    std::vector<os::smart_ptr<number> > publicRSA::batchEncode(const std::vector<os::smart_ptr<number> >& codes, const std::vector<os::smart_ptr<number> >& publicNs, uint16_t size)
+    {
+        if(codes.size()!=publicNs.size())
+            throw errorPointer(new customError("RSA Batch","Expected "+std::to_string((long long unsigned int)codes.size())+" public keys but found "+std::to_string((long long unsigned int)publicNs.size())),os::shared_type);
+
+        std::vector<integer> bases;
+        std::vector<integer> exps(codes.size(),publicExponent());
+        std::vector<integer> mods;
+        bases.reserve(codes.size());
+        mods.reserve(codes.size());
+        for(size_t i=0;i<codes.size();++i)
+        {
+            if(!publicNs[i]) throw errorPointer(new NULLPublicKey(),os::shared_type);
+            if(*codes[i] > *publicNs[i])
+                throw errorPointer(new publicKeySizeWrong(), os::shared_type);
+            if(codes[i]->typeID()!=numberType::Base10 || publicNs[i]->typeID()!=numberType::Base10)
+                throw errorPointer(new illegalAlgorithmBind("Base10"),os::shared_type);
+            bases.push_back(*os::cast<integer,number>(codes[i]));
+            mods.push_back(*os::cast<integer,number>(publicNs[i]));
+        }
+
+        std::vector<integer> enc=integer::batchModuloExponentiation(bases,exps,mods);
+        std::vector<os::smart_ptr<number> > ret;
+        ret.reserve(enc.size());
+        for(size_t i=0;i<enc.size();++i)
+            ret.push_back(os::smart_ptr<number>(new integer(std::move(enc[i])),os::shared_type));
+        return ret;
+    }
+    //Batch encode against this key
+    std::vector<os::smart_ptr<number> > publicRSA::batchEncode(const std::vector<os::smart_ptr<number> >& codes) const
+    {
+        std::vector<os::smart_ptr<number> > keys(codes.size(),n);
+        return publicRSA::batchEncode(codes,keys,size());
+    }
+
     //Decode key
     os::smart_ptr<number> publicRSA::decode(os::smart_ptr<number> code) const
     {
         if(code->typeID()!=numberType::Base10)
             throw errorPointer(new illegalAlgorithmBind("Base10"),os::shared_type);
         publicKey::decode(code);
-        return os::smart_ptr<number>(new integer(os::cast<integer,number>(code)->moduloExponentiation(*os::cast<integer,number>(d), *os::cast<integer,number>(n))),os::shared_type);
+        return os::smart_ptr<number>(new integer(os::cast<integer,number>(code)->moduloExponentiation(*os::cast<integer,number>(d), *currentReducer())),os::shared_type);
     }
 	//Old decode key
     os::smart_ptr<number> publicRSA::decode(os::smart_ptr<number> code, size_t hist)
@@ -914,7 +1010,9 @@ using namespace crypto;
 		if(!histN) throw errorPointer(new NULLPublicKey(),os::shared_type);
 		if(*code > *histN) throw errorPointer(new publicKeySizeWrong(), os::shared_type);
 
-        return os::smart_ptr<number>(new integer(os::cast<integer,number>(code)->moduloExponentiation(*os::cast<integer,number>(histD), *os::cast<integer,number>(histN))),os::shared_type);
+        integer base(*os::cast<integer,number>(code));
+        base.setDefinition(numberDefinition());
+        return os::smart_ptr<number>(new integer(base.moduloExponentiation(*os::cast<integer,number>(histD), *os::cast<integer,number>(histN))),os::shared_type);
     }
 
 /*------------------------------------------------------------
@@ -922,36 +1020,140 @@ using namespace crypto;
  ------------------------------------------------------------*/
 
 
+	//Candidates tested by a search thread between checks for a result
+	static const uint32_t primeSearchChunk=64;
+
 	//Basic constructor
 	RSAKeyGenerator::RSAKeyGenerator(publicRSA& m)
 	{
 		master=&m;
+		threads=m.keyGenerationThreads();
 	}
-	//Generate prime
-	integer RSAKeyGenerator::generatePrime()
+	//Random starting candidate
+	integer RSAKeyGenerator::primeCandidate()
 	{
 		integer ret(2*master->size());
 		for(uint16_t i=0;i<master->size()/2;++i)
 			ret[i]=((uint32_t) rand())^(((uint32_t)rand())<<16);
 		ret[0]=ret[0]|1;
 		ret[master->size()/2-1]^=1<<31;
-		while(!ret.prime())
-			ret+=integer::two();
 		return ret;
 	}
+	//Generate prime
+	integer RSAKeyGenerator::generatePrime()
+	{
+		return primeCandidate().nextPrime();
+	}
+
+	namespace crypto
+	{
+		//Shared state of a parallel prime search
+		struct primeSearchState
+		{
+			std::mutex lock;
+			std::condition_variable done;
+			uint16_t active;
+			std::atomic<bool> found[2];
+			integer result[2];
+		};
+		//One thread of a parallel prime search
+		struct primeSearchWorker
+		{
+			primeSearchState* state;
+			int target;
+			integer start;
+			uint32_t step;
+		};
+		//Walks one offset of a strided range until any thread finds a prime
+		void searchPrimes(void* ptr)
+		{
+			primeSearchWorker* worker=(primeSearchWorker*) ptr;
+			primeSearchState* state=worker->state;
+
+			//The sieve is built once and carried across chunks
+			primeSearcher search(worker->start,worker->step);
+			while(!state->found[worker->target] && search.valid())
+			{
+				integer prime=search.search(primeSearchChunk);
+				if(prime!=integer())
+				{
+					if(!state->found[worker->target].exchange(true))
+					{
+						std::lock_guard<std::mutex> lk(state->lock);
+						state->result[worker->target]=prime;
+					}
+					break;
+				}
+			}
+			delete worker;
+
+			std::lock_guard<std::mutex> lk(state->lock);
+			state->active--;
+			state->done.notify_all();
+		}
+	}
+
+	//Generate p and q
+	void RSAKeyGenerator::generatePrimes()
+	{
+		if(threads<=1)
+		{
+			p=generatePrime();
+			q=generatePrime();
+			return;
+		}
+
+		primeSearchState state;
+		state.active=threads;
+		state.found[0]=false;
+		state.found[1]=false;
+		integer start[2]={primeCandidate(),primeCandidate()};
+
+		//Even threads search for p, odd threads for q
+		for(uint16_t i=0;i<threads;++i)
+		{
+			int target=i%2;
+			uint32_t group=(threads+1-target)/2;
+			primeSearchWorker* worker=new primeSearchWorker();
+			worker->state=&state;
+			worker->target=target;
+			worker->step=2*group;
+			integer offset(start[target].size());
+			offset[0]=2*(i/2);
+			worker->start=start[target]+offset;
+			os::spawnThread(&searchPrimes,worker,"RSA Prime Search");
+		}
+
+		std::unique_lock<std::mutex> lk(state.lock);
+		state.done.wait(lk,[&state]{return state.active==0;});
+		p=state.result[0];
+		q=state.result[1];
+	}
 	//Push calculated values
-	void RSAKeyGenerator::pushValues()
+	bool RSAKeyGenerator::pushValues()
 	{
 		master->writeLock();
-		if(master->n && master->d) master->pushOldKeys(master->n,master->d,master->_timestamp);
-
-		integer tn=p*q;
-		integer phi = (p-integer::one())*(q-integer::one());
+		//Tight primes give exact products, widened to the stored size after
+		integer tp(p);
+		integer tq(q);
+		tp.reduce();
+		tq.reduce();
+		integer tn=tp.multiplyFull(tq);
+		//(p-1)(q-1) is n-p-q+1, evaluated without a second product
+		integer phi=lazy(tn)-tp-tq+1u;
 		phi.expand(2*master->size());
-		integer td = master->e.modInverse(phi);
 
-		master->n=os::smart_ptr<number>(new integer(tn),os::shared_type);
-		master->d=os::smart_ptr<number>(new integer(td),os::shared_type);
+		//e has no inverse when it shares a factor with p-1 or q-1
+		if(phi.gcd(master->e)!=integer::one())
+		{
+			master->writeUnlock();
+			return false;
+		}
+		integer td=master->e.modInverse(phi);
+		if(master->n && master->d) master->pushOldKeys(master->n,master->d,master->_timestamp);
+
+		master->n=os::smart_ptr<number>(new integer(std::move(tn)),os::shared_type);
+		master->d=os::smart_ptr<number>(new integer(std::move(td)),os::shared_type);
 		master->_timestamp=os::getTimestamp();
         master->n->expand(2*master->size());
 		master->d->expand(2*master->size());
@@ -965,6 +1167,7 @@ using namespace crypto;
 		temp->readUnlock();
 
         temp->markChanged();
+		return true;
 	}
 
 	//Key generation function
@@ -974,9 +1177,8 @@ using namespace crypto;
 		void generateKeys(void* ptr)
 		{
 			RSAKeyGenerator* rkg=(RSAKeyGenerator*) ptr;
-			rkg->p=rkg->generatePrime();
-			rkg->q=rkg->generatePrime();
-			rkg->pushValues();
+			do rkg->generatePrimes();
+			while(!rkg->pushValues());
 		}
 	}
 
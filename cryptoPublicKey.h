@@ -13,6 +13,7 @@
 #include "cryptoNumber.h"
 #include "streamPackage.h"
 #include "osMechanics/osMechanics.h"
+#include <atomic>
 
 namespace crypto
 {
@@ -604,9 +605,41 @@ namespace crypto
 		 * key is currently being generated/
 		 */
 		os::smart_ptr<RSAKeyGenerator> keyGen;
+		/** @brief Montgomery reducer for the current public key
+		 *
+		 * Built the first time the current key is
+		 * used and re-built when the key changes.
+		 */
+		mutable os::smart_ptr<montgomeryReducer> _reducer;
+		/** @brief Protects crypto::publicRSA::_reducer
+		 */
+		mutable os::spinLock reducerLock;
+		/** @brief Number definition used by this key
+		 *
+		 * NULL follows crypto::integer::defaultDefinition().
+		 * Protected by crypto::publicRSA::reducerLock.
+		 */
+		struct numberType* _numDef;
+		/** @brief Threads used to generate keys
+		 *
+		 * 0 uses one thread per hardware thread.
+		 */
+		std::atomic<uint16_t> _keyGenThreads;
 		/** @brief Subroutine initializing crypto::publicRSA::e
 		 */
 		void initE();
+		/** @brief Shared RSA public exponent
+		 *
+		 * Built once and shared by every key,
+		 * including the static encode functions.
+		 *
+		 * @return Reference to 65537
+		 */
+		static const integer& publicExponent();
+		/** @brief Reducer bound to the current public key
+		 * @return Montgomery reducer for crypto::publicKey::n
+		 */
+		os::smart_ptr<montgomeryReducer> currentReducer() const;
 	public:
 		/** @brief Default RSA constructor
 		 *
@@ -703,6 +736,42 @@ namespace crypto
 		 */
 		static os::smart_ptr<number> copyConvert(const unsigned char* arr,size_t len,uint16_t size);
 
+		/** @brief Select the kernels used by this key
+		 *
+		 * Decoding, and encoding against this key,
+		 * run on integers bound to this definition,
+		 * for example buildBaseTen64Type().  The key
+		 * data and file format are unchanged.  NULL
+		 * follows crypto::integer::defaultDefinition().
+		 * Definitions which do not have the base-10
+		 * type ID are rejected.
+		 *
+		 * @param [in] numDef Base-10 number definition, or NULL
+		 * @return void
+		 */
+		void setNumberDefinition(struct numberType* numDef);
+		/** @brief Kernels used by this key
+		 * @return Number definition used to encode and decode
+		 */
+		struct numberType* numberDefinition() const;
+		/** @brief Set the key generation thread count
+		 *
+		 * Key generation searches for p and q at
+		 * the same time, splitting the threads
+		 * between the two searches.  One thread
+		 * finds p and then q.  0 uses one thread
+		 * per hardware thread.  Takes effect the
+		 * next time keys are generated.
+		 *
+		 * @param [in] threads Number of search threads, or 0
+		 * @return void
+		 */
+		void setKeyGenerationThreads(uint16_t threads);
+		/** @brief Key generation thread count
+		 * @return Number of threads searching for primes
+		 */
+		uint16_t keyGenerationThreads() const;
+
 		/** @brief Access algorithm ID
 		 * @return crypto::algo::publicRSA
 		 */
@@ -793,6 +862,26 @@ namespace crypto
 		 */
 		void encode(unsigned char* code, size_t codeLength, unsigned const char* publicN, size_t nLength) const;
 
+		/** @brief Static batch encode
+		 *
+		 * Encodes many independent numbers, each
+		 * against its own public key, with
+		 * crypto::integer::batchModuloExponentiation.
+		 * Hosts with AVX-512 IFMA encode eight at
+		 * a time, others fall back to one at a time.
+		 *
+		 * @param [in] codes Data to be encoded
+		 * @param [in] publicNs Public keys to be encoded against, one per code
+		 * @param [in] size Size of key used
+		 * @return Encoded numbers, in the order of codes
+		 */
+		static std::vector<os::smart_ptr<number> > batchEncode(const std::vector<os::smart_ptr<number> >& codes, const std::vector<os::smart_ptr<number> >& publicNs, uint16_t size);
+		/** @brief Batch encode against this key
+		 * @param [in] codes Data to be encoded
+		 * @return Encoded numbers, in the order of codes
+		 */
+		std::vector<os::smart_ptr<number> > batchEncode(const std::vector<os::smart_ptr<number> >& codes) const;
+
 		/** @brief Number decode
 		 *
 		 * Uses the private key to decode a
@@ -830,7 +919,14 @@ namespace crypto
 		 * its generated keys into.
 		 */
 		publicRSA* master;
+		/** @brief Number of prime search threads
+		 */
+		uint16_t threads;
 
+		/** @brief Random starting candidate
+		 * @return Odd integer with the top bit of a prime set
+		 */
+		integer primeCandidate();
 	public:
 		/** @brief Intermediate prime
 		 */
@@ -859,10 +955,26 @@ namespace crypto
 		 * @return Prime integer
 		 */
 		integer generatePrime();
+		/** @brief Generates crypto::RSAKeyGenerator::p and crypto::RSAKeyGenerator::q
+		 *
+		 * p and q are searched for concurrently,
+		 * each on half of the search threads.
+		 * Every thread of a search walks its own
+		 * offset of a shared strided range, and
+		 * the search stops when any of them finds
+		 * a prime.
+		 *
+		 * @return void
+		 */
+		void generatePrimes();
 		/** @brief Bind generated keys to master
-         * @return void
+         *
+         * Checks that e is coprime to phi, so d
+         * exists, before replacing the keys of master.
+         *
+         * @return true if bound, false if the primes must be re-generated
          */
-		void pushValues();
+		bool pushValues();
 	};
 
 };
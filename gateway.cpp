@@ -505,8 +505,14 @@ namespace crypto {
 					ret=currentError();
 					break;
 				}
-				os::smart_ptr<unsigned char> tdat=num->getCompCharData(hist);
-				memcpy(ret->data()+2+16,tdat.get(),selfPKFrame->keySize()*4);
+				memset(ret->data()+2+16,0,selfPKFrame->keySize()*4);
+				if(!num->writeBytes(ret->data()+2+16,selfPKFrame->keySize()*4))
+				{
+					lock.release();
+					logError(errorPointer(new customError("Could not Sign, Primary","Signature is wider than the key"),os::shared_type),TIMEOUT_ERROR_STATE);
+					ret=currentError();
+					break;
+				}
 			}
 
 			//Secondary hash
@@ -543,8 +549,14 @@ namespace crypto {
 				}
 
 				memcpy(ret->data()+2+16+selfPKFrame->keySize()*4+2,cpub.data(),cpub.size());
-				os::smart_ptr<unsigned char> tdat=num->getCompCharData(chrData);
-				memcpy(ret->data()+2+16+selfPKFrame->keySize()*4+2+brotherStream->hashSize(),tdat.get(),secondaryKeySize*4);
+				memset(ret->data()+2+16+selfPKFrame->keySize()*4+2+brotherStream->hashSize(),0,secondaryKeySize*4);
+				if(!num->writeBytes(ret->data()+2+16+selfPKFrame->keySize()*4+2+brotherStream->hashSize(),secondaryKeySize*4))
+				{
+					lock.release();
+					logError(errorPointer(new customError("Could not Sign, Secondary","Signature is wider than the key"),os::shared_type),TIMEOUT_ERROR_STATE);
+					ret=currentError();
+					break;
+				}
 			}
 
 			//Valid hash list